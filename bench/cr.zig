@@ -0,0 +1,100 @@
+//! Timing of the correctly rounded math.cr functions against the default
+//! kernels, along with the fraction of f64 calls that fell back to the slow
+//! path.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(comptime T: type, comptime func: fn (T) T, inputs: []const T) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(x: T) T {
+            return math.exp(x);
+        }
+        fn crExp(x: T) T {
+            return math.cr.exp(x);
+        }
+        fn exp2(x: T) T {
+            return math.exp2(x);
+        }
+        fn crExp2(x: T) T {
+            return math.cr.exp2(x);
+        }
+        fn log2(x: T) T {
+            return math.log2(x);
+        }
+        fn crLog2(x: T) T {
+            return math.cr.log2(x);
+        }
+    };
+}
+
+fn compare(
+    comptime T: type,
+    name: []const u8,
+    comptime default: fn (T) T,
+    comptime cr: fn (T) T,
+    inputs: []const T,
+) !void {
+    const t_default = try timeFunc(T, default, inputs);
+    math.cr.resetFallbackCount();
+    const t_cr = try timeFunc(T, cr, inputs);
+    const fallbacks = @intToFloat(f64, math.cr.fallbackCount()) / (n_rounds * n_inputs);
+    std.debug.print(
+        "{s: <6} {s: <18} default {d: >7.2} ns  cr {d: >7.2} ns  fallbacks {d: >5.2}%\n",
+        .{ @typeName(T), name, t_default, t_cr, fallbacks * 100 },
+    );
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    const F32 = Funcs(f32);
+    var exp_inputs: [n_inputs]f32 = undefined;
+    var log_inputs: [n_inputs]f32 = undefined;
+    for (exp_inputs) |*x| {
+        x.* = @floatCast(f32, random.float(f64) * 160 - 80);
+    }
+    for (log_inputs) |*x| {
+        const e = random.intRangeAtMost(i32, -100, 100);
+        x.* = @floatCast(f32, math.scalbn(random.float(f64) + 0.5, e));
+    }
+    try compare(f32, "exp", F32.exp, F32.crExp, &exp_inputs);
+    try compare(f32, "exp2", F32.exp2, F32.crExp2, &exp_inputs);
+    try compare(f32, "log2", F32.log2, F32.crLog2, &log_inputs);
+
+    const F64 = Funcs(f64);
+    var small: [n_inputs]f64 = undefined;
+    var wide: [n_inputs]f64 = undefined;
+    for (small) |*x| {
+        x.* = random.float(f64) * 2 - 1;
+    }
+    for (wide) |*x| {
+        x.* = random.float(f64) * 2000 - 1000;
+    }
+    try compare(f64, "exp2 [-1, 1]", F64.exp2, F64.crExp2, &small);
+    try compare(f64, "exp2 [-1e3, 1e3]", F64.exp2, F64.crExp2, &wide);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
@@ -0,0 +1,93 @@
+//! Timing of the directed rounding intervals against a single nearest-rounded
+//! call of the same function.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(comptime T: type, comptime func: fn (T) T, inputs: []const T) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(x: T) T {
+            return math.exp(x);
+        }
+        fn expInterval(x: T) T {
+            const b = math.expInterval(x, x);
+            return b.hi - b.lo;
+        }
+        fn exp2(x: T) T {
+            return math.exp2(x);
+        }
+        fn exp2Interval(x: T) T {
+            const b = math.exp2Interval(x, x);
+            return b.hi - b.lo;
+        }
+        fn log2(x: T) T {
+            return math.log2(x);
+        }
+        fn log2Interval(x: T) T {
+            const b = math.log2Interval(x, x);
+            return b.hi - b.lo;
+        }
+    };
+}
+
+fn compare(
+    comptime T: type,
+    name: []const u8,
+    comptime nearest: fn (T) T,
+    comptime interval: fn (T) T,
+    inputs: []const T,
+) !void {
+    const t_nearest = try timeFunc(T, nearest, inputs);
+    const t_interval = try timeFunc(T, interval, inputs);
+    std.debug.print(
+        "{s: <6} {s: <6} nearest {d: >7.2} ns  interval {d: >7.2} ns\n",
+        .{ @typeName(T), name, t_nearest, t_interval },
+    );
+}
+
+fn benchWidth(comptime T: type, random: std.rand.Random) !void {
+    const F = Funcs(T);
+    var exp_inputs: [n_inputs]T = undefined;
+    var log_inputs: [n_inputs]T = undefined;
+    for (exp_inputs) |*x| {
+        x.* = @floatCast(T, random.float(f64) * 160 - 80);
+    }
+    for (log_inputs) |*x| {
+        const e = random.intRangeAtMost(i32, -100, 100);
+        x.* = @floatCast(T, math.scalbn(random.float(f64) + 0.5, e));
+    }
+    try compare(T, "exp", F.exp, F.expInterval, &exp_inputs);
+    try compare(T, "exp2", F.exp2, F.exp2Interval, &exp_inputs);
+    try compare(T, "log2", F.log2, F.log2Interval, &log_inputs);
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    try benchWidth(f32, random);
+    try benchWidth(f64, random);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
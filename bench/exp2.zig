@@ -0,0 +1,87 @@
+//! Timing of exp2() on integer and non-integer inputs for each float width.
+//!
+//! The integer inputs take the fast path that builds the result from the
+//! exponent bits, the non-integer inputs show the cost that the integer check
+//! adds to the general path. std.math.exp2() is the same musl algorithm without
+//! the integer check, so serves as a baseline for f32 and f64. For f128, the
+//! soft float kernel is compared with the fixed point one.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(
+    comptime T: type,
+    comptime func: fn (T) T,
+    name: []const u8,
+    inputs: []const T,
+) !void {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    const ns = @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+    std.debug.print("{s: <6} {s: <28} {d: >8.2} ns\n", .{ @typeName(T), name, ns });
+}
+
+fn exp2Of(comptime T: type) fn (T) T {
+    return struct {
+        fn f(x: T) T {
+            return math.exp2(x);
+        }
+    }.f;
+}
+
+fn stdExp2Of(comptime T: type) fn (T) T {
+    return struct {
+        fn f(x: T) T {
+            return std.math.exp2(x);
+        }
+    }.f;
+}
+
+fn benchWidth(comptime T: type, random: std.rand.Random) !void {
+    var ints: [n_inputs]T = undefined;
+    var fracs: [n_inputs]T = undefined;
+    for (ints) |*x| {
+        x.* = @intToFloat(T, random.intRangeAtMost(i32, -1000, 1000));
+    }
+    for (fracs) |*x| {
+        // Non-integer with probability ~1.
+        x.* = @floatCast(T, random.float(f64) * 2000 - 1000);
+    }
+
+    try timeFunc(T, exp2Of(T), "exp2 integer", &ints);
+    try timeFunc(T, exp2Of(T), "exp2 non-integer", &fracs);
+    if (T == f32 or T == f64) {
+        try timeFunc(T, stdExp2Of(T), "std.math.exp2 integer", &ints);
+        try timeFunc(T, stdExp2Of(T), "std.math.exp2 non-integer", &fracs);
+    }
+    if (T == f128) {
+        try timeFunc(T, math.exp2_128Fixed, "exp2_128Fixed non-integer", &fracs);
+    }
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    try benchWidth(f32, random);
+    try benchWidth(f64, random);
+    try benchWidth(f80, random);
+    try benchWidth(f128, random);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
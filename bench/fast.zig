@@ -0,0 +1,82 @@
+//! Timing of the relaxed-accuracy math.fast functions against the default
+//! kernels, for the ones that differ from the defaults.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(comptime T: type, comptime func: fn (T) T, inputs: []const T) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn compare(
+    comptime T: type,
+    name: []const u8,
+    comptime default: fn (T) T,
+    comptime fast: fn (T) T,
+    inputs: []const T,
+) !void {
+    const t_default = try timeFunc(T, default, inputs);
+    const t_fast = try timeFunc(T, fast, inputs);
+    std.debug.print(
+        "{s: <6} {s: <6} default {d: >7.2} ns  fast {d: >7.2} ns  speedup {d: >5.2}x\n",
+        .{ @typeName(T), name, t_default, t_fast, t_default / t_fast },
+    );
+}
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(x: T) T {
+            return math.exp(x);
+        }
+        fn fastExp(x: T) T {
+            return math.fast.exp(x);
+        }
+        fn exp2(x: T) T {
+            return math.exp2(x);
+        }
+        fn fastExp2(x: T) T {
+            return math.fast.exp2(x);
+        }
+    };
+}
+
+fn benchWidth(comptime T: type, random: std.rand.Random) !void {
+    const F = Funcs(T);
+    var exp_inputs: [n_inputs]T = undefined;
+    for (exp_inputs) |*x| {
+        x.* = @floatCast(T, random.float(f64) * 160 - 80);
+    }
+
+    try compare(T, "exp", F.exp, F.fastExp, &exp_inputs);
+    // fast.exp2() is math.exp2() for f32
+    if (T == f64) {
+        try compare(T, "exp2", F.exp2, F.fastExp2, &exp_inputs);
+    }
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    try benchWidth(f32, random);
+    try benchWidth(f64, random);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
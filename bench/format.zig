@@ -0,0 +1,89 @@
+//! Throughput of math.formatFloatSlice() against std.fmt's {e}, for f32,
+//! f64 and f128. For f128, {e} only gives f64 precision, so it's doing less
+//! work and its output doesn't round-trip.
+//!
+//! This only times formatting into memory. Whether writing many values to a
+//! file is then limited by the I/O rather than the formatting isn't
+//! measured.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 6;
+
+var buf: [1 << 16]u8 = undefined;
+
+fn timeFormat(comptime T: type, inputs: []const T) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        var xs = inputs;
+        while (xs.len > 0) {
+            const r = math.formatFloatSlice(T, xs, &buf, '\n');
+            math.doNotOptimizeAway(buf[r.bytes - 1]);
+            xs = xs[r.values..];
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn timeStd(comptime T: type, inputs: []const T) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        var stream = std.io.fixedBufferStream(&buf);
+        for (inputs) |x| {
+            if (stream.pos > buf.len - 64) {
+                math.doNotOptimizeAway(buf[stream.pos - 1]);
+                stream.reset();
+            }
+            try stream.writer().print("{e}\n", .{x});
+        }
+        math.doNotOptimizeAway(buf[stream.pos - 1]);
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn compare(comptime T: type, name: []const u8, inputs: []const T) !void {
+    const t_ours = try timeFormat(T, inputs);
+    const t_std = try timeStd(T, inputs);
+    std.debug.print(
+        "{s: <6} {s: <12} formatFloat {d: >7.2} ns  std.fmt {d: >7.2} ns  speedup {d: >5.2}x\n",
+        .{ @typeName(T), name, t_ours, t_std, t_std / t_ours },
+    );
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    inline for (.{ f32, f64, f128 }) |T| {
+        const Bits = std.meta.Int(.unsigned, @bitSizeOf(T));
+        var short: [n_inputs]T = undefined;
+        var full: [n_inputs]T = undefined;
+        for (short) |*x| {
+            // Few significant digits, as for rounded data.
+            x.* = @intToFloat(T, random.intRangeAtMost(i32, -99999, 99999)) / 1000;
+        }
+        for (full) |*x| {
+            // Random bits, which need (nearly) all the digits. Skip inf and
+            // nan.
+            while (true) {
+                x.* = @bitCast(T, random.int(Bits));
+                if (math.isFinite(x.*)) break;
+            }
+        }
+        try compare(T, "short", &short);
+        try compare(T, "random bits", &full);
+    }
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
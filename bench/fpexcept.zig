@@ -0,0 +1,90 @@
+//! Timing of the paths that raise floating point exceptions: overflow,
+//! underflow and tiny inputs.
+//!
+//! Run with 'zig build bench' and again with 'zig build bench
+//! -Dfp-exceptions=false' to see the cost of raising the exceptions.
+//!
+//! Each raise costs one f64 operation (see src/fpexcept.zig), next to an f128
+//! soft-float kernel, so the difference is expected to be small. It hasn't
+//! been measured.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(
+    comptime T: type,
+    comptime func: fn (T) T,
+    name: []const u8,
+    inputs: []const T,
+) !void {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    const ns = @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+    std.debug.print("{s: <6} {s: <20} {d: >8.2} ns\n", .{ @typeName(T), name, ns });
+}
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(x: T) T {
+            return math.exp(x);
+        }
+        fn exp2(x: T) T {
+            return math.exp2(x);
+        }
+        fn exp10(x: T) T {
+            return math.exp10(x);
+        }
+    };
+}
+
+/// Fills inputs with uniform random values in [lo, hi].
+fn fill(comptime T: type, random: std.rand.Random, inputs: []T, lo: f64, hi: f64) []const T {
+    for (inputs) |*x| {
+        x.* = @floatCast(T, lo + random.float(f64) * (hi - lo));
+    }
+    return inputs;
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    std.debug.print("fp exceptions {s}\n", .{if (math.fp_exceptions) "on" else "off"});
+
+    const F32 = Funcs(f32);
+    var in32: [n_inputs]f32 = undefined;
+    try timeFunc(f32, F32.exp, "exp underflow", fill(f32, random, &in32, -103, -88));
+    try timeFunc(f32, F32.exp, "exp tiny", fill(f32, random, &in32, -0x1p-15, 0x1p-15));
+    try timeFunc(f32, F32.exp2, "exp2 underflow", fill(f32, random, &in32, -149, -127));
+    try timeFunc(f32, F32.exp10, "exp10 underflow", fill(f32, random, &in32, -50, -47));
+
+    const F64 = Funcs(f64);
+    var in64: [n_inputs]f64 = undefined;
+    try timeFunc(f64, F64.exp, "exp overflow", fill(f64, random, &in64, 710, 800));
+    try timeFunc(f64, F64.exp2, "exp2 underflow", fill(f64, random, &in64, -1074, -1023));
+    try timeFunc(f64, F64.exp2, "exp2 overflow", fill(f64, random, &in64, 1025, 2000));
+    try timeFunc(f64, F64.exp10, "exp10 underflow", fill(f64, random, &in64, -320, -308));
+    try timeFunc(f64, F64.exp10, "exp10 overflow", fill(f64, random, &in64, 309, 400));
+
+    const F128 = Funcs(f128);
+    var in128: [n_inputs]f128 = undefined;
+    try timeFunc(f128, F128.exp, "exp underflow", fill(f128, random, &in128, -11400, -11360));
+    try timeFunc(f128, F128.exp, "exp overflow", fill(f128, random, &in128, 11400, 12000));
+    try timeFunc(f128, F128.exp2, "exp2 underflow", fill(f128, random, &in128, -16494, -16383));
+    try timeFunc(f128, F128.exp2, "exp2 overflow", fill(f128, random, &in128, 16385, 17000));
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
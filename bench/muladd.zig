@@ -0,0 +1,62 @@
+//! Timing of the f64 exp, exp2 and log2 kernels with the polynomials
+//! evaluated with fused multiply-adds against separate multiplies and adds.
+//! Without a hardware FMA the fused variants call the software fma(), so the
+//! comparison only means something on an FMA host.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(comptime func: anytype, comptime fused: bool, inputs: []const f64) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(fused, x));
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn compare(name: []const u8, comptime func: anytype, inputs: []const f64) !void {
+    const t_separate = try timeFunc(func, false, inputs);
+    const t_fused = try timeFunc(func, true, inputs);
+    std.debug.print(
+        "f64    {s: <6} separate {d: >7.2} ns  fused {d: >7.2} ns  speedup {d: >5.2}x\n",
+        .{ name, t_separate, t_fused, t_separate / t_fused },
+    );
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    var exp_inputs: [n_inputs]f64 = undefined;
+    var log_inputs: [n_inputs]f64 = undefined;
+    for (exp_inputs) |*x| {
+        x.* = random.float(f64) * 160 - 80;
+    }
+    for (log_inputs) |*x| {
+        const e = random.intRangeAtMost(i32, -100, 100);
+        x.* = math.scalbn(random.float(f64) + 0.5, e);
+    }
+
+    std.debug.print("target has FMA: {}, default: {s}\n", .{
+        math.muladd.target_has_fma,
+        if (math.muladd.enabled) "fused" else "separate",
+    });
+    try compare("exp", math.muladd.exp, &exp_inputs);
+    try compare("exp2", math.muladd.exp2, &exp_inputs);
+    try compare("log2", math.muladd.log2, &log_inputs);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
@@ -0,0 +1,105 @@
+//! Scaling of math.expParallel() and math.exp2Parallel() from one thread up
+//! to one per CPU, for f64 and f128. Each line gives the speedup over one
+//! thread. No results have been recorded yet, so how far it scales, and where
+//! f64 becomes memory bound, is still unmeasured.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_rounds = 4;
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(pool: *math.ThreadPool, xs: []const T, out: []T) void {
+            math.expParallel(T, pool, xs, out);
+        }
+        fn exp2(pool: *math.ThreadPool, xs: []const T, out: []T) void {
+            math.exp2Parallel(T, pool, xs, out);
+        }
+    };
+}
+
+fn timeCall(
+    comptime T: type,
+    comptime func: fn (*math.ThreadPool, []const T, []T) void,
+    pool: *math.ThreadPool,
+    inputs: []const T,
+    out: []T,
+) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        func(pool, inputs, out);
+        math.doNotOptimizeAway(out[out.len - 1]);
+    }
+    return @intToFloat(f64, timer.read()) / n_rounds;
+}
+
+fn scaling(
+    comptime T: type,
+    name: []const u8,
+    comptime func: fn (*math.ThreadPool, []const T, []T) void,
+    inputs: []const T,
+    out: []T,
+    max_threads: usize,
+) !void {
+    var t_one: f64 = 0;
+    // 1, 2, 4, ... threads, and then max_threads.
+    var n: usize = 1;
+    while (true) : (n = math.min(n * 2, max_threads)) {
+        var pool: math.ThreadPool = undefined;
+        try pool.init(n);
+        defer pool.deinit();
+
+        // Warm up the workers and the output pages.
+        func(&pool, inputs, out);
+        const t = try timeCall(T, func, &pool, inputs, out);
+        if (n == 1) {
+            t_one = t;
+        }
+        std.debug.print(
+            "{s: <6} {s: <6} threads {d: >3}  {d: >8.2} ms  {d: >7.1} M/s  speedup {d: >5.2}x\n",
+            .{
+                @typeName(T),
+                name,
+                pool.threadCount(),
+                t / 1e6,
+                @intToFloat(f64, inputs.len) * 1e3 / t,
+                t_one / t,
+            },
+        );
+        if (n == max_threads) break;
+    }
+}
+
+fn run(comptime T: type, len: usize, max_threads: usize, random: std.rand.Random) !void {
+    const allocator = std.heap.page_allocator;
+    const inputs = try allocator.alloc(T, len);
+    defer allocator.free(inputs);
+    const out = try allocator.alloc(T, len);
+    defer allocator.free(out);
+
+    for (inputs) |*x| {
+        x.* = @floatCast(T, random.float(f64) * 200 - 100);
+    }
+    try scaling(T, "exp", Funcs(T).exp, inputs, out, max_threads);
+    try scaling(T, "exp2", Funcs(T).exp2, inputs, out, max_threads);
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    const max_threads = try std.Thread.getCpuCount();
+    try run(f64, 1 << 24, max_threads, random);
+    try run(f128, 1 << 20, max_threads, random);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
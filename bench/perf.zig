@@ -0,0 +1,108 @@
+//! Timing of the kernels together with hardware performance counters per
+//! call: cycles, instructions, branch misses and L1D read misses. This shows
+//! whether the table lookups (e.g. the 4 KiB exp2_64 and exp128 tables) miss
+//! cache, and whether the f128 soft-float paths mispredict branches.
+//!
+//! Counters that aren't available (see perf_counters.zig) are shown as '-'.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+const perf = @import("perf_counters.zig");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeFunc(
+    comptime T: type,
+    comptime func: fn (T) T,
+    name: []const u8,
+    inputs: []const T,
+    counters: perf.Counters,
+) !void {
+    var timer = try std.time.Timer.start();
+    counters.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    const counts = counters.stop();
+    const calls = @intToFloat(f64, n_rounds * n_inputs);
+    const ns = @intToFloat(f64, timer.read()) / calls;
+
+    std.debug.print("{s: <6} {s: <18} {d: >8.2} ns", .{ @typeName(T), name, ns });
+    for (counts) |count| {
+        if (count) |c| {
+            std.debug.print(" {d: >9.3}", .{@intToFloat(f64, c) / calls});
+        } else {
+            std.debug.print(" {s: >9}", .{"-"});
+        }
+    }
+    std.debug.print("\n", .{});
+}
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(x: T) T {
+            return math.exp(x);
+        }
+        fn exp2(x: T) T {
+            return math.exp2(x);
+        }
+        fn log2(x: T) T {
+            return math.log2(x);
+        }
+    };
+}
+
+fn benchWidth(comptime T: type, random: std.rand.Random, counters: perf.Counters) !void {
+    const F = Funcs(T);
+    var small: [n_inputs]T = undefined;
+    var wide: [n_inputs]T = undefined;
+    var logs: [n_inputs]T = undefined;
+    for (small) |*x| {
+        x.* = @floatCast(T, random.float(f64) * 2 - 1);
+    }
+    for (wide) |*x| {
+        x.* = @floatCast(T, random.float(f64) * 1400 - 700);
+    }
+    for (logs) |*x| {
+        const e = random.intRangeAtMost(i32, -100, 100);
+        x.* = @floatCast(T, math.scalbn(random.float(f64) + 0.5, e));
+    }
+
+    try timeFunc(T, F.exp, "exp [-1, 1]", &small, counters);
+    try timeFunc(T, F.exp, "exp [-700, 700]", &wide, counters);
+    try timeFunc(T, F.exp2, "exp2 [-1, 1]", &small, counters);
+    try timeFunc(T, F.exp2, "exp2 [-700, 700]", &wide, counters);
+    try timeFunc(T, F.log2, "log2", &logs, counters);
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    var counters = perf.Counters.open();
+    defer counters.close();
+    if (!counters.available()) {
+        std.debug.print("hardware counters unavailable, showing timing only\n", .{});
+    }
+    std.debug.print(
+        "{s: <6} {s: <18} {s: >11} {s: >9} {s: >9} {s: >9} {s: >9}\n",
+        .{ "type", "function", "time", "cycles", "instrs", "br-miss", "l1d-miss" },
+    );
+
+    try benchWidth(f64, random, counters);
+    try benchWidth(f80, random, counters);
+    try benchWidth(f128, random, counters);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
@@ -0,0 +1,197 @@
+//! Hardware performance counters around a benchmark run, read with Linux
+//! perf_event_open(2).
+//!
+//! Only user-space events of the calling thread are counted, which is
+//! allowed at the default perf_event_paranoid level. Counters that can't be
+//! opened (not Linux, no PMU in a VM or container, or a stricter paranoid
+//! level) are reported as unavailable, and the timing still works.
+//!
+//! The counters are opened as one event group, whose first event is the
+//! leader, so the kernel only ever schedules them together and ratios such
+//! as instructions per cycle are over the same interval. If the PMU is
+//! shared and the group is multiplexed, the counts are scaled by the time
+//! enabled over the time running, as perf does.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const linux = std.os.linux;
+
+/// The counted events.
+pub const Event = enum {
+    cycles,
+    instructions,
+    branch_misses,
+    l1d_misses,
+};
+
+const n_events = @typeInfo(Event).Enum.fields.len;
+
+// struct perf_event_attr, as of PERF_ATTR_SIZE_VER5.
+const PerfEventAttr = extern struct {
+    type: u32,
+    size: u32 = @sizeOf(PerfEventAttr),
+    config: u64,
+    sample_period: u64 = 0,
+    sample_type: u64 = 0,
+    read_format: u64 = 0,
+    flags: u64 = 0,
+    wakeup_events: u32 = 0,
+    bp_type: u32 = 0,
+    config1: u64 = 0,
+    config2: u64 = 0,
+    branch_sample_type: u64 = 0,
+    sample_regs_user: u64 = 0,
+    sample_stack_user: u32 = 0,
+    clockid: i32 = 0,
+    sample_regs_intr: u64 = 0,
+    aux_watermark: u32 = 0,
+    sample_max_stack: u16 = 0,
+    reserved_2: u16 = 0,
+};
+
+comptime {
+    std.debug.assert(@sizeOf(PerfEventAttr) == 112);
+}
+
+const PERF_TYPE_HARDWARE = 0;
+const PERF_TYPE_HW_CACHE = 3;
+const PERF_COUNT_HW_CPU_CYCLES = 0;
+const PERF_COUNT_HW_INSTRUCTIONS = 1;
+const PERF_COUNT_HW_BRANCH_MISSES = 5;
+// L1D, read, miss
+const PERF_COUNT_HW_CACHE_L1D_READ_MISS = 0 | (0 << 8) | (1 << 16);
+
+// attr.flags bits
+const flag_disabled = 1 << 0;
+const flag_exclude_kernel = 1 << 5;
+const flag_exclude_hv = 1 << 6;
+
+// attr.read_format bits
+const PERF_FORMAT_TOTAL_TIME_ENABLED = 1 << 0;
+const PERF_FORMAT_TOTAL_TIME_RUNNING = 1 << 1;
+const PERF_FORMAT_GROUP = 1 << 3;
+
+const PERF_EVENT_IOC_ENABLE = 0x2400;
+const PERF_EVENT_IOC_DISABLE = 0x2401;
+const PERF_EVENT_IOC_RESET = 0x2403;
+// ioctl argument to apply to the whole group of the leader
+const PERF_IOC_FLAG_GROUP = 1;
+
+fn eventAttr(event: Event) PerfEventAttr {
+    const flags = flag_disabled | flag_exclude_kernel | flag_exclude_hv;
+    return switch (event) {
+        .cycles => .{ .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CPU_CYCLES, .flags = flags },
+        .instructions => .{ .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_INSTRUCTIONS, .flags = flags },
+        .branch_misses => .{ .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_MISSES, .flags = flags },
+        .l1d_misses => .{ .type = PERF_TYPE_HW_CACHE, .config = PERF_COUNT_HW_CACHE_L1D_READ_MISS, .flags = flags },
+    };
+}
+
+/// Event counts from one run, null for events that aren't available.
+pub const Counts = [n_events]?u64;
+
+/// A group of counters for the calling thread.
+pub const Counters = struct {
+    /// The group leader, null if no counter is available.
+    leader: ?i32,
+    fds: [n_events]?i32,
+    /// The events in the order they joined the group, which is the order of
+    /// their counts in a read of the leader.
+    order: [n_events]Event,
+    n_open: usize,
+
+    /// Opens the counters that are available, which may be none of them.
+    pub fn open() Counters {
+        var self = Counters{
+            .leader = null,
+            .fds = [_]?i32{null} ** n_events,
+            .order = undefined,
+            .n_open = 0,
+        };
+        if (builtin.os.tag != .linux) {
+            return self;
+        }
+        for (self.fds) |*fd, i| {
+            const event = @intToEnum(Event, @intCast(u2, i));
+            var attr = eventAttr(event);
+            if (self.leader == null) {
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                    PERF_FORMAT_TOTAL_TIME_RUNNING;
+            } else {
+                // members count whenever the leader does
+                attr.flags &= ~@as(u64, flag_disabled);
+            }
+            const group_fd: i32 = self.leader orelse -1;
+            // this thread, any cpu
+            const rc = linux.syscall5(
+                .perf_event_open,
+                @ptrToInt(&attr),
+                0,
+                @bitCast(usize, @as(isize, -1)),
+                @bitCast(usize, @as(isize, group_fd)),
+                0,
+            );
+            if (linux.getErrno(rc) == .SUCCESS) {
+                fd.* = @intCast(i32, rc);
+                if (self.leader == null) {
+                    self.leader = fd.*;
+                }
+                self.order[self.n_open] = event;
+                self.n_open += 1;
+            }
+        }
+        return self;
+    }
+
+    pub fn close(self: *Counters) void {
+        for (self.fds) |*fd| {
+            if (fd.*) |f| {
+                std.os.close(f);
+                fd.* = null;
+            }
+        }
+        self.leader = null;
+        self.n_open = 0;
+    }
+
+    /// Returns whether any counter is available.
+    pub fn available(self: Counters) bool {
+        return self.leader != null;
+    }
+
+    /// Resets and starts the counters.
+    pub fn start(self: Counters) void {
+        if (self.leader) |f| {
+            _ = linux.ioctl(f, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            _ = linux.ioctl(f, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    /// Stops the counters and returns their counts since start().
+    pub fn stop(self: Counters) Counts {
+        var counts = [_]?u64{null} ** n_events;
+        const f = self.leader orelse return counts;
+        _ = linux.ioctl(f, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // nr, time enabled, time running, then a value per event
+        var buf: [3 + n_events]u64 = undefined;
+        const n = std.os.read(f, std.mem.sliceAsBytes(&buf)) catch 0;
+        if (n < 3 * @sizeOf(u64) or buf[0] != self.n_open or n < (3 + buf[0]) * @sizeOf(u64)) {
+            return counts;
+        }
+        const enabled = buf[1];
+        const running = buf[2];
+        // never scheduled, e.g. the PMU was taken the whole time
+        if (running == 0) {
+            return counts;
+        }
+        for (self.order[0..self.n_open]) |event, j| {
+            const value = buf[3 + j];
+            counts[@enumToInt(event)] = if (running < enabled)
+                @intCast(u64, @as(u128, value) * enabled / running)
+            else
+                value;
+        }
+        return counts;
+    }
+};
@@ -0,0 +1,156 @@
+//! Timing of the f128 exp, exp2 and log2 kernels against libquadmath's expq,
+//! exp2q and log2q, which libf128math replaces, and of math.parseFloat()
+//! against strtoflt128.
+//!
+//! Needs libquadmath, so it isn't part of 'zig build bench'. Run with
+//! 'zig build bench-quadmath'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+extern "quadmath" fn expq(x: f128) callconv(.C) f128;
+extern "quadmath" fn exp2q(x: f128) callconv(.C) f128;
+extern "quadmath" fn log2q(x: f128) callconv(.C) f128;
+extern "quadmath" fn strtoflt128(s: [*:0]const u8, sp: ?*[*:0]u8) callconv(.C) f128;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 6;
+
+fn timeFunc(comptime func: fn (f128) f128, inputs: []const f128) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        for (inputs) |x| {
+            math.doNotOptimizeAway(func(x));
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn exp(x: f128) f128 {
+    return math.exp(x);
+}
+fn exp2(x: f128) f128 {
+    return math.exp2(x);
+}
+fn log2(x: f128) f128 {
+    return math.log2(x);
+}
+fn quadExp(x: f128) f128 {
+    return expq(x);
+}
+fn quadExp2(x: f128) f128 {
+    return exp2q(x);
+}
+fn quadLog2(x: f128) f128 {
+    return log2q(x);
+}
+
+fn compare(
+    name: []const u8,
+    comptime ours: fn (f128) f128,
+    comptime quadmath: fn (f128) f128,
+    inputs: []const f128,
+) !void {
+    const t_ours = try timeFunc(ours, inputs);
+    const t_quadmath = try timeFunc(quadmath, inputs);
+    std.debug.print(
+        "{s: <18} f128math {d: >7.2} ns  libquadmath {d: >7.2} ns  speedup {d: >5.2}x\n",
+        .{ name, t_ours, t_quadmath, t_quadmath / t_ours },
+    );
+}
+
+/// Strings for the parsing benchmark, each followed by a 0.
+const Strings = struct {
+    buf: [n_inputs * (math.formatLen(f128) + 1)]u8 = undefined,
+    starts: [n_inputs]usize = undefined,
+
+    fn init(self: *Strings, inputs: []const f128) void {
+        var n: usize = 0;
+        for (inputs) |x, i| {
+            self.starts[i] = n;
+            n += math.formatFloat(self.buf[n..], x).len;
+            self.buf[n] = 0;
+            n += 1;
+        }
+    }
+
+    fn get(self: *const Strings, i: usize) [:0]const u8 {
+        const start = self.starts[i];
+        return std.mem.sliceTo(@ptrCast([*:0]const u8, &self.buf[start]), 0);
+    }
+};
+
+fn timeParse(strings: *const Strings, comptime quadmath: bool) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        var i: usize = 0;
+        while (i < n_inputs) : (i += 1) {
+            const s = strings.get(i);
+            if (quadmath) {
+                math.doNotOptimizeAway(strtoflt128(s.ptr, null));
+            } else {
+                math.doNotOptimizeAway(try math.parseFloat(f128, s));
+            }
+        }
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn compareParse(name: []const u8, inputs: []const f128) !void {
+    var strings: Strings = undefined;
+    strings.init(inputs);
+    const t_ours = try timeParse(&strings, false);
+    const t_quadmath = try timeParse(&strings, true);
+    std.debug.print(
+        "{s: <18} f128math {d: >7.2} ns  strtoflt128 {d: >7.2} ns  speedup {d: >5.2}x\n",
+        .{ name, t_ours, t_quadmath, t_quadmath / t_ours },
+    );
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    var small: [n_inputs]f128 = undefined;
+    var wide: [n_inputs]f128 = undefined;
+    var logs: [n_inputs]f128 = undefined;
+    for (small) |*x| {
+        x.* = random.float(f64) * 2 - 1;
+    }
+    for (wide) |*x| {
+        x.* = random.float(f64) * 20000 - 10000;
+    }
+    for (logs) |*x| {
+        const e = random.intRangeAtMost(i32, -1000, 1000);
+        x.* = math.scalbn(random.float(f64) + 0.5, e);
+    }
+
+    try compare("exp [-1, 1]", exp, quadExp, &small);
+    try compare("exp [-1e4, 1e4]", exp, quadExp, &wide);
+    try compare("exp2 [-1, 1]", exp2, quadExp2, &small);
+    try compare("exp2 [-1e4, 1e4]", exp2, quadExp2, &wide);
+    try compare("log2", log2, quadLog2, &logs);
+
+    // Short decimals such as "1.2345e1", and f128 values with random
+    // mantissas, which take up to 36 digits.
+    var short: [n_inputs]f128 = undefined;
+    var full: [n_inputs]f128 = undefined;
+    for (short) |*x| {
+        x.* = @intToFloat(f128, random.intRangeAtMost(i32, -99999, 99999)) / 1000;
+    }
+    for (full) |*x| {
+        const exp = random.intRangeAtMost(u128, 0x3FFF - 4000, 0x3FFF + 4000);
+        x.* = @bitCast(f128, exp << 112 | random.int(u112));
+    }
+    try compareParse("parse short", &short);
+    try compareParse("parse full", &full);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
@@ -0,0 +1,69 @@
+//! Timing of the f64 exp, exp2 and log2 slice kernels of each SIMD flavour
+//! the CPU supports, against the scalar functions. build.zig compiles this
+//! benchmark for the baseline CPU and links the AVX2 and AVX-512 kernels as
+//! separate objects, so the selection of the flavour at run time is what is
+//! measured.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+pub const f128math_simd_objects = @import("build_options").simd_objects;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+fn timeSlice(func: math.simd.SliceFn, inputs: []const f64, out: []f64) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        func(inputs, out);
+        math.doNotOptimizeAway(out[round % out.len]);
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn compare(name: []const u8, comptime func: []const u8, inputs: []const f64, out: []f64) !void {
+    const widest = math.simd.detect();
+    const t_scalar = try timeSlice(@field(math.simd.kernelsFor(.scalar), func), inputs, out);
+    inline for (.{ .sse2, .avx2, .avx512 }) |flavour| {
+        if (@enumToInt(@as(math.simd.Flavour, flavour)) <= @enumToInt(widest)) {
+            const t = try timeSlice(@field(math.simd.kernelsFor(flavour), func), inputs, out);
+            std.debug.print(
+                "f64    {s: <6} {s: <6} scalar {d: >7.2} ns  simd {d: >7.2} ns  speedup {d: >5.2}x\n",
+                .{ name, @tagName(flavour), t_scalar, t, t_scalar / t },
+            );
+        }
+    }
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    var exp_inputs: [n_inputs]f64 = undefined;
+    var log_inputs: [n_inputs]f64 = undefined;
+    var out: [n_inputs]f64 = undefined;
+    for (exp_inputs) |*x| {
+        x.* = random.float(f64) * 160 - 80;
+    }
+    for (log_inputs) |*x| {
+        const e = random.intRangeAtMost(i32, -100, 100);
+        x.* = math.scalbn(random.float(f64) + 0.5, e);
+    }
+
+    std.debug.print("detected: {s}, selected: {s}\n", .{
+        @tagName(math.simd.detect()),
+        @tagName(math.simd.selectedFlavour()),
+    });
+    try compare("exp", "exp", &exp_inputs, &out);
+    try compare("exp2", "exp2", &exp_inputs, &out);
+    try compare("log2", "log2", &log_inputs, &out);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
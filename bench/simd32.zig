@@ -0,0 +1,74 @@
+//! Timing of the f32 exp and exp2 slice kernels of math.simd32, default and
+//! fast, against the scalar functions. Unlike bench/simd.zig this is compiled
+//! for the native CPU, since the width of the kernels is picked at compile
+//! time.
+//!
+//! Run with 'zig build bench'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_fp_exceptions = @import("build_options").fp_exceptions;
+pub const f128math_branch_counters = @import("build_options").branch_counters;
+
+const n_inputs = 1 << 12;
+const n_rounds = 1 << 8;
+
+const SliceFn = fn (xs: []const f32, out: []f32) void;
+
+fn timeSlice(comptime func: SliceFn, inputs: []const f32, out: []f32) !f64 {
+    var timer = try std.time.Timer.start();
+    var round: usize = 0;
+    while (round < n_rounds) : (round += 1) {
+        func(inputs, out);
+        math.doNotOptimizeAway(out[round % out.len]);
+    }
+    return @intToFloat(f64, timer.read()) / (n_rounds * n_inputs);
+}
+
+fn scalarExp(xs: []const f32, out: []f32) void {
+    for (xs) |x, i| {
+        out[i] = math.exp(x);
+    }
+}
+
+fn scalarExp2(xs: []const f32, out: []f32) void {
+    for (xs) |x, i| {
+        out[i] = math.exp2(x);
+    }
+}
+
+fn compare(
+    name: []const u8,
+    comptime scalar: SliceFn,
+    comptime default: SliceFn,
+    comptime fast: SliceFn,
+    inputs: []const f32,
+    out: []f32,
+) !void {
+    const t_scalar = try timeSlice(scalar, inputs, out);
+    const t_default = try timeSlice(default, inputs, out);
+    const t_fast = try timeSlice(fast, inputs, out);
+    std.debug.print(
+        "f32x{d: <2} {s: <6} scalar {d: >7.2} ns  simd {d: >7.2} ns  fast {d: >7.2} ns  speedup {d: >5.2}x / {d: >5.2}x\n",
+        .{ math.simd32.lanes, name, t_scalar, t_default, t_fast, t_scalar / t_default, t_scalar / t_fast },
+    );
+}
+
+pub fn main() !void {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+
+    var inputs: [n_inputs]f32 = undefined;
+    var out: [n_inputs]f32 = undefined;
+    for (inputs) |*x| {
+        x.* = random.float(f32) * 160 - 80;
+    }
+
+    try compare("exp", scalarExp, math.simd32.exp, math.simd32.fast.exp, &inputs, &out);
+    try compare("exp2", scalarExp2, math.simd32.exp2, math.simd32.fast.exp2, &inputs, &out);
+
+    if (math.counters.enabled) {
+        try math.counters.dump(std.io.getStdErr().writer());
+    }
+}
@@ -1,13 +1,168 @@
 const std = @import("std");
 const Builder = std.build.Builder;
+const LibExeObjStep = std.build.LibExeObjStep;
 
 pub fn build(b: *Builder) !void {
+    // The target of the benchmarks, the native CPU by default.
+    const target = b.standardTargetOptions(.{});
+
     // Tests
     // -------
+    // The f64 vectors are bit exact for the separate multiply and add, so
+    // they run for the baseline CPU, which has no FMA on x86_64. The root of
+    // a test build is the test runner, so f128math_fused_mul_add can't be
+    // declared for them instead.
     var tests = b.addTest("tests/tests.zig");
     tests.addPackagePath("f128math", "src/lib.zig");
+    tests.setTarget(.{ .cpu_model = .baseline });
+
+    // The error bounds of the fused and the separate polynomials, on the
+    // native CPU, where the kernels use FMA if it has it.
+    var muladd_tests = b.addTest("src/muladd.zig");
+
+    // The C ABI exports of libf128math, whose root isn't reachable from
+    // tests/tests.zig.
+    var capi_tests = b.addTest("src/capi.zig");
 
     // Define the 'test' subcommand.
     const test_step = b.step("test", "Run tests");
     test_step.dependOn(&tests.step);
+    test_step.dependOn(&muladd_tests.step);
+    test_step.dependOn(&capi_tests.step);
+
+    // Benchmarks
+    // ------------
+    const fp_exceptions = b.option(
+        bool,
+        "fp-exceptions",
+        "Raise floating point exceptions in the benchmarks (default: true)",
+    ) orelse true;
+    const branch_counters = b.option(
+        bool,
+        "branch-counters",
+        "Count the kernel branches taken in the benchmarks (default: false)",
+    ) orelse false;
+    // The AVX2 and AVX-512 kernels of src/simd.zig are compiled as separate
+    // objects, so that bench_simd itself runs on any x86_64 CPU and picks
+    // them at run time. This depends on the target, not on the host that
+    // runs the build.
+    const simd_objects = target.getCpuArch() == .x86_64;
+    const bench_options = b.addOptions();
+    bench_options.addOption(bool, "fp_exceptions", fp_exceptions);
+    bench_options.addOption(bool, "branch_counters", branch_counters);
+    bench_options.addOption(bool, "simd_objects", simd_objects);
+
+    const avx2_object = simdObject(b, target, "avx2", &avx2_features, bench_options);
+    const avx512_object = simdObject(b, target, "avx512", &(avx2_features ++ avx512_features), bench_options);
+
+    // The baseline CPU of the target, for programs that use the objects.
+    var baseline_target = target;
+    baseline_target.cpu_model = .baseline;
+
+    const bench_step = b.step("bench", "Run benchmarks");
+    inline for (.{ "cr", "directed", "exp2", "fast", "format", "fpexcept", "muladd", "parallel", "perf", "simd", "simd32" }) |name| {
+        var bench = b.addExecutable("bench_" ++ name, "bench/" ++ name ++ ".zig");
+        bench.addPackagePath("f128math", "src/lib.zig");
+        bench.addOptions("build_options", bench_options);
+        bench.setBuildMode(.ReleaseFast);
+        bench.setTarget(target);
+        if (comptime std.mem.eql(u8, name, "simd") and simd_objects) {
+            bench.setTarget(baseline_target);
+            bench.addObject(avx2_object);
+            bench.addObject(avx512_object);
+        }
+        bench_step.dependOn(&bench.run().step);
+    }
+
+    // The kernels of the objects against their error bounds, as a program
+    // since its root has to declare f128math_simd_objects.
+    if (simd_objects) {
+        var simd_objects_test = b.addExecutable("test_simd_objects", "tests/simd_objects.zig");
+        simd_objects_test.addPackagePath("f128math", "src/lib.zig");
+        simd_objects_test.setTarget(baseline_target);
+        simd_objects_test.addObject(avx2_object);
+        simd_objects_test.addObject(avx512_object);
+        test_step.dependOn(&simd_objects_test.run().step);
+    }
+
+    // The f32 functions of src/cr.zig for every argument, which takes too
+    // long for the 'test' step.
+    var exhaustive_cr = b.addExecutable("exhaustive_cr", "tests/exhaustive_cr.zig");
+    exhaustive_cr.addPackagePath("f128math", "src/lib.zig");
+    exhaustive_cr.setBuildMode(.ReleaseFast);
+    exhaustive_cr.setTarget(target);
+    const exhaustive_cr_step = b.step("exhaustive-cr", "Check the f32 math.cr functions for every argument");
+    exhaustive_cr_step.dependOn(&exhaustive_cr.run().step);
+
+    // Against libquadmath, which has to be installed.
+    var bench_quadmath = b.addExecutable("bench_quadmath", "bench/quadmath.zig");
+    bench_quadmath.addPackagePath("f128math", "src/lib.zig");
+    bench_quadmath.addOptions("build_options", bench_options);
+    bench_quadmath.setBuildMode(.ReleaseFast);
+    bench_quadmath.setTarget(target);
+    bench_quadmath.linkLibC();
+    bench_quadmath.linkSystemLibrary("quadmath");
+    const bench_quadmath_step = b.step("bench-quadmath", "Run benchmarks against libquadmath");
+    bench_quadmath_step.dependOn(&bench_quadmath.run().step);
+
+    // C library
+    // -----------
+    // libf128math.so and libf128math.a export expq, exp2q and log2q as
+    // drop-in replacements for libquadmath's.
+    const lib_step = b.step("lib", "Build libf128math and its header");
+    const shared_lib = b.addSharedLibrary("f128math", "src/capi.zig", .unversioned);
+    shared_lib.setBuildMode(.ReleaseFast);
+    lib_step.dependOn(&b.addInstallArtifact(shared_lib).step);
+    const static_lib = b.addStaticLibrary("f128math", "src/capi.zig");
+    static_lib.setBuildMode(.ReleaseFast);
+    lib_step.dependOn(&b.addInstallArtifact(static_lib).step);
+    lib_step.dependOn(&b.addInstallFileWithDir(
+        .{ .path = "include/f128math.h" },
+        .header,
+        "f128math.h",
+    ).step);
+
+    // The quadmath/math.c driver linked against libf128math, to compare with
+    // the plain libquadmath build, e.g. from the hypothesis tests.
+    const driver = b.addExecutable("math-f128math", null);
+    driver.addCSourceFiles(&.{ "quadmath/math.c", "quadmath/util.c" }, &.{});
+    driver.linkLibrary(static_lib);
+    driver.linkLibC();
+    driver.linkSystemLibrary("quadmath");
+    driver.linkSystemLibrary("m");
+    lib_step.dependOn(&b.addInstallArtifact(driver).step);
+}
+
+/// The x86 features of the AVX2 flavour in src/simd.zig, as checked by
+/// simd.detect().
+const avx2_features = [_]std.Target.x86.Feature{
+    .avx2, .fma, .bmi, .bmi2, .lzcnt, .movbe, .f16c,
+};
+
+/// The features the AVX-512 flavour adds to those of the AVX2 one.
+const avx512_features = [_]std.Target.x86.Feature{
+    .avx512f, .avx512dq, .avx512vl, .avx512bw, .avx512cd,
+};
+
+/// Returns the object with the kernels of src/simd.zig for the baseline
+/// x86_64 CPU with features added, for the OS and ABI of target, built with
+/// the programs' options.
+fn simdObject(
+    b: *Builder,
+    target: std.zig.CrossTarget,
+    comptime flavour: []const u8,
+    features: []const std.Target.x86.Feature,
+    options: *std.build.OptionsStep,
+) *LibExeObjStep {
+    const obj = b.addObject("simd_" ++ flavour, "src/simd_export.zig");
+    obj.addOptions("build_options", options);
+    obj.setTarget(.{
+        .cpu_arch = .x86_64,
+        .cpu_model = .baseline,
+        .cpu_features_add = std.Target.x86.featureSet(features),
+        .os_tag = target.os_tag,
+        .abi = target.abi,
+    });
+    obj.setBuildMode(.ReleaseFast);
+    return obj;
 }
@@ -13,7 +13,6 @@ import sys
 from collections import defaultdict
 
 import hypothesis
-import pytest
 from hypothesis import strategies as st
 
 ROOT_DIR = pathlib.Path("__file__").resolve().parent.parent
@@ -95,7 +94,25 @@ for bits in [32, 64, 128]:
 # ------
 
 
-def run_testcase(bits: int, input: int, func: str):
+def is_nan(bits: int, x: int) -> bool:
+    return x & ~consts[bits]["umid"] > consts[bits]["posinf"]
+
+
+def ulp_distance(bits: int, a: int, b: int) -> int:
+    """The number of floats between two (non-nan) bit patterns, with +0 and
+    -0 the same."""
+
+    def ordered(x: int) -> int:
+        if x & consts[bits]["umid"]:
+            return -(x & ~consts[bits]["umid"])
+        return x
+
+    return abs(ordered(a) - ordered(b))
+
+
+def run_testcase(bits: int, input: int, func: str, max_ulps: int = 0):
+    """Compares the output bit for bit, or within max_ulps for a reference
+    that isn't correctly rounded. Any nan matches any other then."""
     input_hex = f"0x{{:0{bits // 4}X}}".format(input)
     hypothesis.note(f"Input: {input_hex}")
     exp_proc = subprocess.run(
@@ -112,11 +129,20 @@ def run_testcase(bits: int, input: int, func: str):
         stderr=subprocess.PIPE,
         universal_newlines=True,
     )
-    assert actual_proc.stdout.upper() == exp_proc.stdout.upper()
-    # if actual_proc.stdout.upper() != exp_proc.stdout.upper():
-    #     print(f"Expected stderr:\n{exp_proc.stderr}", file=sys.stderr)
-    #     print(f"Actual stderr:\n{actual_proc.stderr}", file=sys.stderr)
-    #     assert actual_proc.stdout.upper() == exp_proc.stdout.upper()
+    if max_ulps == 0:
+        assert actual_proc.stdout.upper() == exp_proc.stdout.upper()
+        # if actual_proc.stdout.upper() != exp_proc.stdout.upper():
+        #     print(f"Expected stderr:\n{exp_proc.stderr}", file=sys.stderr)
+        #     print(f"Actual stderr:\n{actual_proc.stderr}", file=sys.stderr)
+        #     assert actual_proc.stdout.upper() == exp_proc.stdout.upper()
+        return
+    expected = int(exp_proc.stdout, 16)
+    actual = int(actual_proc.stdout, 16)
+    hypothesis.note(f"Expected: 0x{expected:X}, actual: 0x{actual:X}")
+    if is_nan(bits, expected) or is_nan(bits, actual):
+        assert is_nan(bits, expected) and is_nan(bits, actual)
+    else:
+        assert ulp_distance(bits, expected, actual) <= max_ulps
 
 
 @hypothesis.given(st.one_of(strats[32]["inf"], strats[32]["finite"]))
@@ -163,6 +189,29 @@ def test_exp2_128(input: int):
     run_testcase(128, input, "exp2")
 
 
+@hypothesis.given(st.one_of(strats[32]["inf"], strats[32]["finite"]))
+def test_exp10_32(input: int):
+    run_testcase(32, input, "exp10")
+
+
+@hypothesis.given(st.one_of(strats[64]["inf"], strats[64]["finite"]))
+def test_exp10_64(input: int):
+    run_testcase(64, input, "exp10")
+
+
+@hypothesis.given(st.one_of(strats[128]["inf"], strats[128]["finite"]))
+def test_exp10_128(input: int):
+    # NOTE: The C side uses powq(10, x), which is not always correctly
+    # rounded (e.g. it doesn't give exact results for negative integers), so
+    # only agreement within an ulp is checked.
+    run_testcase(128, input, "exp10", max_ulps=1)
+
+
+@hypothesis.given(st.one_of(strats[128]["inf"], strats[128]["finite"]))
+def test_expm1_128(input: int):
+    run_testcase(128, input, "expm1")
+
+
 @hypothesis.given(strats[32]["pos_finite"])
 def test_log2_32(input: int):
     # TODO: Found failures:
@@ -180,7 +229,6 @@ def test_log2_64(input: int):
     run_testcase(64, input, "log2")
 
 
-@pytest.mark.skip("log2_128() not implemented in Zig yet")
 @hypothesis.given(strats[128]["pos_finite"])
 def test_log2_128(input: int):
     run_testcase(128, input, "log2")
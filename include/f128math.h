@@ -0,0 +1,34 @@
+/*
+ * C interface to the f128math binary128 kernels.
+ *
+ * libf128math exports expq(), exp2q() and log2q() with the same names and
+ * signatures as libquadmath, so existing C and C++ callers switch to these
+ * kernels by linking it ahead of libquadmath, e.g.
+ *
+ *    gcc app.c -Lzig-out/lib -lf128math -lquadmath -lm
+ *
+ * The library and this header are built and installed with 'zig build lib'.
+ * Code that doesn't include quadmath.h can include this header instead.
+ *
+ * Unlike libquadmath, errno is not set on overflow, underflow or domain
+ * errors, and the floating point exception flags are not set the way
+ * libquadmath sets them: binary128 arithmetic is done in software, which
+ * doesn't touch them, so don't rely on fetestexcept() after these calls.
+ */
+
+#ifndef F128MATH_H
+#define F128MATH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+__float128 expq (__float128 x);
+__float128 exp2q (__float128 x);
+__float128 log2q (__float128 x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* F128MATH_H */
@@ -0,0 +1,442 @@
+#!/usr/bin/env python3
+
+"""
+Derives the error bounds of the directed rounding exp, exp2 and log2 in
+src/directed.zig, and of the Ziv steps of the correctly rounded f64 exp2 in
+src/cr.zig.
+
+Each kernel returns hi + lo, and the bound is on |exact - (hi + lo)| relative
+to |hi|. It's the sum of the errors of the reduction, the table entries, the
+polynomial approximation and the rounding of every operation, each bounded
+over the whole argument range rather than sampled:
+
+- Operations are modelled as fl(a op b) = (a op b)(1 + d), |d| <= u = 2^-53
+  (2^-113 for f128), which holds since no intermediate underflows, except
+  the f64 products of a tiny z or r, whose absolute error of at most 2^-1074
+  is added separately.
+- Table entries are compared with their exact values, computed with 100
+  digit decimal arithmetic.
+- The polynomial approximation error is bounded with its Taylor series (and
+  the remainder) at a grid of points, plus the grid spacing times a bound on
+  the derivative, all in exact rational arithmetic.
+
+The tables are read from the Zig sources. The bounds are printed, and the
+script fails if any is above the err_bound of its function.
+
+Usage: misc/directed_bounds.py
+"""
+
+import decimal
+import math
+import os.path
+import re
+import sys
+from fractions import Fraction
+from typing import Dict, List, NamedTuple
+
+decimal.getcontext().prec = 100
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+
+U = Fraction(1, 2**53)
+U128 = Fraction(1, 2**113)
+# Covers the error of the 100 digit transcendental functions.
+SLACK = Fraction(1, 2**300)
+UNDERFLOW = Fraction(1, 2**1074)
+
+LN2 = Fraction(decimal.Decimal(2).ln())
+LOG2E = 1 / LN2
+
+hex_float_regex = r"-?0x1(?:\.[\da-f]+)?p[+-]\d+|0\.0"
+
+
+def hexf(s: str) -> Fraction:
+    return Fraction(float.fromhex(s))
+
+
+def hexq(s: str) -> Fraction:
+    """Parses a hex float literal exactly, whatever its precision."""
+    match = re.fullmatch(r"(-?)0x([\da-f])(?:\.([\da-f]+))?p([+-]\d+)", s)
+    assert match, s
+    sign, lead, frac, exp = match.groups()
+    frac = frac or ""
+    v = Fraction(int(lead + frac, 16), 16 ** len(frac)) * Fraction(2) ** int(exp)
+    return -v if sign else v
+
+
+def log2(x: Fraction) -> Fraction:
+    d = decimal.Decimal(x.numerator) / decimal.Decimal(x.denominator)
+    return Fraction(d.ln()) / LN2
+
+
+def exp2(y: Fraction) -> Fraction:
+    d = decimal.Decimal(y.numerator) / decimal.Decimal(y.denominator)
+    return Fraction((d * decimal.Decimal(2).ln()).exp())
+
+
+def read_table(filename: str, name: str) -> List[Fraction]:
+    with open(os.path.join(SRC_DIR, filename)) as f:
+        text = f.read()
+    match = re.search(rf"const {name} = \[[^\]]*\][^{{]*{{(.*?)\n}};", text, re.S)
+    assert match, f"{name} not found in {filename}"
+    body = re.sub(r"//[^\n]*", "", match.group(1))
+    return [hexq(s) if s != "0.0" else Fraction(0) for s in re.findall(hex_float_regex, body)]
+
+
+def log2f(x: Fraction) -> str:
+    return "0" if x == 0 else f"2^{math.log2(x):.2f}"
+
+
+def log(name: str, x: Fraction) -> None:
+    print(f"  {name:<40} {log2f(x):>9}")
+
+
+class Bound(NamedTuple):
+    """A bound m on the magnitude of the exact value of an expression and a
+    bound e on the error of its floating point evaluation with unit roundoff
+    u."""
+
+    m: Fraction
+    e: Fraction
+    u: Fraction = U
+
+    @staticmethod
+    def exact(m: Fraction, u: Fraction = U) -> "Bound":
+        return Bound(abs(m), Fraction(0), u)
+
+    def __add__(self, other: "Bound") -> "Bound":
+        m = self.m + other.m
+        e = self.e + other.e
+        return Bound(m, e + self.u * (m + e), self.u)
+
+    def __mul__(self, other: "Bound") -> "Bound":
+        m = self.m * other.m
+        e = self.m * other.e + other.m * self.e + self.e * other.e
+        return Bound(m, e + self.u * (m + e), self.u)
+
+    def fma(self, other: "Bound", c: "Bound") -> "Bound":
+        """self * other + c with a single rounding."""
+        m = self.m * other.m + c.m
+        e = self.m * other.e + other.m * self.e + self.e * other.e + c.e
+        return Bound(m, e + self.u * (m + e), self.u)
+
+
+def horner(w: Fraction, coeffs: List[Fraction], fused: bool, u: Fraction = U) -> Bound:
+    """Bounds p = c[0] + w * (c[1] + w * (...)) for |w| <= w, evaluated with
+    a multiply and an add, or a fused multiply-add, in each step."""
+    p = Bound.exact(coeffs[-1], u)
+    for c in reversed(coeffs[:-1]):
+        if fused:
+            p = Bound.exact(w, u).fma(p, Bound.exact(c, u))
+        else:
+            p = Bound.exact(w, u) * p + Bound.exact(c, u)
+    return p
+
+
+def approx_error(W: Fraction, coeffs: List[Fraction], n_grid: int = 2000) -> Fraction:
+    """Bounds |2^w - (1 + w * P(w))| for |w| <= W, with P the polynomial of
+    coeffs."""
+    n_taylor = 24
+    taylor = [Fraction(1)]
+    for n in range(1, n_taylor + 1):
+        taylor.append(taylor[-1] * LN2 / n)
+    # 2^w - sum of the Taylor terms, for |w| <= W < 1
+    remainder = (LN2 * W) ** (n_taylor + 1) / _factorial(n_taylor + 1) * 2
+    diff = list(taylor)
+    diff[0] -= 1
+    for n, c in enumerate(coeffs, start=1):
+        diff[n] -= c
+    deriv = sum(n * abs(d) * W ** (n - 1) for n, d in enumerate(diff) if n > 0)
+
+    def at(w: Fraction) -> Fraction:
+        v = Fraction(0)
+        for d in reversed(diff):
+            v = v * w + d
+        return abs(v)
+
+    h = 2 * W / n_grid
+    grid_max = max(at(-W + j * h) for j in range(n_grid + 1))
+    return grid_max + h / 2 * deriv + remainder + SLACK
+
+
+def _factorial(n: int) -> int:
+    f = 1
+    for i in range(2, n + 1):
+        f *= i
+    return f
+
+
+class Exp2Kernel(NamedTuple):
+    """Table and polynomial of an exp2 kernel that returns hi = t and
+    lo = (t * w) * p(w), w = z - eps, with t = 2^((i - N/2)/N + eps)."""
+
+    ts: List[Fraction]
+    epss: List[Fraction]
+    P: List[Fraction]
+    u: Fraction
+    # the evaluations of p(w) that the kernel may use
+    fused: List[bool]
+    # absolute error of an underflowing product, 0 if none can underflow
+    underflow: Fraction
+
+
+def exp2_64_kernel() -> Exp2Kernel:
+    table = read_table("exp2.zig", "exp2_64_table")
+    return Exp2Kernel(
+        ts=table[0::2],
+        epss=table[1::2],
+        P=[hexq(s) for s in (
+            "0x1.62e42fefa39efp-1",
+            "0x1.ebfbdff82c575p-3",
+            "0x1.c6b08d704a0a6p-5",
+            "0x1.3b2ab88f70400p-7",
+            "0x1.5d88003875c74p-10",
+        )],
+        u=U,
+        fused=[False, True],
+        underflow=UNDERFLOW,
+    )
+
+
+def exp2_128_kernel() -> Exp2Kernel:
+    return Exp2Kernel(
+        ts=read_table("exp2.zig", "exp2_128_table"),
+        epss=read_table("exp2.zig", "exp2_128_eps_table"),
+        P=[hexq(s) for s in (
+            "0x1.62e42fefa39ef35793c7673007e6p-1",
+            "0x1.ebfbdff82c58ea86f16b06ec9736p-3",
+            "0x1.c6b08d704a0bf8b33a762bad3459p-5",
+            "0x1.3b2ab6fba4e7729ccbbe0b4f3fc2p-7",
+            "0x1.5d87fe78a67311071dee13fd11d9p-10",
+            "0x1.430912f86c7876f4b663b23c5fe5p-13",
+            "0x1.ffcbfc588b041p-17",
+            "0x1.62c0223a5c7c7p-20",
+            "0x1.b52541ff59713p-24",
+            "0x1.e4cf56a391e22p-28",
+        )],
+        u=U128,
+        fused=[False],
+        underflow=Fraction(0),
+    )
+
+
+class Exp2Bound(NamedTuple):
+    # bound on |2^(i'/N + z + dz) - (hi + lo)| / hi
+    err: Fraction
+    # bound on |lo| / hi
+    lo: Fraction
+
+
+def exp2_kernel_bound(kernel: Exp2Kernel, W_in: Fraction, dz: Fraction) -> Exp2Bound:
+    """Bounds the error of the exp2 kernel over |z| <= W_in, where the exact
+    argument is off by at most dz, and the size of lo."""
+    n = len(kernel.ts)
+    u = kernel.u
+    P = kernel.P
+
+    max_eps = max(abs(eps) for eps in kernel.epss)
+    # The bound is monotonic in |eps|, so use the largest one with the
+    # largest table error.
+    tau = Fraction(0)
+    for i, (t, eps) in enumerate(zip(kernel.ts, kernel.epss)):
+        exact = exp2(Fraction(i - n // 2, n) + eps)
+        tau = max(tau, abs(exact - t) / t + SLACK)
+
+    # w = z - eps, rounded: |w - fl(w)| <= u |w|
+    Wi = W_in + max_eps
+    Wp = Wi * (1 + u)
+    A = approx_error(Wp, P)
+    # 2^(w + dw) / 2^w - 1 for the rounding of w and the argument error,
+    # with ln(2) |dw| < 2^-50, where e^a - 1 <= a (1 + a)
+    dw = u * Wi + dz
+    eps_w = LN2 * dw * (1 + LN2 * dw)
+    # lo = (t * w) * p, relative to t
+    evals = []
+    for fused in kernel.fused:
+        p = horner(Wp, P, fused, u)
+        evals.append(Wp * (p.e + (p.m + p.e) * (2 * u + u * u)))
+    # the underflow of t * w and of the product with p, relative to t > 1/2
+    eval_err = max(evals) + 4 * kernel.underflow
+    Q = Wp * horner(Wp, P, False, u).m
+    G = 1 + Q + A
+    worst = A + G * ((1 + tau) * (1 + eps_w) - 1) + eval_err
+
+    log("table, |2^(i/N + eps) - t| / t", tau)
+    log("polynomial approximation", A)
+    log("rounding of w, and argument error", eps_w)
+    log("evaluation of lo", eval_err)
+    return Exp2Bound(err=worst, lo=Q + eval_err)
+
+
+def exp_reduction() -> Dict[str, Fraction]:
+    """Bounds for the reduction of exp64Bounds(): returns the bound W on |z|
+    and dz on |z - r/ln(2)|, with r the exact remainder."""
+    N = 256
+    inv_ln2_n = hexf("0x1.71547652b82fep+8")
+    hi = hexf("0x1.62e42fef8p-9")
+    lo = hexf("0x1.1cf79abc9e3b4p-44")
+    log2e = hexf("0x1.71547652b82fep+0")
+    # The range of the kernel: log(2^-1075) < x <= log(f64_max)
+    x_max = Fraction(746)
+    n_max = int(x_max * N / LN2) + 1
+    assert n_max.bit_length() + hi.numerator.bit_length() <= 53, "kd * ln2_n_hi must be exact"
+
+    # kd = round(fl(x * inv_ln2_n))
+    dn = x_max * abs(inv_ln2_n - N / LN2) + U * x_max * inv_ln2_n
+    r_max = (Fraction(1, 2) + dn) * LN2 / N
+    dL = abs(LN2 / N - hi - lo)
+    # x - kd * hi is exact, then r = fl(that - fl(kd * lo))
+    dr = n_max * dL + U * n_max * lo
+    dr += U * (r_max + dr)
+    r_bound = r_max + dr
+    # z = fl(r * log2e)
+    dz = r_bound * abs(log2e - LOG2E) + dr * LOG2E + U * r_bound * log2e
+    W = r_bound * log2e * (1 + U)
+    log("reduction, |z - r / ln(2)|", dz)
+    return {"W": W, "dz": dz}
+
+
+def log2_bound() -> Fraction:
+    """Bounds |log2(x) - (hi + lo)| / |hi| for log2_64Parts()."""
+    with open(os.path.join(SRC_DIR, "fast.zig")) as f:
+        fast = f.read()
+    entries = re.findall(
+        rf"\.invc = ({hex_float_regex}), \.log2c = (-?{hex_float_regex})", fast
+    )
+    offset = int(re.search(r"log2_table_offset = (\d+);", fast).group(1))
+    n = 1 << int(re.search(r"log2_tbl_bits = (\d+);", fast).group(1))
+    lo_table = read_table("directed.zig", "log2c_lo_table")
+    assert len(lo_table) == len(entries)
+
+    L1 = hexf("0x1.71547652b82fep+0")
+    L1_tail = hexf("0x1.777d0ffda0d24p-56")
+    Q = [hexf(s) for s in (
+        "-0x1.71547652b82fep-1",
+        "0x1.ec709dc3a03fdp-2",
+        "-0x1.71547652b82fep-2",
+        "0x1.2776c50ef9bfep-2",
+        "-0x1.ec709dc3a03fdp-3",
+        "0x1.a61762a7aded9p-3",
+        "-0x1.71547652b82fep-3",
+    )]
+    # the Taylor coefficients c_n of log2(1 + v)
+    C = [Fraction((-1) ** (n + 1), n) / LN2 for n in range(2, 9)]
+    dL1 = abs(LOG2E - L1 - L1_tail)
+    # the smallest |log2(x)| for k != 0, and the largest |k|
+    k_min_log2 = Fraction(1, 2)
+    k_max = 1100
+
+    worst = Fraction(0)
+    for idx, ((invc_s, log2c_s), lo_i) in enumerate(zip(entries, lo_table)):
+        i = idx - offset
+        invc, log2c = hexf(invc_s), hexf(log2c_s)
+        c = 1 + Fraction(i, n)
+        d_max = Fraction(1, 2 * n)
+        tau = abs(log2(c) - log2c - lo_i) + SLACK
+        R = d_max * invc * (1 + U)
+        # rho = d/c - r, and the error of its evaluation rc
+        rho = d_max * abs(1 / c - invc) + U * R
+        a1 = c * rho + c * R * Fraction(1, 2**44)
+        e_a2 = U * a1 + U * (c * rho + U * a1)
+        e_rc = e_a2 * invc + c * rho * abs(invc - 1 / c) + U * (c * rho + e_a2) * invc
+        rc_m = rho + e_rc
+        e_rc_l1 = e_rc * L1 + rho * abs(L1 - LOG2E) + U * rc_m * L1
+        if i == 0:
+            # c = 1: r = d, and rc, log2c and its low part are all 0
+            assert invc == 1 and log2c == 0 and lo_i == 0
+            tau = rho = rc_m = e_rc_l1 = Fraction(0)
+        # log2(1 + r + rho) - log2(1 + r) - rho / ln(2)
+        x1 = rho * LOG2E * (R + rho) / (1 - R - rho)
+        trunc = R**9 / (9 * LN2 * (1 - R))
+        coeff = sum(abs(q - cn) * R ** (j + 2) for j, (q, cn) in enumerate(zip(Q, C)))
+
+        # q = r2 * ((Q2 + r * Q3) + r2 * ((Q4 + r * Q5) + r2 * ((Q6 + r * Q7) + r2 * Q8)))
+        r = Bound.exact(R)
+        r2 = r * r
+
+        def pair(a: Fraction, b: Fraction) -> Bound:
+            return Bound.exact(a) + r * Bound.exact(b)
+
+        inner = pair(Q[4], Q[5]) + r2 * Bound.exact(Q[6])
+        mid = pair(Q[2], Q[3]) + r2 * inner
+        q = r2 * (pair(Q[0], Q[1]) + r2 * mid)
+
+        p_m = R * L1 * (1 + U)
+        for k in (0, 1, k_max):
+            s1 = k + abs(log2c)
+            s2 = s1 + p_m
+            # s1 = k + log2c and s2 = s1 + p are exact for k = 0 and c = 1
+            e1 = U * s1 if k != 0 and i != 0 else Fraction(0)
+            e2 = U * s2 if k != 0 or i != 0 else Fraction(0)
+            p_err = U * p_m
+            # lo = e1 + e2 + lo_i + p_err + r * L1_tail + rc * L1 + q, left to
+            # right
+            terms = [
+                Bound.exact(e1),
+                Bound.exact(e2),
+                Bound.exact(lo_i),
+                Bound.exact(p_err),
+                Bound(R * L1_tail, U * R * L1_tail),
+                Bound(rc_m * L1, e_rc_l1),
+                Bound(q.m, q.e + coeff + trunc),
+            ]
+            s = terms[0]
+            for term in terms[1:]:
+                s = s + term
+            err = s.e + tau + R * dL1 + x1
+            if k == 0 and i == 0:
+                # hi = fl(r * L1), and every error is a multiple of |r| or
+                # of a higher power, so the bound relative to |hi| is largest
+                # for the largest |r|
+                h_min = R * L1 * (1 - U)
+            elif k == 0:
+                # |log2(c + d)| is smallest at the end of [c - 1/2N, c + 1/2N]
+                # closest to 1, and hi = log2(x) - lo - err
+                near = c - d_max if i > 0 else c + d_max
+                h_min = abs(log2(near)) - s.m - s.e - err
+            else:
+                # |log2(x)| >= |k| - 1/2, and the bound (a + b |k|) / (|k| - 1/2)
+                # is largest at one end of the range of k
+                h_min = k - k_min_log2 - s.m - s.e - err
+            worst = max(worst, err / h_min)
+
+    log("log2, relative to |hi|", worst)
+    return worst
+
+
+def check(name: str, bound: Fraction, err_bound: Fraction) -> bool:
+    ok = bound <= err_bound
+    print(f"{name}: {log2f(bound)} <= {log2f(err_bound)}: {'ok' if ok else 'FAILED'}")
+    return ok
+
+
+def main() -> int:
+    ok = True
+    kernel64 = exp2_64_kernel()
+    print("exp2_64Bounds:")
+    exp2_b = exp2_kernel_bound(kernel64, Fraction(1, 2 * 256), Fraction(0))
+    ok &= check("exp2", exp2_b.err, Fraction(1, 2**59))
+    print("exp64Bounds:")
+    red = exp_reduction()
+    exp_b = exp2_kernel_bound(kernel64, red["W"], red["dz"])
+    ok &= check("exp", exp_b.err, Fraction(1, 2**58))
+    print("log2_64Bounds:")
+    log2_b = log2_bound()
+    ok &= check("log2", log2_b, Fraction(1, 2**58))
+
+    # cr.exp2_64() widens hi + lo by e = hi * err_bound on both sides, and
+    # fl(lo +- e) is off by at most u |lo +- e|, which the bound must leave
+    # room for.
+    print("cr.exp2_64:")
+    ok &= check("fast path", exp2_b.err + U * (exp2_b.lo + Fraction(1, 2**60)), Fraction(1, 2**60))
+    # exp2_64Slow() compares fl((hi - m) + lo) with 2 hi * err_bound, for a
+    # midpoint m, and hi - m is exact when it matters.
+    print("cr.exp2_64Slow:")
+    kernel128 = exp2_128_kernel()
+    exp2_128_b = exp2_kernel_bound(kernel128, Fraction(1, 2 * len(kernel128.ts)), Fraction(0))
+    ok &= check("slow path", exp2_128_b.err, Fraction(1, 2**116))
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+
+"""
+Generates correctly rounded test vectors for exp, exp2 and log2, independently
+of the Zig kernels and of libquadmath.
+
+Each result is computed with 120 digit decimal arithmetic and rounded to
+nearest even at the precision of the type, subnormals included. Arguments
+whose result is too close to a rounding boundary for that precision to
+decide are skipped. The vectors are printed as tcNN() lines for the files in
+tests/.
+
+Usage: misc/exact_vectors.py {exp,exp2,log2} {f64,f80} [--cr] [--seed N]
+
+--cr picks the arguments for the correctly rounded math.cr.exp2(): many of
+them have a result within 2^-59 (relative) of a point half way between two
+floats, so that the fast path of src/cr.zig can't decide them.
+"""
+
+import argparse
+import decimal
+import random
+import sys
+from fractions import Fraction
+from typing import Callable, List, NamedTuple, Optional
+
+decimal.getcontext().prec = 120
+
+LN2 = decimal.Decimal(2).ln()
+
+
+class FloatType(NamedTuple):
+    name: str
+    # significand bits, including the leading one
+    p: int
+    # exponent of the smallest normal
+    emin: int
+    emax: int
+
+    @property
+    def bits(self) -> int:
+        return {"f64": 64, "f80": 80}[self.name]
+
+
+TYPES = {
+    "f64": FloatType("f64", 53, -1022, 1023),
+    "f80": FloatType("f80", 64, -16382, 16383),
+}
+
+
+def to_decimal(x: Fraction) -> decimal.Decimal:
+    return decimal.Decimal(x.numerator) / decimal.Decimal(x.denominator)
+
+
+def exact_exp(x: Fraction) -> decimal.Decimal:
+    return to_decimal(x).exp()
+
+
+def exact_exp2(x: Fraction) -> decimal.Decimal:
+    return (to_decimal(x) * LN2).exp()
+
+
+def exact_log2(x: Fraction) -> decimal.Decimal:
+    return to_decimal(x).ln() / LN2
+
+
+FUNCS = {"exp": exact_exp, "exp2": exact_exp2, "log2": exact_log2}
+
+
+def ilog2(v: Fraction) -> int:
+    """floor(log2(v)) for v > 0."""
+    e = v.numerator.bit_length() - v.denominator.bit_length()
+    if Fraction(2) ** e > v:
+        e -= 1
+    return e
+
+
+def round_nearest(v: Fraction, t: FloatType) -> Fraction:
+    """Rounds v to nearest even in t, with subnormals and overflow to inf
+    (returned as None)."""
+    if v == 0:
+        return v
+    sign = -1 if v < 0 else 1
+    v = abs(v)
+    e = max(ilog2(v), t.emin)
+    scale = Fraction(2) ** (e - t.p + 1)
+    q = v / scale
+    n = q.numerator // q.denominator
+    rem = q - n
+    if rem > Fraction(1, 2) or (rem == Fraction(1, 2) and n % 2 == 1):
+        n += 1
+    r = n * scale
+    if r >= Fraction(2) ** (t.emax + 1):
+        return None
+    return sign * r
+
+
+def hex_literal(v: Optional[Fraction], t: FloatType) -> str:
+    """A Zig literal for a value of t, normalized as 0x1.<hex>p<e>."""
+    if v is None:
+        return f"inf_{t.name}"
+    if v == 0:
+        return "0"
+    sign = "-" if v < 0 else " "
+    v = abs(v)
+    e = ilog2(v)
+    m = v / Fraction(2) ** e
+    # m in [1, 2) with at most p bits, as an integer fraction of 4 bit digits
+    n_digits = (t.p - 1 + 3) // 4
+    frac = (m - 1) * 16**n_digits
+    assert frac.denominator == 1
+    digits = f"{frac.numerator:0{n_digits}x}".rstrip("0")
+    mant = f"0x1.{digits}" if digits else "0x1"
+    return f"{sign}{mant}p{e:+d}"
+
+
+def random_float(rng: random.Random, lo: float, hi: float, t: FloatType) -> Fraction:
+    """A random value of t in [lo, hi), with all p bits random."""
+    x = Fraction(lo) + (Fraction(hi) - Fraction(lo)) * Fraction(rng.getrandbits(t.p + 8), 2 ** (t.p + 8))
+    r = round_nearest(x, t)
+    assert r is not None
+    return r
+
+
+def correctly_rounded(func: Callable, x: Fraction, t: FloatType) -> Optional[Fraction]:
+    """Returns the rounded result, or raises ValueError if the precision of
+    the exact value isn't enough to decide it."""
+    y = Fraction(func(x))
+    tol = abs(y) * Fraction(1, 10**110)
+    r = round_nearest(y - tol, t)
+    if r != round_nearest(y + tol, t):
+        raise ValueError(x)
+    return r
+
+
+def midpoint_distance(y: Fraction, t: FloatType) -> Fraction:
+    """Returns the distance of y > 0 from the nearest point half way between
+    two floats of t, relative to y."""
+    e = max(ilog2(y), t.emin)
+    half_ulp = Fraction(2) ** (e - t.p)
+    q = y / half_ulp
+    n = q.numerator // q.denominator
+    # the midpoints are the odd multiples of half an ulp
+    odd = n if n % 2 == 1 else n + 1
+    return min(abs(y - odd * half_ulp), abs(y - (odd - 2) * half_ulp)) / y
+
+
+def arguments(name: str, t: FloatType, cr: bool, rng: random.Random) -> List[Fraction]:
+    xs: List[Fraction] = []
+    if name == "log2":
+        for _ in range(20):
+            xs.append(random_float(rng, 0.5, 2.0, t))
+        for _ in range(20):
+            m = random_float(rng, 1.0, 2.0, t)
+            xs.append(m * Fraction(2) ** rng.randint(t.emin, t.emax))
+        # subnormal arguments
+        for _ in range(4):
+            n = rng.getrandbits(t.p - 1) | 1
+            xs.append(n * Fraction(2) ** (t.emin - t.p + 1))
+        return xs
+
+    # x = scale * log2(result)
+    scale = Fraction(1) if name == "exp2" else Fraction(LN2)
+    hi = float((t.emax + 1) * scale)
+    sub_lo = float((t.emin - t.p + 1) * scale)
+    sub_hi = float(t.emin * scale)
+    for _ in range(30):
+        xs.append(random_float(rng, -1.0, 1.0, t))
+    for _ in range(20):
+        xs.append(random_float(rng, sub_hi, hi, t))
+    # subnormal results
+    for _ in range(10):
+        xs.append(random_float(rng, sub_lo, sub_hi, t))
+    if cr:
+        func = FUNCS[name]
+        found = 0
+        while found < 24:
+            x = random_float(rng, sub_hi, hi, t)
+            y = Fraction(func(x))
+            if midpoint_distance(y, t) < Fraction(1, 2**59):
+                xs.append(x)
+                found += 1
+    return xs
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("func", choices=FUNCS)
+    parser.add_argument("type", choices=TYPES)
+    parser.add_argument("--cr", action="store_true")
+    parser.add_argument("--seed", type=int, default=0x2545F4914F6CDD1D)
+    args = parser.parse_args()
+
+    t = TYPES[args.type]
+    rng = random.Random(args.seed)
+    func = FUNCS[args.func]
+    lines = []
+    for x in arguments(args.func, t, args.cr, rng):
+        try:
+            y = correctly_rounded(func, x, t)
+        except ValueError:
+            continue
+        x_lit = hex_literal(x, t)
+        y_lit = hex_literal(y, t)
+        lines.append((x_lit, y_lit))
+    x_width = max(len(x) for x, _ in lines)
+    y_width = max(len(y) for _, y in lines)
+    for x_lit, y_lit in lines:
+        print(f"    tc{t.bits}({x_lit + ',':<{x_width + 1}} {y_lit:<{y_width}} ),")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -9,8 +9,13 @@
  *
  * Compile with:
  *    gcc math.c util.c -lm -lquadmath -o math
+ *
+ * 'zig build lib' also builds it as zig-out/bin/math-f128math, linked against
+ * libf128math ahead of libquadmath, so that expq(), exp2q() and log2q() are
+ * replaced by the f128math kernels.
  */
 
+#define _GNU_SOURCE /* exp10f(), exp10() */
 #include <stdio.h>
 #include <string.h>
 
@@ -20,6 +25,14 @@
 #include "util.h"
 
 
+/* libquadmath has no exp10q(), so fall back to powq(). */
+static __float128
+exp10q (__float128 x)
+{
+    return powq(10, x);
+}
+
+
 #define MATH_FUNCS_FROM_NAME(name) \
     (single_input_funcs_t){name ## f, name, name ## q}
 
@@ -34,8 +47,8 @@ math_parse_func_name (const char           *name,
         *funcs = MATH_FUNCS_FROM_NAME(exp);
     } else if (strcmp("exp2", name) == 0) {
         *funcs = MATH_FUNCS_FROM_NAME(exp2);
-    // } else if (strcmp("exp10", name) == 0) {
-    //     *funcs = MATH_FUNCS_FROM_NAME(exp10);
+    } else if (strcmp("exp10", name) == 0) {
+        *funcs = MATH_FUNCS_FROM_NAME(exp10);
     } else if (strcmp("expm1", name) == 0) {
         *funcs = MATH_FUNCS_FROM_NAME(expm1);
     // } else if (strcmp("expo2", name) == 0) {
@@ -0,0 +1,355 @@
+// Eight lane f64 exp, exp2 and log2 with tables small enough to be kept in
+// registers, for the avx512 flavour of simd.zig.
+//
+// The kernels of the narrower flavours look up the 256-entry exp2_64_table
+// one lane at a time, which on eight lanes costs more than the rest of the
+// kernel. These use 16-entry tables instead. Each column is two zmm
+// registers, which vpermi2pd indexes with the low 4 bits of each lane, so the
+// loop does no memory lookups at all. The wider reduced arguments this leaves
+// are made up for with polynomials of higher degree:
+//
+//   function | reduction                         | polynomial | max error
+//   ---------|-----------------------------------|------------|----------
+//   exp      | x = (k + i/16) * ln2 + r          | degree 7   | 0.55 ulp
+//   exp2     | x = k + i/16 + r                  | degree 7   | 0.56 ulp
+//   log2     | x = 2^k * z, z = (1 + r) / invc_i | degree 10  | 0.53 ulp
+//
+// with |r| <= 1/32 throughout. The maxima were measured against a high
+// precision reference. The results don't match the scalar functions bit for
+// bit, unlike those of the other flavours.
+//
+// The kernels use fused multiply-adds, which are software calls on targets
+// without them, so simd.zig only selects these where AVX-512 is compiled in.
+// As in simd.zig, a vector with any lane whose result isn't normal goes to
+// the scalar functions.
+
+const std = @import("std");
+const builtin = @import("builtin");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const simd = @import("simd.zig");
+
+/// Whether the target has AVX-512, so the tables are indexed with vpermi2pd.
+pub const target_has_avx512 = builtin.cpu.arch == .x86_64 and
+    std.Target.x86.featureSetHas(builtin.cpu.features, .avx512f);
+
+const F = @Vector(8, f64);
+const U = @Vector(8, u64);
+const I = @Vector(8, i64);
+
+inline fn splat(x: anytype) @Vector(8, @TypeOf(x)) {
+    return @splat(8, x);
+}
+
+/// Returns table[i & 15] for each lane.
+pub inline fn permute(comptime table: [16]f64, i: U) F {
+    if (target_has_avx512) {
+        const lo: F = table[0..8].*;
+        const hi: F = table[8..16].*;
+        // Bit 3 of each index selects between the two halves.
+        return asm ("vpermi2pd %[hi], %[lo], %%zmm0"
+            : [ret] "={zmm0}" (-> F),
+            : [i] "{zmm0}" (i),
+              [lo] "v" (lo),
+              [hi] "v" (hi),
+        );
+    } else {
+        var y: [8]f64 = undefined;
+        comptime var j = 0;
+        inline while (j < 8) : (j += 1) {
+            y[j] = table[@intCast(usize, i[j] & 15)];
+        }
+        return y;
+    }
+}
+
+/// 2^k for k in [-1022, 1023].
+inline fn pow2(k: I) F {
+    return @bitCast(F, @bitCast(U, k + splat(@as(i64, 0x3FF))) << splat(@as(u6, 52)));
+}
+
+/// Converts i64s of magnitude below 2^51 to f64, exactly.
+inline fn toFloat(k: I) F {
+    const magic = splat(@as(f64, 0x1.8p52));
+    return @bitCast(F, @bitCast(U, magic) +% @bitCast(U, k)) - magic;
+}
+
+/// Applies the scalar func to each element.
+inline fn scalarMap(comptime func: fn (f64) f64, x: F) F {
+    var y: [8]f64 = undefined;
+    comptime var j = 0;
+    inline while (j < 8) : (j += 1) {
+        y[j] = func(x[j]);
+    }
+    return y;
+}
+
+fn expScalar(x: f64) f64 {
+    return math.exp(x);
+}
+
+fn exp2Scalar(x: f64) f64 {
+    return math.exp2(x);
+}
+
+fn log2Scalar(x: f64) f64 {
+    return math.log2(x);
+}
+
+// 2^(i/16) as the sum of two doubles, hi + lo.
+const exp2_hi = [16]f64{
+    0x1.0000000000000p+0, 0x1.0b5586cf9890fp+0, 0x1.172b83c7d517bp+0, 0x1.2387a6e756238p+0,
+    0x1.306fe0a31b715p+0, 0x1.3dea64c123422p+0, 0x1.4bfdad5362a27p+0, 0x1.5ab07dd485429p+0,
+    0x1.6a09e667f3bcdp+0, 0x1.7a11473eb0187p+0, 0x1.8ace5422aa0dbp+0, 0x1.9c49182a3f090p+0,
+    0x1.ae89f995ad3adp+0, 0x1.c199bdd85529cp+0, 0x1.d5818dcfba487p+0, 0x1.ea4afa2a490dap+0,
+};
+const exp2_lo = [16]f64{
+    0,                      0x1.8a62e4adc610bp-54,  -0x1.19041b9d78a76p-55, 0x1.9b07eb6c70573p-54,
+    0x1.6f46ad23182e4p-55,  0x1.ada0911f09ebcp-55,  0x1.d4397afec42e2p-56,  0x1.6324c054647adp-54,
+    -0x1.bdd3413b26456p-54, -0x1.41577ee04992fp-55, 0x1.6e9f156864b27p-54,  0x1.c7c46b071f2bep-56,
+    0x1.7a1cd345dcc81p-54,  0x1.11065895048ddp-55,  0x1.2ed02d75b3707p-55,  -0x1.e9c23179c2893p-54,
+};
+
+/// Returns 2^(i/16) * (1 + p) * 2^k for m = 16 * k + i, from a polynomial p
+/// of the reduced argument.
+inline fn exp2Scale(m: U, p: F) F {
+    const t_hi = permute(exp2_hi, m);
+    const t_lo = permute(exp2_lo, m);
+    const y = t_hi + @mulAdd(F, t_hi, p, t_lo);
+    return y * pow2(@bitCast(I, m) >> splat(@as(u6, 4)));
+}
+
+/// Returns exp() of each element of x.
+pub fn expVector(x: F) F {
+    const shift = splat(@as(f64, 0x1.8p52));
+    const inv_ln2_16 = splat(@as(f64, 0x1.71547652b82fep+4));
+    // ln2 / 16 = ln2_16_hi + ln2_16_lo, with k * ln2_16_hi exact
+    const ln2_16_hi = splat(@as(f64, 0x1.62e42fefa0000p-5));
+    const ln2_16_lo = splat(@as(f64, 0x1.cf79abc9e3b3ap-44));
+    const C2 = splat(@as(f64, 0x1.0000000000001p-1));
+    const C3 = splat(@as(f64, 0x1.5555555555556p-3));
+    const C4 = splat(@as(f64, 0x1.55555554e93b7p-5));
+    const C5 = splat(@as(f64, 0x1.11111110e1059p-7));
+    const C6 = splat(@as(f64, 0x1.6c17ed5c1f49ep-10));
+    const C7 = splat(@as(f64, 0x1.a01b0c3c80bbcp-13));
+
+    // |x| < 0x1.6232bp+9 (708.3960), below 1022 * ln2 (708.3964), so the
+    // result is normal: the smallest m is 16 * -1022, for which r > 0 and
+    // y >= 1. Subnormal results, for x in (-745.14, -708.3964), go to the
+    // scalar function with the rest.
+    const hx = (@bitCast(U, x) >> splat(@as(u6, 32))) & splat(@as(u64, 0x7FFFFFFF));
+    if (@reduce(.Or, hx >= splat(@as(u64, 0x4086232B)))) {
+        return scalarMap(expScalar, x);
+    }
+
+    // x = m * ln2 / 16 + r, |r| <= ln2 / 32
+    const u = x * inv_ln2_16 + shift;
+    const md = u - shift;
+    const m = @bitCast(U, u) -% @bitCast(U, shift);
+    const r = (x - md * ln2_16_hi) - md * ln2_16_lo;
+
+    // p = r + r^2 * (C2 + r * C3 + r^2 * (C4 + r * C5) + r^4 * (C6 + r * C7))
+    const r2 = r * r;
+    const r4 = r2 * r2;
+    const q = @mulAdd(F, r4, @mulAdd(F, r, C7, C6), @mulAdd(F, r2, @mulAdd(F, r, C5, C4), @mulAdd(F, r, C3, C2)));
+    const p = @mulAdd(F, r2, q, r);
+
+    return exp2Scale(m, p);
+}
+
+/// Returns exp2() of each element of x.
+pub fn exp2Vector(x: F) F {
+    const shift = splat(@as(f64, 0x1.8p52 / 16.0));
+    const D1 = splat(@as(f64, 0x1.62e42fefa39efp-1));
+    const D2 = splat(@as(f64, 0x1.ebfbdff82c594p-3));
+    const D3 = splat(@as(f64, 0x1.c6b08d704a0c1p-5));
+    const D4 = splat(@as(f64, 0x1.3b2ab6fb09a33p-7));
+    const D5 = splat(@as(f64, 0x1.5d87fe7846c8fp-10));
+    const D6 = splat(@as(f64, 0x1.430a4970f3ce1p-13));
+    const D7 = splat(@as(f64, 0x1.ffcd7aed3c1cbp-17));
+
+    // |x| < 1022, so the result is normal
+    const hx = (@bitCast(U, x) >> splat(@as(u6, 32))) & splat(@as(u64, 0x7FFFFFFF));
+    if (@reduce(.Or, hx >= splat(@as(u64, 0x408FF000)))) {
+        return scalarMap(exp2Scalar, x);
+    }
+
+    // x = m / 16 + r, |r| <= 1/32, exactly
+    const u = x + shift;
+    const m = @bitCast(U, u) -% @bitCast(U, shift);
+    const r = x - (u - shift);
+
+    // p = r * (D1 + r * D2 + r^2 * (D3 + r * D4) + r^4 * (D5 + r * D6 + r^2 * D7))
+    const r2 = r * r;
+    const r4 = r2 * r2;
+    const q_hi = @mulAdd(F, r2, D7, @mulAdd(F, r, D6, D5));
+    const q = @mulAdd(F, r4, q_hi, @mulAdd(F, r2, @mulAdd(F, r, D4, D3), @mulAdd(F, r, D2, D1)));
+    const p = r * q;
+
+    return exp2Scale(m, p);
+}
+
+// For the 16 subintervals of z in [0x1.68p-1, 0x1.68p0), 1/c for c near the
+// middle, chosen so that log2(c) is within 0.001 ulp of a double, and log2(c).
+// 1 lies in the subinterval with c = 1, so log2() is exact for powers of two
+// and accurate for x near 1.
+const log2_invc = [16]f64{
+    0x1.642c8590b2210p+0, 0x1.5555555555c84p+0, 0x1.47ae147ae1e32p+0, 0x1.3b13b13b142f2p+0,
+    0x1.2f684bda13890p+0, 0x1.249249249199bp+0, 0x1.1a7b9611a7144p+0, 0x1.11111111106cap+0,
+    0x1.0842108420690p+0, 0x1.0000000000000p+0, 0x1.e1e1e1e1e16fcp-1, 0x1.c71c71c71c068p-1,
+    0x1.af286bca1b0efp-1, 0x1.9999999998e71p-1, 0x1.8618618618ce1p-1, 0x1.745d1745d1966p-1,
+};
+const log2_logc = [16]f64{
+    -0x1.e7df5fe538d7cp-2, -0x1.a8ff971812974p-2, -0x1.6cb0f6865f4b7p-2, -0x1.32bfee371134dp-2,
+    -0x1.f5fd8a906975cp-3, -0x1.8a8980abf4e74p-3, -0x1.22dadc2aac8a4p-3, -0x1.7d60496cedce3p-4,
+    -0x1.77394c9d79bacp-5, 0,                     0x1.663f6fac96a90p-4,  0x1.5c01a39fc020fp-3,
+    0x1.fbc16b9025bdfp-3,  0x1.49a784bcd43cap-2,  0x1.91bba891efd58p-2,  0x1.d6753e032e1a0p-2,
+};
+
+/// Returns log2() of each element of x.
+pub fn log2Vector(x: F) F {
+    const one = splat(@as(f64, 1));
+    const off = splat(@as(u64, 0x3FE6800000000000));
+    const invln2_hi = splat(@as(f64, 0x1.71547652b82fep+0));
+    const invln2_lo = splat(@as(f64, 0x1.777d0ffda0d24p-56));
+    const L0 = splat(@as(f64, -0x1.71547652b82fep-1));
+    const L1 = splat(@as(f64, 0x1.ec709dc3a03b2p-2));
+    const L2 = splat(@as(f64, -0x1.71547652b82b9p-2));
+    const L3 = splat(@as(f64, 0x1.2776c50ff62b9p-2));
+    const L4 = splat(@as(f64, -0x1.ec709dc56f07fp-3));
+    const L5 = splat(@as(f64, 0x1.a6174644a41cap-3));
+    const L6 = splat(@as(f64, -0x1.71545c4d2067dp-3));
+    const L7 = splat(@as(f64, 0x1.48e26281f95cap-3));
+    const L8 = splat(@as(f64, -0x1.280178681f157p-3));
+
+    // positive normal x, as in log2_64()
+    const ix = @bitCast(U, x);
+    const hx = ix >> splat(@as(u6, 32));
+    if (@reduce(.Or, hx -% splat(@as(u64, 0x00100000)) >= splat(@as(u64, 0x7FF00000 - 0x00100000)))) {
+        return scalarMap(log2Scalar, x);
+    }
+
+    // x = 2^k * z with z in [0x1.68p-1, 0x1.68p0), whose subinterval is
+    // given by the top 4 bits of the mantissa of tmp
+    const tmp = ix -% off;
+    const k = @bitCast(I, tmp) >> splat(@as(u6, 52));
+    const z = @bitCast(F, ix -% (tmp & splat(@as(u64, 0xFFF << 52))));
+    const i = tmp >> splat(@as(u6, 48));
+    const invc = permute(log2_invc, i);
+    const logc = permute(log2_logc, i);
+
+    // r + r_lo = z * invc - 1 exactly, |r| <= 1/32
+    const zc = z * invc;
+    const r_lo = @mulAdd(F, z, invc, -zc);
+    const r = zc - one;
+
+    // log2(1 + r) = (r + r_lo) / ln2 + r^2 * P(r), the first part as hi + lo
+    const hi = r * invln2_hi;
+    var lo = @mulAdd(F, r, invln2_hi, -hi) + @mulAdd(F, r, invln2_lo, r_lo * invln2_hi);
+
+    // k + log2(c) + hi, with the rounding errors added to lo
+    const kd = toFloat(k);
+    const t1 = kd + logc;
+    const t1_err = (kd - t1) + logc;
+    const t2 = t1 + hi;
+    lo = lo + t1_err + ((t1 - t2) + hi);
+
+    // P(r) = L0 + r * L1 + ... + r^8 * L8, by Estrin's scheme
+    const rr = r + r_lo;
+    const r2 = rr * rr;
+    const r4 = r2 * r2;
+    const r8 = r4 * r4;
+    const p01 = @mulAdd(F, rr, L1, L0);
+    const p23 = @mulAdd(F, rr, L3, L2);
+    const p45 = @mulAdd(F, rr, L5, L4);
+    const p67 = @mulAdd(F, rr, L7, L6);
+    const p03 = @mulAdd(F, r2, p23, p01);
+    const p47 = @mulAdd(F, r2, p67, p45);
+    const p = @mulAdd(F, r8, L8, @mulAdd(F, r4, p47, p03));
+
+    return @mulAdd(F, r2, p, lo) + t2;
+}
+
+/// Returns the error of y in ulps, relative to the more precise ref.
+fn ulpError(y: f64, ref: f128) f128 {
+    const fr = math.frexp(@floatCast(f64, ref));
+    const ulp = math.scalbn(@as(f128, 1), fr.exponent - 53);
+    return math.fabs(@as(f128, y) - ref) / ulp;
+}
+
+test "math.avx512 max ulp" {
+    // Only where the kernels are selected, which is also where the fused
+    // multiply-adds are fast.
+    if (simd.detect() != .avx512) {
+        return error.SkipZigTest;
+    }
+    var prng = std.rand.DefaultPrng.init(0x9E3779B97F4A7C15);
+    const random = prng.random();
+    var i: u32 = 0;
+    while (i < 2000) : (i += 1) {
+        var xs: [8]f64 = undefined;
+        var ys: [8]f64 = undefined;
+        var zs: [8]f64 = undefined;
+        for (xs) |*x, j| {
+            x.* = random.float(f64) * 1400 - 700;
+            ys[j] = random.float(f64) * 2040 - 1020;
+            zs[j] = math.scalbn(random.float(f64) + 0.5, random.intRangeAtMost(i32, -1000, 1000));
+        }
+        // near 1 and near 0, where the results of log2 and exp2 are small
+        zs[0] = 1 + (random.float(f64) - 0.5) * 0x1p-10;
+        ys[0] = (random.float(f64) - 0.5) * 0x1p-20;
+
+        const exp_y: [8]f64 = expVector(xs);
+        const exp2_y: [8]f64 = exp2Vector(ys);
+        const log2_y: [8]f64 = log2Vector(zs);
+        for (xs) |x, j| {
+            try expect(ulpError(exp_y[j], math.exp(@as(f128, x))) <= 0.55);
+            try expect(ulpError(exp2_y[j], math.exp2(@as(f128, ys[j]))) <= 0.56);
+            try expect(ulpError(log2_y[j], math.log2(@as(f128, zs[j]))) <= 0.53);
+        }
+    }
+}
+
+test "math.avx512 exact" {
+    if (simd.detect() != .avx512) {
+        return error.SkipZigTest;
+    }
+    const k = F{ -1000, -3, -1, 0, 1, 2, 52, 1000 };
+    const p = exp2Vector(k);
+    const l = log2Vector(p);
+    comptime var j = 0;
+    inline while (j < 8) : (j += 1) {
+        try expect(p[j] == math.scalbn(@as(f64, 1), @floatToInt(i32, k[j])));
+        try expect(l[j] == k[j]);
+    }
+    try expect(@reduce(.And, expVector(@splat(8, @as(f64, 0))) == @splat(8, @as(f64, 1))));
+}
+
+test "math.avx512 exp subnormal gate" {
+    if (simd.detect() != .avx512) {
+        return error.SkipZigTest;
+    }
+    // the last vector input, and inputs around -1022 * ln2 on the scalar path
+    const x = F{ -0x1.6232affffffffp+9, -0x1.6232bp+9, -708.3963, -708.3964, -708.3965, -708.397, -708.3984, -708.4 };
+    const e: [8]f64 = expVector(x);
+    try expect(e[0] >= 0x1p-1022);
+    for (@as([8]f64, x)[1..]) |xj, j| {
+        try expect(@bitCast(u64, e[j + 1]) == @bitCast(u64, math.exp(xj)));
+    }
+}
+
+test "math.avx512 scalar fallback" {
+    if (simd.detect() != .avx512) {
+        return error.SkipZigTest;
+    }
+    const inf = math.inf(f64);
+    const x = F{ 0.5, -inf, inf, 800, -800, 0x1p-1070, -1, 0 };
+    const e: [8]f64 = expVector(x);
+    const l: [8]f64 = log2Vector(x);
+    for (@as([8]f64, x)) |xj, j| {
+        try expect(@bitCast(u64, e[j]) == @bitCast(u64, math.exp(xj)));
+        try expect(@bitCast(u64, l[j]) == @bitCast(u64, math.log2(xj)) or math.isNan(l[j]));
+    }
+}
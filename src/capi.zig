@@ -0,0 +1,26 @@
+// C ABI exports of the f128 kernels, as drop-in replacements for the
+// libquadmath functions of the same names. This is the root of libf128math,
+// built with 'zig build lib', and include/f128math.h declares the exports.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+
+export fn expq(x: f128) f128 {
+    return math.exp(x);
+}
+
+export fn exp2q(x: f128) f128 {
+    return math.exp2(x);
+}
+
+export fn log2q(x: f128) f128 {
+    return math.log2(x);
+}
+
+test "math.capi exports" {
+    const expect = std.testing.expect;
+    try expect(expq(1.5) == math.exp(@as(f128, 1.5)));
+    try expect(exp2q(-3) == 0.125);
+    try expect(log2q(1024) == 10);
+}
@@ -0,0 +1,229 @@
+// Optional per-branch hit counters for the exp, exp2 and log2 kernels.
+//
+// Each kernel counts which of its paths (the fast path, tiny arguments,
+// overflow, underflow, subnormal scaling, ...) its arguments take, to show
+// where real inputs go and which paths are worth specializing. Counting is
+// enabled by declaring
+//
+//     pub const f128math_branch_counters = true;
+//
+// in the root source file. The benchmarks built by build.zig take this from
+// the 'branch-counters' build option. When disabled, bump() is empty and the
+// kernels compile as if it wasn't there.
+//
+// Code compiled into a separate object, such as the AVX2 and AVX-512
+// kernels of simd.zig (see simd_export.zig), would count into its own copy of
+// the counters, which the program's snapshot() doesn't see. Its root declares
+//
+//     pub const f128math_branch_counters_forward = true;
+//
+// so that it passes its counts to the program's record() instead, which the
+// program exports as f128math_counters_record.
+//
+// The counters are per thread so that counting doesn't contend. A thread's
+// first count allocates its block of counters, which is pushed onto a global
+// lock-free list and never freed, so the counts of threads that have exited
+// are kept. snapshot() and dump() sum over all the blocks.
+
+const std = @import("std");
+const root = @import("root");
+const expect = std.testing.expect;
+
+/// Whether the kernels count their branches. This is comptime known, so
+/// bump() compiles to nothing when it's false.
+pub const enabled: bool = if (@hasDecl(root, "f128math_branch_counters"))
+    root.f128math_branch_counters
+else
+    false;
+
+/// Whether the counts go to the program this is linked into.
+const forward: bool = if (@hasDecl(root, "f128math_branch_counters_forward"))
+    root.f128math_branch_counters_forward
+else
+    false;
+
+/// The program's recordC(), for forwarded counts.
+extern fn f128math_counters_record(kernel: u32, branch: u32) void;
+
+/// The instrumented kernels.
+pub const Kernel = enum {
+    exp32,
+    exp64,
+    exp80,
+    exp128,
+    exp2_32,
+    exp2_64,
+    exp2_80,
+    exp2_128,
+    exp2_128_fixed,
+    log2_32,
+    log2_64,
+    log2_80,
+    log2_128,
+};
+
+/// The paths through a kernel.
+pub const Branch = enum {
+    /// The fast path, for arguments that pass the range check.
+    normal,
+    /// exp2 of an integer, built from the exponent bits.
+    integer,
+    /// |x| small enough that the result is 1 + x.
+    tiny,
+    /// Out of line, but then evaluated by the fast path body, e.g. for
+    /// subnormal results.
+    edge,
+    /// The result overflows, including x = +inf.
+    overflow,
+    /// The result underflows to 0, including x = -inf.
+    underflow,
+    /// log2 of a subnormal, scaled into the normal range.
+    subnormal,
+    /// nan, and for log2 also zero, negative and infinite arguments.
+    special,
+};
+
+const n_kernels = @typeInfo(Kernel).Enum.fields.len;
+const n_branches = @typeInfo(Branch).Enum.fields.len;
+const Hits = [n_kernels][n_branches]u64;
+const zero_hits = [_][n_branches]u64{[_]u64{0} ** n_branches} ** n_kernels;
+
+/// Hit counts for every kernel and branch.
+pub const Counts = struct {
+    hits: Hits = zero_hits,
+
+    pub fn get(self: Counts, kernel: Kernel, branch: Branch) u64 {
+        return self.hits[@enumToInt(kernel)][@enumToInt(branch)];
+    }
+};
+
+const Block = struct {
+    hits: Hits = zero_hits,
+    next: ?*Block = null,
+};
+
+var blocks: ?*Block = null;
+// For threads whose block couldn't be allocated, counted with atomic adds.
+var shared_block = Block{};
+threadlocal var local_block: ?*Block = null;
+
+/// Counts a hit of the branch in the kernel, if enabled.
+pub inline fn bump(comptime kernel: Kernel, comptime branch: Branch) void {
+    if (enabled) {
+        record(kernel, branch);
+    }
+}
+
+fn record(kernel: Kernel, branch: Branch) void {
+    if (forward) {
+        return f128math_counters_record(@enumToInt(kernel), @enumToInt(branch));
+    }
+    const k = @enumToInt(kernel);
+    const br = @enumToInt(branch);
+    const block = local_block orelse register() orelse {
+        _ = @atomicRmw(u64, &shared_block.hits[k][br], .Add, 1, .Monotonic);
+        return;
+    };
+    // Only this thread writes to its block, so there's no need for an atomic
+    // add, only for atomic accesses that snapshot() can read concurrently.
+    const p = &block.hits[k][br];
+    @atomicStore(u64, p, @atomicLoad(u64, p, .Monotonic) + 1, .Monotonic);
+}
+
+/// record() with the C calling convention, which a program linking objects
+/// that forward their counts exports as f128math_counters_record.
+pub fn recordC(kernel: u32, branch: u32) callconv(.C) void {
+    record(@intToEnum(Kernel, kernel), @intToEnum(Branch, branch));
+}
+
+fn register() ?*Block {
+    @setCold(true);
+
+    const block = std.heap.page_allocator.create(Block) catch return null;
+    block.* = .{};
+    var head = @atomicLoad(?*Block, &blocks, .Acquire);
+    while (true) {
+        block.next = head;
+        head = @cmpxchgWeak(?*Block, &blocks, head, block, .Release, .Acquire) orelse break;
+    }
+    local_block = block;
+    return block;
+}
+
+fn addBlock(counts: *Counts, block: *const Block) void {
+    for (counts.hits) |*row, k| {
+        for (row) |*n, br| {
+            n.* += @atomicLoad(u64, &block.hits[k][br], .Monotonic);
+        }
+    }
+}
+
+/// Returns the counts summed over all threads. Counts made concurrently may
+/// or may not be included.
+pub fn snapshot() Counts {
+    var counts = Counts{};
+    addBlock(&counts, &shared_block);
+    var it = @atomicLoad(?*Block, &blocks, .Acquire);
+    while (it) |block| : (it = block.next) {
+        addBlock(&counts, block);
+    }
+    return counts;
+}
+
+/// Sets all counts to zero. Counts made concurrently may survive the reset.
+pub fn reset() void {
+    resetBlock(&shared_block);
+    var it = @atomicLoad(?*Block, &blocks, .Acquire);
+    while (it) |block| : (it = block.next) {
+        resetBlock(block);
+    }
+}
+
+fn resetBlock(block: *Block) void {
+    for (block.hits) |*row| {
+        for (row) |*n| {
+            @atomicStore(u64, n, 0, .Monotonic);
+        }
+    }
+}
+
+/// Writes the non-zero counts of snapshot() to writer, one kernel per
+/// paragraph, with each branch as a percentage of the kernel's calls.
+pub fn dump(writer: anytype) !void {
+    const counts = snapshot();
+    inline for (@typeInfo(Kernel).Enum.fields) |kernel, k| {
+        const row = counts.hits[k];
+        var total: u64 = 0;
+        for (row) |n| {
+            total += n;
+        }
+        if (total != 0) {
+            try writer.print("{s}: {d} calls\n", .{ kernel.name, total });
+            inline for (@typeInfo(Branch).Enum.fields) |branch, br| {
+                if (row[br] != 0) {
+                    const pct = @intToFloat(f64, row[br]) * 100 / @intToFloat(f64, total);
+                    try writer.print("  {s: <10} {d: >12} {d: >6.2}%\n", .{ branch.name, row[br], pct });
+                }
+            }
+        }
+    }
+}
+
+test "math.counters record" {
+    reset();
+    record(.exp2_64, .normal);
+    record(.exp2_64, .normal);
+    record(.log2_32, .subnormal);
+    const counts = snapshot();
+    try expect(counts.get(.exp2_64, .normal) == 2);
+    try expect(counts.get(.log2_32, .subnormal) == 1);
+    try expect(counts.get(.exp32, .normal) == 0);
+
+    var buf: [256]u8 = undefined;
+    var stream = std.io.fixedBufferStream(&buf);
+    try dump(stream.writer());
+    try expect(std.mem.indexOf(u8, stream.getWritten(), "exp2_64: 2 calls") != null);
+
+    reset();
+    try expect(snapshot().get(.exp2_64, .normal) == 0);
+}
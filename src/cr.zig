@@ -0,0 +1,404 @@
+// Correctly rounded variants.
+//
+// f32 results are computed with f64 kernels, whose error is a small fraction
+// of an f64 ulp, and then rounded. That is only wrong when the exact result
+// is within the kernel error of a point half way between two f32, which was
+// checked exhaustively: every f32 argument whose f64 result is within 16 f64
+// ulps of such a point (or whose result is subnormal) was compared against
+// libquadmath, and those that round the wrong way are listed in an exception
+// table. Sampling every 4096th argument shows a kernel error of at most 1.6
+// f64 ulps. Only results near a half way point look at the table, so it costs
+// a mask and a compare on the common path. For a subnormal f32 result the
+// half way points are further up in the f64, which is still normal, so the
+// mask depends on its exponent. 'zig build exhaustive-cr' checks all 2^32
+// arguments of each function against the f128 kernels.
+//
+// f64 uses Ziv's strategy. The default kernel is evaluated as an unevaluated
+// sum hi + lo together with a bound on its error. If both ends of the error
+// interval round to the same float then so does the exact result, and that is
+// returned. Otherwise the result is too close to a rounding boundary to
+// decide, and it's evaluated again with the (much slower) f128 kernel. That
+// step doesn't round the f128 sum, which could round twice: it checks that
+// the exact result is further than the f128 kernel error from the points
+// half way between the f64 neighbours of the rounded sum. The error bounds of
+// both steps are derived by misc/directed_bounds.py.
+//
+// The f64 fast path fails for roughly 1% of random arguments, so the average
+// cost stays close to that of the default kernel. The number of fallbacks is
+// counted, see fallbackCount(). An argument that the f128 step can't decide
+// either would need a result within 2^-117 of a half way point. None is
+// known, but such arguments are counted too, see unresolvedCount(), and get
+// the f128 sum rounded.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const exp2_mod = @import("exp2.zig");
+const fast = @import("fast.zig");
+
+/// Number of calls that needed the slow path, across all threads.
+var fallback_count = std.atomic.Atomic(u64).init(0);
+
+/// Returns the number of calls that have fallen back to the slow path since
+/// the start of the program or the last resetFallbackCount().
+pub fn fallbackCount() u64 {
+    return fallback_count.load(.Monotonic);
+}
+
+/// Resets the counters returned by fallbackCount() and unresolvedCount() to
+/// zero.
+pub fn resetFallbackCount() void {
+    fallback_count.store(0, .Monotonic);
+    unresolved_count.store(0, .Monotonic);
+}
+
+/// Number of slow path calls whose rounding the f128 kernel didn't decide,
+/// across all threads.
+var unresolved_count = std.atomic.Atomic(u64).init(0);
+
+/// Returns the number of calls since the start of the program or the last
+/// resetFallbackCount() that may not be correctly rounded.
+pub fn unresolvedCount() u64 {
+    return unresolved_count.load(.Monotonic);
+}
+
+/// Returns e raised to the power of x (e^x), correctly rounded to nearest.
+///
+/// Special Cases:
+///  - exp(+inf) = +inf
+///  - exp(-inf) = 0
+///  - exp(nan)  = nan
+pub fn exp(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => exp32(x),
+        else => @compileError("cr.exp not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns 2 raised to the power of x (2^x), correctly rounded to nearest.
+///
+/// Special Cases:
+///  - exp2(+inf) = +inf
+///  - exp2(-inf) = 0
+///  - exp2(nan)  = nan
+pub fn exp2(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => exp2_32(x),
+        f64 => exp2_64(x),
+        else => @compileError("cr.exp2 not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the base-2 logarithm of x, correctly rounded to nearest.
+///
+/// Special Cases:
+///  - log2(+inf)  = +inf
+///  - log2(0)     = -inf
+///  - log2(x)     = nan if x < 0
+///  - log2(nan)   = nan
+pub fn log2(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => log2_32(x),
+        else => @compileError("cr.log2 not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// An f32 argument and its correctly rounded result, as bits.
+const Exception32 = struct {
+    x: u32,
+    y: u32,
+};
+
+// Arguments for which the rounded f64 kernel result is wrong. The exhaustive
+// search found none for exp32() and log2_32().
+const exp32_exceptions = [_]Exception32{};
+const exp2_32_exceptions = [_]Exception32{
+    .{ .x = 0x3B429D37, .y = 0x3F804385 },
+    .{ .x = 0xBCF3A937, .y = 0x3F7AC6B1 },
+};
+const log2_32_exceptions = [_]Exception32{};
+
+/// Rounds the f64 kernel result r for argument x to f32, using the exception
+/// table for arguments where that rounds the wrong way.
+inline fn roundToF32(x: f32, r: f64, comptime exceptions: []const Exception32) f32 {
+    // The table only holds arguments whose result is within this many f64
+    // ulps of a point half way between two f32.
+    const tol = 16;
+
+    // The number of bits of the f64 significand below the last bit of the
+    // f32: 29 for a normal f32, and up to 53 for a subnormal one, when r is
+    // below 2^-126. r is positive and at least 2^-150.
+    const ur = @bitCast(u64, r);
+    const biased = ur >> 52;
+    const drop = @intCast(u6, if (biased >= 0x381) 29 else 29 + 0x381 - biased);
+
+    // Half way between two f32 the low bits are 1 followed by zeros.
+    const half = @as(u64, 1) << (drop - 1);
+    const low = ((ur & 0x000FFFFFFFFFFFFF) | 0x0010000000000000) & ((half << 1) - 1);
+    if (low -% (half - tol) < 2 * tol) {
+        const ux = @bitCast(u32, x);
+        inline for (exceptions) |e| {
+            if (ux == e.x) {
+                return @bitCast(f32, e.y);
+            }
+        }
+    }
+    return @floatCast(f32, r);
+}
+
+/// Returns 2^k for the range of k needed by the f32 functions.
+inline fn pow2(k: i32) f64 {
+    return @bitCast(f64, @intCast(u64, 0x3FF + k) << 52);
+}
+
+fn exp32(x: f32) f32 {
+    const tblsiz = @intCast(u32, exp2_mod.exp2_64_tblsiz);
+    const shift: f64 = 0x1.8p52;
+    const inv_ln2_n: f64 = 0x1.71547652b82fep+8; // N / ln(2)
+    const ln2_n_hi: f64 = 0x1.62e42fefa0000p-9; // ln(2) / N
+    const ln2_n_lo: f64 = 0x1.cf79abc9e3b3ap-48;
+    const log2e: f64 = 0x1.71547652b82fep+0;
+
+    // x >= 88.72284 (overflow), x <= -103.97208 (rounds to 0) or nan
+    if (!(x < 0x1.62e43p+6 and x > -0x1.9fe36ap+6)) {
+        return math.exp(x);
+    }
+
+    // Reduce as in exp10_64(), x = n * ln(2)/N + r, and use the exp2 kernel
+    // on r * log2(e). kd * ln2_n_hi is exact.
+    const xd: f64 = x;
+    var kd: f64 = xd * inv_ln2_n + shift;
+    const n = @bitCast(i32, @truncate(u32, @bitCast(u64, kd)));
+    kd -= shift;
+    const r: f64 = xd - kd * ln2_n_hi - kd * ln2_n_lo;
+    const z: f64 = r * log2e;
+
+    const m = n + @intCast(i32, tblsiz / 2);
+    const i_0 = @intCast(u32, m & @intCast(i32, tblsiz - 1));
+    const k = @divFloor(m, @intCast(i32, tblsiz));
+    const y = exp2_mod.exp2_64Kernel(i_0, z) * pow2(k);
+    return roundToF32(x, y, &exp32_exceptions);
+}
+
+fn exp2_32(x: f32) f32 {
+    // x >= 128 (overflow), x <= -150 (rounds to 0) or nan
+    if (!(x < 128 and x > -150)) {
+        return math.exp2(x);
+    }
+
+    const red = exp2_mod.exp2_64Reduce(x);
+    const y = exp2_mod.exp2_64Kernel(red.i, red.z) * pow2(red.k);
+    return roundToF32(x, y, &exp2_32_exceptions);
+}
+
+fn log2_32(x: f32) f32 {
+    // log2(1 + r) / r, Taylor series
+    const L1: f64 = 0x1.71547652b82fep+0;
+    const L2: f64 = -0x1.71547652b82fep-1;
+    const L3: f64 = 0x1.ec709dc3a03fdp-2;
+    const L4: f64 = -0x1.71547652b82fep-2;
+    const L5: f64 = 0x1.2776c50ef9bfep-2;
+    const L6: f64 = -0x1.ec709dc3a03fdp-3;
+    const L7: f64 = 0x1.a61762a7aded9p-3;
+
+    var ix = @bitCast(u32, x);
+    var k: i32 = 0;
+
+    // x is zero, negative, inf or nan
+    if (ix -% 1 >= 0x7F800000 - 1) {
+        return math.log2(x);
+    }
+    // subnormal, scale x
+    if (ix < 0x00800000) {
+        ix = @bitCast(u32, x * 0x1p23);
+        k = -23;
+    }
+
+    // x into [sqrt(2) / 2, sqrt(2)], as in log2_32()
+    ix += 0x3F800000 - 0x3F3504F3;
+    k += @intCast(i32, ix >> 23) - 0x7F;
+    ix = (ix & 0x007FFFFF) + 0x3F3504F3;
+    const f = @as(f64, @bitCast(f32, ix)) - 1.0;
+
+    // f is exact, so r is within an f64 ulp of (1 + f) / c - 1.
+    const red = fast.log2Reduce(f);
+    const r = red.r;
+
+    const r2 = r * r;
+    const p = r * L1 + r2 * (L2 + r * L3) + r2 * r2 * ((L4 + r * L5) + r2 * (L6 + r * L7));
+    const y = (@intToFloat(f64, k) + red.log2c) + p;
+    return roundToF32(x, y, &log2_32_exceptions);
+}
+
+fn exp2_64(x: f64) f64 {
+    // Relative error bound of exp2_64KernelParts(), which is below 2^-60.31.
+    // The rest is room for the rounding of p.lo +- e, see
+    // misc/directed_bounds.py.
+    const err_bound: f64 = 0x1p-60;
+
+    const ux = @bitCast(u64, x);
+    const ix = @intCast(u32, ux >> 32) & 0x7FFFFFFF;
+
+    // |x| >= 1021 or nan
+    if (ix >= 0x408FE800) {
+        // x >= 1024, x <= -1075 or nan: these are exact (inf, 0 or nan), so
+        // leave them and their exceptions to the default kernel.
+        if (!(x < 1024 and x > -1075)) {
+            return math.exp2(x);
+        }
+        // x <= -1021: the result may be subnormal, where the rounding
+        // position depends on the exponent, so go straight to the slow path.
+        if (x <= -1021) {
+            return exp2_64Slow(x);
+        }
+    }
+
+    const red = exp2_mod.exp2_64Reduce(x);
+    const p = exp2_mod.exp2_64KernelParts(red.i, red.z);
+    // Rounding is monotonic, so if both ends of the interval round to r
+    // then so does the exact result.
+    const e = p.hi * err_bound;
+    const r = p.hi + p.lo;
+    if (r == p.hi + (p.lo + e) and r == p.hi + (p.lo - e)) {
+        // The result is normal, so the scaling is exact.
+        return math.scalbn(r, red.k);
+    }
+
+    _ = fallback_count.fetchAdd(1, .Monotonic);
+    return exp2_64Slow(x);
+}
+
+/// exp2_64() for finite x in (-1075, 1024), evaluated with the f128 kernel.
+fn exp2_64Slow(x: f64) f64 {
+    // Relative error bound of exp2_128KernelParts(), which is below
+    // 2^-119.42.
+    const err_bound: f128 = 0x1p-118;
+
+    const red = exp2_mod.exp2_128Reduce(x);
+    const p = exp2_mod.exp2_128KernelParts(red.i, red.z);
+    // Scale before rounding, so that a subnormal result is rounded at the
+    // right place. This is exact for f128.
+    const hi = math.scalbn(p.hi, red.k);
+    const lo = math.scalbn(p.lo, red.k);
+    const y = @floatCast(f64, hi + lo);
+
+    // The points half way between y and its neighbours, exact in f128. The
+    // exact result is in (2^-1075, f64_max), so y is at least 2^-1074, and
+    // the neighbour above f64_max is inf.
+    const uy = @bitCast(u64, y);
+    const below = (@as(f128, y) + @bitCast(f64, uy - 1)) / 2;
+    const above = (@as(f128, y) + @bitCast(f64, uy + 1)) / 2;
+
+    // hi - below and hi - above are exact, as both are within an f64 ulp of
+    // hi, so the sums are within an f128 ulp of the exact differences, and
+    // twice the error bound covers that.
+    const e = 2 * err_bound * hi;
+    if (!((hi - below) + lo > e and (hi - above) + lo < -e)) {
+        _ = unresolved_count.fetchAdd(1, .Monotonic);
+    }
+    return y;
+}
+
+test "math.cr f32 exceptions" {
+    for (exp2_32_exceptions) |e| {
+        const x = @bitCast(f32, e.x);
+        try expect(exp2(x) == @floatCast(f32, math.exp2(@as(f128, x))));
+    }
+}
+
+test "math.cr f32 subnormal exceptions" {
+    // Just below half way between the two smallest subnormals, which rounds
+    // to 0x1p-149 unless the table says otherwise.
+    const r: f64 = 0x1.7ffffffffffffp-149;
+    const table = [_]Exception32{.{ .x = 0x3F800000, .y = 0x00000002 }};
+    try expect(roundToF32(1.0, r, &table) == 0x1p-148);
+    try expect(roundToF32(2.0, r, &table) == 0x1p-149);
+}
+
+test "math.cr f32 rounding" {
+    // Compare against the f128 results rounded to f32.
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+    var i: u32 = 0;
+    while (i < 20000) : (i += 1) {
+        const x_exp = @floatCast(f32, random.float(f64) * 190 - 103);
+        try expect(exp(x_exp) == @floatCast(f32, math.exp(@as(f128, x_exp))));
+        const x_exp2 = @floatCast(f32, random.float(f64) * 276 - 149);
+        try expect(exp2(x_exp2) == @floatCast(f32, math.exp2(@as(f128, x_exp2))));
+        const x_log2 = @bitCast(f32, random.intRangeLessThan(u32, 1, 0x7F800000));
+        try expect(log2(x_log2) == @floatCast(f32, math.log2(@as(f128, x_log2))));
+    }
+}
+
+test "math.cr.exp() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp(@as(f32, 0.0)) == 1.0);
+    try expect(math.approxEqAbs(f32, exp(@as(f32, 0.2)), 1.221403, epsilon));
+    try expect(math.approxEqAbs(f32, exp(@as(f32, 0.8923)), 2.440737, epsilon));
+    try expect(math.approxEqAbs(f32, exp(@as(f32, -1.5)), 0.223130, epsilon));
+}
+
+test "math.cr.log2() basic" {
+    const epsilon = 0.000001;
+
+    try expect(log2(@as(f32, 1.0)) == 0.0);
+    try expect(log2(@as(f32, 0x1p-149)) == -149.0);
+    try expect(math.approxEqAbs(f32, log2(@as(f32, 0.2)), -2.321928, epsilon));
+    try expect(math.approxEqAbs(f32, log2(@as(f32, 37.45)), 5.226894, epsilon));
+}
+
+test "math.cr.exp2() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp2(@as(f32, 0.0)) == 1.0);
+    try expect(exp2(@as(f32, -149.0)) == 0x1p-149);
+    try expect(math.approxEqAbs(f32, exp2(@as(f32, 0.2)), 1.148698, epsilon));
+    try expect(exp2(@as(f64, 0.0)) == 1.0);
+    try expect(exp2(@as(f64, 10.0)) == 1024.0);
+    try expect(exp2(@as(f64, -1074.0)) == 0x1p-1074);
+    try expect(math.approxEqAbs(f64, exp2(@as(f64, 0.2)), 1.148698, epsilon));
+    try expect(math.approxEqAbs(f64, exp2(@as(f64, 0.8923)), 1.856133, epsilon));
+    try expect(math.approxEqAbs(f64, exp2(@as(f64, 1.5)), 2.828427, epsilon));
+}
+
+test "math.cr.exp2() rounding" {
+    // Compare against the f128 result rounded to f64, over the whole range
+    // including subnormal results.
+    resetFallbackCount();
+    const n = 20000;
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+    var i: u32 = 0;
+    while (i < n) : (i += 1) {
+        const x = random.float(f64) * 2098 - 1074.5;
+        try expect(exp2(x) == @floatCast(f64, math.exp2(@as(f128, x))));
+    }
+    // The fast path should cover all but a few percent of arguments.
+    try expect(fallbackCount() < n / 20);
+    try expect(unresolvedCount() == 0);
+}
+
+test "math.cr.special" {
+    try expect(math.isPositiveInf(exp(math.inf(f32))));
+    try expect(exp(-math.inf(f32)) == 0);
+    try expect(math.isNan(exp(math.nan(f32))));
+    try expect(math.isPositiveInf(exp2(math.inf(f32))));
+    try expect(exp2(@as(f32, -150)) == 0);
+    try expect(math.isNan(exp2(math.nan(f32))));
+    try expect(math.isNegativeInf(log2(@as(f32, 0.0))));
+    try expect(math.isNan(log2(@as(f32, -1.0))));
+    try expect(math.isPositiveInf(log2(math.inf(f32))));
+    try expect(math.isNan(log2(math.nan(f32))));
+    try expect(math.isPositiveInf(exp2(math.inf(f64))));
+    try expect(exp2(-math.inf(f64)) == 0);
+    try expect(math.isNan(exp2(math.nan(f64))));
+    try expect(math.isPositiveInf(exp2(@as(f64, 1024))));
+    try expect(exp2(@as(f64, -1075)) == 0);
+    try expect(exp2(@as(f64, 0x1p-60)) == 1);
+}
@@ -0,0 +1,517 @@
+// Directed rounding variants of exp, exp2 and log2, for interval arithmetic.
+//
+// The kernels return an unevaluated sum hi + lo together with a bound on its
+// error. With s = hi + lo rounded to nearest, the exact result lies within the
+// bound of s + t, where t = (hi - s) + lo, so comparing t against the bound
+// decides whether the exact result is above or below s. Both bounds come out
+// of a single kernel evaluation, and are one ulp apart except when the exact
+// result is too close to s to tell, where both neighbours of s are used. That
+// happens for about 5% of random arguments.
+//
+// The error bounds, relative to hi, are derived step by step by
+// misc/directed_bounds.py from the reduction, the table entries, the
+// polynomial approximation error and the rounding of every operation, over
+// the whole argument range and with or without fused multiply-adds (see
+// muladd.zig):
+//
+//   function | derived  | err_bound | largest error seen
+//   ---------|----------|-----------|-------------------
+//   exp      | 2^-59.77 | 2^-58     | 2^-60.6
+//   exp2     | 2^-60.31 | 2^-59     | 2^-61
+//   log2     | 2^-59.08 | 2^-58     | 2^-60
+//
+// The script reads the tables from the sources and fails if a bound no
+// longer holds, so it has to be rerun when a kernel changes. t is exact
+// (hi + lo is summed with Fast2Sum), so comparing it with the bound adds no
+// error of its own.
+//
+// Results below 2^-1021, which may be subnormal, are evaluated with the same
+// kernels and rounded the same way to multiples of 2^-1074. f32 bounds are
+// the f64 bounds rounded outwards to f32, which keeps them tight as the f32
+// values are a subset of the f64 values.
+//
+// An inverted interval (lo > hi) is rejected with nan bounds and an invalid
+// exception.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const exp2_mod = @import("exp2.zig");
+const fast = @import("fast.zig");
+
+/// A closed interval [lo, hi].
+pub fn Interval(comptime T: type) type {
+    return struct {
+        lo: T,
+        hi: T,
+    };
+}
+
+/// Returns the largest float not greater than e^x.
+pub fn expDown(x: anytype) @TypeOf(x) {
+    return expBounds(x).lo;
+}
+
+/// Returns the smallest float not less than e^x.
+pub fn expUp(x: anytype) @TypeOf(x) {
+    return expBounds(x).hi;
+}
+
+/// Returns an interval containing e^x for all x in [lo, hi]. A point interval
+/// (lo == hi) takes a single kernel evaluation, and lo > hi gives nan bounds.
+pub fn expInterval(lo: anytype, hi: @TypeOf(lo)) Interval(@TypeOf(lo)) {
+    if (lo > hi) {
+        return inverted(@TypeOf(lo));
+    }
+    if (lo == hi) {
+        return expBounds(lo);
+    }
+    return .{ .lo = expBounds(lo).lo, .hi = expBounds(hi).hi };
+}
+
+/// Returns the largest float not greater than 2^x.
+pub fn exp2Down(x: anytype) @TypeOf(x) {
+    return exp2Bounds(x).lo;
+}
+
+/// Returns the smallest float not less than 2^x.
+pub fn exp2Up(x: anytype) @TypeOf(x) {
+    return exp2Bounds(x).hi;
+}
+
+/// Returns an interval containing 2^x for all x in [lo, hi]. A point interval
+/// (lo == hi) takes a single kernel evaluation, and lo > hi gives nan bounds.
+pub fn exp2Interval(lo: anytype, hi: @TypeOf(lo)) Interval(@TypeOf(lo)) {
+    if (lo > hi) {
+        return inverted(@TypeOf(lo));
+    }
+    if (lo == hi) {
+        return exp2Bounds(lo);
+    }
+    return .{ .lo = exp2Bounds(lo).lo, .hi = exp2Bounds(hi).hi };
+}
+
+/// Returns the largest float not greater than log2(x).
+pub fn log2Down(x: anytype) @TypeOf(x) {
+    return log2Bounds(x).lo;
+}
+
+/// Returns the smallest float not less than log2(x).
+pub fn log2Up(x: anytype) @TypeOf(x) {
+    return log2Bounds(x).hi;
+}
+
+/// Returns an interval containing log2(x) for all x in [lo, hi]. A point
+/// interval (lo == hi) takes a single kernel evaluation, and lo > hi gives
+/// nan bounds.
+pub fn log2Interval(lo: anytype, hi: @TypeOf(lo)) Interval(@TypeOf(lo)) {
+    if (lo > hi) {
+        return inverted(@TypeOf(lo));
+    }
+    if (lo == hi) {
+        return log2Bounds(lo);
+    }
+    return .{ .lo = log2Bounds(lo).lo, .hi = log2Bounds(hi).hi };
+}
+
+fn expBounds(x: anytype) Interval(@TypeOf(x)) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => narrow(f32, exp64Bounds(x)),
+        f64 => exp64Bounds(x),
+        else => @compileError("expBounds not implemented for " ++ @typeName(T)),
+    };
+}
+
+fn exp2Bounds(x: anytype) Interval(@TypeOf(x)) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => narrow(f32, exp2_64Bounds(x)),
+        f64 => exp2_64Bounds(x),
+        else => @compileError("exp2Bounds not implemented for " ++ @typeName(T)),
+    };
+}
+
+fn log2Bounds(x: anytype) Interval(@TypeOf(x)) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => narrow(f32, log2_64Bounds(x)),
+        f64 => log2_64Bounds(x),
+        else => @compileError("log2Bounds not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the next float above x.
+fn nextUp(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    const U = std.meta.Int(.unsigned, @typeInfo(T).Float.bits);
+    if (math.isNan(x) or math.isPositiveInf(x)) {
+        return x;
+    }
+    if (x == 0) {
+        return @bitCast(T, @as(U, 1));
+    }
+    const u = @bitCast(U, x);
+    return @bitCast(T, if (x > 0) u + 1 else u - 1);
+}
+
+/// Returns the next float below x.
+fn nextDown(x: anytype) @TypeOf(x) {
+    return -nextUp(-x);
+}
+
+fn point(comptime T: type, y: T) Interval(T) {
+    return .{ .lo = y, .hi = y };
+}
+
+/// The result for an inverted interval argument, lo > hi.
+fn inverted(comptime T: type) Interval(T) {
+    @setCold(true);
+    math.raiseInvalid();
+    return point(T, math.nan(T));
+}
+
+/// Rounds the interval outwards to the narrower type T.
+fn narrow(comptime T: type, b: anytype) Interval(T) {
+    return .{
+        .lo = roundWide(T, b.lo, 0).lo,
+        .hi = roundWide(T, b.hi, 0).hi,
+    };
+}
+
+/// Rounds v, of a wider type than T and within err of the exact result, down
+/// and up to T.
+fn roundWide(comptime T: type, v: anytype, err: @TypeOf(v)) Interval(T) {
+    const W = @TypeOf(v);
+    const r = @floatCast(T, v);
+    return .{
+        .lo = if (@as(W, r) <= v - err) r else nextDown(r),
+        .hi = if (@as(W, r) >= v + err) r else nextUp(r),
+    };
+}
+
+/// Rounds 2^k * (hi + lo) down and up, where |lo| <= |hi|, the exact result
+/// is within 2^k * err of that, and the result is normal.
+fn roundParts(hi: f64, lo: f64, err: f64, k: i32) Interval(f64) {
+    // Fast2Sum: hi - s is exact, and so is t = hi + lo - s.
+    const s = hi + lo;
+    const t = (hi - s) + lo;
+    const down = if (t >= err) s else nextDown(s);
+    const up = if (t <= -err) s else nextUp(s);
+    return .{ .lo = math.scalbn(down, k), .hi = math.scalbn(up, k) };
+}
+
+/// Rounds 2^k * (hi + lo) down and up like roundParts(), but to multiples of
+/// 2^-1074, for a result below 2^-1021 and k >= -1075.
+fn roundPartsSubnormal(hi: f64, lo: f64, err: f64, k: i32) Interval(f64) {
+    // In units of 2^-1074 the result is below 2^53, and the scaling is exact.
+    const hs = math.scalbn(hi, k + 1074);
+    const ls = math.scalbn(lo, k + 1074);
+    const n = @floor(hs + ls);
+    // hs - n is exact, so t is within 2^-52 of hs + ls - n, which is in
+    // [-1/2, 3/2). The 2^-51 in es covers that.
+    const t = (hs - n) + ls;
+    const es = math.scalbn(err, k + 1074) + 0x1p-51;
+    const down = if (t >= es) n else math.max(n - 1, 0);
+    const up = if (t <= -es) n else if (t <= 1 - es) n + 1 else n + 2;
+    return .{ .lo = math.scalbn(down, -1074), .hi = math.scalbn(up, -1074) };
+}
+
+fn exp64Bounds(x: f64) Interval(f64) {
+    const tblsiz = @intCast(u32, exp2_mod.exp2_64_tblsiz);
+    const shift: f64 = 0x1.8p52;
+    const inv_ln2_n: f64 = 0x1.71547652b82fep+8; // N / ln(2)
+    // ln(2) / N, with 34 bits in hi so that kd * hi is exact for |kd| < 2^19
+    const ln2_n_hi: f64 = 0x1.62e42fef8p-9;
+    const ln2_n_lo: f64 = 0x1.1cf79abc9e3b4p-44;
+    const log2e: f64 = 0x1.71547652b82fep+0;
+    const err_bound: f64 = 0x1p-58;
+
+    if (math.isNan(x)) {
+        return point(f64, x);
+    }
+    if (x == 0) {
+        return point(f64, 1);
+    }
+    // x > log(f64_max)
+    if (x > 0x1.62e42fefa39efp+9) {
+        if (math.isInf(x)) {
+            return point(f64, x);
+        }
+        return .{ .lo = math.f64_max, .hi = math.inf(f64) };
+    }
+    // x < log(0x1p-1075), includes -inf
+    if (x < -0x1.74910d52d3051p+9) {
+        if (math.isInf(x)) {
+            return point(f64, 0);
+        }
+        return .{ .lo = 0, .hi = 0x1p-1074 };
+    }
+
+    // Reduce as in exp10_64(), x = n * ln(2)/N + r, and use the exp2 kernel
+    // on r * log2(e). x - kd * ln2_n_hi is exact.
+    var kd: f64 = x * inv_ln2_n + shift;
+    const n = @bitCast(i32, @truncate(u32, @bitCast(u64, kd)));
+    kd -= shift;
+    const r: f64 = x - kd * ln2_n_hi - kd * ln2_n_lo;
+    const z: f64 = r * log2e;
+
+    const m = n + @intCast(i32, tblsiz / 2);
+    const i_0 = @intCast(u32, m & @intCast(i32, tblsiz - 1));
+    const k = @divFloor(m, @intCast(i32, tblsiz));
+    const p = exp2_mod.exp2_64KernelParts(i_0, z);
+    // x < log(0x1p-1021), rounded down: the result may be subnormal
+    if (x < -0x1.61da04cbafe44p+9) {
+        return roundPartsSubnormal(p.hi, p.lo, p.hi * err_bound, k);
+    }
+    return roundParts(p.hi, p.lo, p.hi * err_bound, k);
+}
+
+fn exp2_64Bounds(x: f64) Interval(f64) {
+    const err_bound: f64 = 0x1p-59;
+
+    if (math.isNan(x)) {
+        return point(f64, x);
+    }
+    if (exp2_mod.exp2Integer(f64, x)) |r| {
+        return point(f64, r);
+    }
+    if (x >= 1024) {
+        if (math.isInf(x)) {
+            return point(f64, x);
+        }
+        return .{ .lo = math.f64_max, .hi = math.inf(f64) };
+    }
+    if (x <= -1075) {
+        if (math.isInf(x)) {
+            return point(f64, 0);
+        }
+        return .{ .lo = 0, .hi = 0x1p-1074 };
+    }
+
+    const red = exp2_mod.exp2_64Reduce(x);
+    const p = exp2_mod.exp2_64KernelParts(red.i, red.z);
+    // x <= -1021: the result may be subnormal
+    if (x <= -1021) {
+        return roundPartsSubnormal(p.hi, p.lo, p.hi * err_bound, red.k);
+    }
+    return roundParts(p.hi, p.lo, p.hi * err_bound, red.k);
+}
+
+// log2(c) - fast.log2_table[i].log2c, the low parts of the table entries.
+const log2c_lo_table = [fast.log2_table.len]f64{
+    0x1.9ca1a3202b3d7p-56, -0x1.3bed456b24ed1p-56, 0x1.e15a52a31604ap-57,
+    -0x1.c4aec56233279p-57, 0x1.01d98c3531027p-58, -0x1.817fd3b7d7e5dp-58,
+    -0x1.bca36fd02def0p-56, -0x1.99aa6df8b7d83p-56, -0x1.8f89e2eb553b2p-57,
+    -0x1.b6d40900b2502p-61, -0x1.10b5b643a6ecbp-56, -0x1.e393a16b94b52p-56,
+    0x1.c658d602e66b0p-56, -0x1.968925e378d68p-56, -0x1.34107c0e54aedp-56,
+    -0x1.c8d43e017579bp-56, 0x1.3d56efe4338fep-58, 0x1.bdc0426c3c274p-57,
+    0x1.ba8b1f646ab12p-63, -0x1.bc0af7b82e7d7p-61, -0x1.013b6eaceb921p-57,
+    -0x1.99aa6df8b7d83p-57, 0x1.0798d1aa21694p-57, -0x1.90e41bca6ef96p-60,
+    0x1.7a6ed4e1b0936p-57, 0x1.696e2866c718ep-58, -0x1.5d243efd93259p-58,
+    -0x1.92ce9636c90a0p-58, -0x1.40238de7ea9f1p-58, -0x1.9ced1447e30adp-58,
+    -0x1.c141e66faaaadp-61, -0x1.98c5452bbce74p-61, -0x1.155660710eb2ap-63,
+    -0x1.77970e03f821cp-59, -0x1.491f06c085bc2p-60, -0x1.b2a41b08fbe06p-61,
+    -0x1.6d746128b1857p-61, 0.0, 0x1.fe38dec005e54p-61,
+    -0x1.d6476077b9fbdp-60, -0x1.27ebafb056cb9p-61, 0x1.89b03784b5be1p-60,
+    -0x1.60e0f2c3388f0p-62, -0x1.30c22d15199b8p-58, -0x1.3fd9776f25acfp-59,
+    0x1.f3314e0985116p-58, -0x1.463736dac9317p-58, 0x1.8ecb169b9465fp-58,
+    0x1.cbdb5d9dc29f2p-60, -0x1.a7610e40bd6abp-57, 0x1.7a9150c1e0e58p-57,
+    0x1.f51f2c075a74cp-59, 0x1.89c74a0b21fb6p-58, -0x1.817fd3b7d7e5dp-57,
+    0x1.4e00e7d6bbf3ep-58, -0x1.16edb88c4e2b5p-62, 0x1.7d6746548b95cp-62,
+    -0x1.01ee1343fe7cap-59, 0x1.0389b662673fcp-57, -0x1.b85a54d7ee2fdp-58,
+    -0x1.c1b061571081ep-58, 0x1.1d46ccc53c278p-58, 0x1.bc0c69a675517p-56,
+    -0x1.a7b47d2c352d9p-57, 0x1.4a31ce1b7e328p-56, -0x1.f6e91ad16ecffp-56,
+    0x1.bc4de8f631bcfp-56, -0x1.3376649b4fc09p-57, 0x1.d6cbcd10948cdp-56,
+    -0x1.b6d40900b2502p-62, 0x1.f73d83987f26dp-56, -0x1.817fd3b7d7e5dp-56,
+    -0x1.add8712376167p-58, 0x1.5e35482d13dc1p-56, -0x1.b90132aeddb58p-58,
+    0x1.9575b04fa6fbdp-57, -0x1.6d266d6cdc959p-56, -0x1.2d352bea51e59p-56,
+    0x1.a5db68721ca61p-57, -0x1.8a0efca1a184fp-56, -0x1.e5b8daaa73a43p-58,
+    -0x1.6fae441c09d76p-56, -0x1.52ef4c737fba5p-56, 0x1.f9fb952bbbcccp-56,
+    -0x1.b517ae88c2fd3p-57, -0x1.c141e66faaaadp-62, 0x1.3aec658457c41p-56,
+    0x1.8a33c25e8e226p-59, 0x1.f47806a0e4105p-56, -0x1.8f3673ffdd785p-57,
+    -0x1.18ce032f41d1ep-56,
+};
+
+/// Returns log2(2^k_adj * x) as hi + lo for positive normal x, with an error
+/// below 2^-58 * |hi|. This extends fast.log2Reduce() with the low parts of r
+/// and of the table entries, and sums the leading terms exactly.
+fn log2_64Parts(x: f64, k_adj: i32) struct { hi: f64, lo: f64 } {
+    // 1/ln(2) = L1 + L1_tail, and L1 = L1_hi + L1_lo with 27 bits in L1_hi
+    const L1: f64 = 0x1.71547652b82fep+0;
+    const L1_tail: f64 = 0x1.777d0ffda0d24p-56;
+    const L1_hi: f64 = 0x1.7154764p+0;
+    const L1_lo: f64 = 0x1.2b82fep-28;
+    // Taylor coefficients (-1)^(n+1) / (n * ln(2))
+    const Q2: f64 = -0x1.71547652b82fep-1;
+    const Q3: f64 = 0x1.ec709dc3a03fdp-2;
+    const Q4: f64 = -0x1.71547652b82fep-2;
+    const Q5: f64 = 0x1.2776c50ef9bfep-2;
+    const Q6: f64 = -0x1.ec709dc3a03fdp-3;
+    const Q7: f64 = 0x1.a61762a7aded9p-3;
+    const Q8: f64 = -0x1.71547652b82fep-3;
+    const shift: f64 = 0x1.8p52;
+
+    // x into [sqrt(2) / 2, sqrt(2)], as in log2_64()
+    const ix = @bitCast(u64, x);
+    var hx = @intCast(u32, ix >> 32);
+    hx += 0x3FF00000 - 0x3FE6A09E;
+    const k = @intToFloat(f64, @intCast(i32, hx >> 20) - 0x3FF + k_adj);
+    hx = (hx & 0x000FFFFF) + 0x3FE6A09E;
+    const f = @bitCast(f64, (@as(u64, hx) << 32) | (ix & 0xFFFFFFFF)) - 1.0;
+
+    // f = i/N + d exactly, as in fast.log2Reduce()
+    var kd = f * fast.log2_tblsiz + shift;
+    const i = @bitCast(i32, @truncate(u32, @bitCast(u64, kd)));
+    kd -= shift;
+    const idx = @intCast(usize, i + fast.log2_table_offset);
+    const e = fast.log2_table[idx];
+    const d = f - kd * (1.0 / @as(f64, fast.log2_tblsiz));
+    const c = 1.0 + kd * (1.0 / @as(f64, fast.log2_tblsiz));
+    const r = d * e.invc;
+
+    // rc = d/c - r, from an r with its low 8 bits cleared so that r8 * c is
+    // exact
+    const r8 = @bitCast(f64, @bitCast(u64, r) & ~@as(u64, 0xFF));
+    const rc = ((d - r8 * c) - (r - r8) * c) * e.invc;
+
+    // r * L1 = p + p_err exactly, splitting r as in Dekker's product
+    const g = r * 0x1.0000002p+27;
+    const r_hi = g - (g - r);
+    const r_lo = r - r_hi;
+    const p = r * L1;
+    const p_err = ((r_hi * L1_hi - p) + r_hi * L1_lo + r_lo * L1_hi) + r_lo * L1_lo;
+
+    const r2 = r * r;
+    const q = r2 * ((Q2 + r * Q3) + r2 * ((Q4 + r * Q5) + r2 * ((Q6 + r * Q7) + r2 * Q8)));
+
+    // k + log2c + p with the rounding errors, |log2c| < 1/2 <= |k| unless k
+    // is zero
+    const s1 = k + e.log2c;
+    const e1 = (k - s1) + e.log2c;
+    const s2 = s1 + p;
+    const bb = s2 - s1;
+    const e2 = (s1 - (s2 - bb)) + (p - bb);
+    return .{
+        .hi = s2,
+        .lo = e1 + e2 + log2c_lo_table[idx] + p_err + r * L1_tail + rc * L1 + q,
+    };
+}
+
+fn log2_64Bounds(x: f64) Interval(f64) {
+    const err_bound: f64 = 0x1p-58;
+
+    if (math.isNan(x) or x < 0) {
+        return point(f64, math.nan(f64));
+    }
+    if (x == 0) {
+        return point(f64, -math.inf(f64));
+    }
+    if (math.isInf(x)) {
+        return point(f64, x);
+    }
+
+    var ix = @bitCast(u64, x);
+    var k: i32 = 0;
+    // subnormal
+    if (ix < 0x0010000000000000) {
+        ix = @bitCast(u64, x * 0x1p54);
+        k = -54;
+    }
+    // powers of two are exact
+    if ((ix & 0x000FFFFFFFFFFFFF) == 0) {
+        return point(f64, @intToFloat(f64, @intCast(i32, ix >> 52) - 0x3FF + k));
+    }
+    const p = log2_64Parts(@bitCast(f64, ix), k);
+    return roundParts(p.hi, p.lo, math.fabs(p.hi) * err_bound, 0);
+}
+
+test "math.directed basic" {
+    const epsilon = 0.000001;
+
+    const e = expInterval(@as(f64, 0.2), 0.2);
+    try expect(e.lo == expDown(@as(f64, 0.2)) and e.hi == expUp(@as(f64, 0.2)));
+    try expect(e.lo < e.hi and math.approxEqAbs(f64, e.lo, 1.221403, epsilon));
+    const e2 = exp2Interval(@as(f32, -1.5), 0.8923);
+    try expect(math.approxEqAbs(f32, e2.lo, 0.353553, epsilon));
+    try expect(math.approxEqAbs(f32, e2.hi, 1.856133, epsilon));
+    const l = log2Interval(@as(f64, 0.2), 37.45);
+    try expect(math.approxEqAbs(f64, l.lo, -2.321928, epsilon));
+    try expect(math.approxEqAbs(f64, l.hi, 5.226894, epsilon));
+}
+
+test "math.directed exact" {
+    try expect(expDown(@as(f64, 0)) == 1 and expUp(@as(f64, 0)) == 1);
+    try expect(exp2Down(@as(f64, 3)) == 8 and exp2Up(@as(f64, 3)) == 8);
+    try expect(exp2Down(@as(f64, -1074)) == 0x1p-1074);
+    try expect(exp2Up(@as(f32, -149)) == 0x1p-149);
+    try expect(log2Down(@as(f64, 8)) == 3 and log2Up(@as(f64, 8)) == 3);
+    try expect(log2Down(@as(f64, 0x1p-1074)) == -1074);
+    try expect(log2Up(@as(f32, 0x1p-149)) == -149);
+}
+
+fn expectEnclosure(comptime T: type, b: Interval(T), v: f128) !void {
+    try expect(@as(f128, b.lo) <= v and v <= @as(f128, b.hi));
+    // At most two ulps wide, from the few arguments too close to a float
+    // to decide the rounding.
+    try expect(b.hi <= nextUp(nextUp(b.lo)));
+}
+
+test "math.directed enclosure" {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+    var tight: u32 = 0;
+    const n = 20000;
+    var i: u32 = 0;
+    while (i < n) : (i += 1) {
+        // Covers the subnormal results.
+        const x_exp = random.float(f64) * 1456 - 746;
+        const b_exp = expInterval(x_exp, x_exp);
+        try expectEnclosure(f64, b_exp, math.exp(@as(f128, x_exp)));
+        if (b_exp.hi == nextUp(b_exp.lo)) {
+            tight += 1;
+        }
+        const x_exp2 = random.float(f64) * 2100 - 1076;
+        try expectEnclosure(f64, exp2Interval(x_exp2, x_exp2), math.exp2(@as(f128, x_exp2)));
+        const x_f32 = @floatCast(f32, x_exp2 / 8);
+        try expectEnclosure(f32, exp2Interval(x_f32, x_f32), math.exp2(@as(f128, x_f32)));
+
+        const e = random.intRangeAtMost(i32, -1000, 1000);
+        const x_log2 = math.scalbn(random.float(f64) + 1, e);
+        const b_log2 = log2Interval(x_log2, x_log2);
+        try expectEnclosure(f64, b_log2, math.log2(@as(f128, x_log2)));
+    }
+    // The error bounds leave about 1 in 20 results two ulps wide.
+    try expect(tight > n - n / 10);
+}
+
+test "math.directed special" {
+    try expect(math.isNan(expDown(math.nan(f64))));
+    try expect(math.isNan(log2Up(math.nan(f32))));
+    try expect(math.isNan(log2Down(@as(f64, -1))));
+    try expect(expDown(-math.inf(f64)) == 0 and expUp(-math.inf(f64)) == 0);
+    try expect(math.isPositiveInf(exp2Down(math.inf(f32))));
+    try expect(math.isNegativeInf(log2Up(@as(f64, 0))));
+    try expect(math.isPositiveInf(log2Down(math.inf(f64))));
+
+    // Overflow and underflow leave the finite side of the interval.
+    try expect(expDown(@as(f64, 710)) == math.f64_max);
+    try expect(math.isPositiveInf(expUp(@as(f64, 710))));
+    try expect(exp2Down(@as(f32, 128.5)) == math.f32_max);
+    try expect(exp2Down(@as(f64, -1080)) == 0);
+    try expect(exp2Up(@as(f64, -1080)) == 0x1p-1074);
+    try expect(expDown(@as(f32, -104)) == 0);
+    try expect(expUp(@as(f32, -104)) == 0x1p-149);
+    // 2^-1074 * sqrt(2)
+    try expect(exp2Down(@as(f64, -1073.5)) == 0x1p-1074);
+    try expect(exp2Up(@as(f64, -1073.5)) == 0x1p-1073);
+}
+
+test "math.directed inverted" {
+    const b = expInterval(@as(f64, 1), 0);
+    try expect(math.isNan(b.lo) and math.isNan(b.hi));
+    try expect(math.isNan(exp2Interval(@as(f32, 0.5), -0.5).lo));
+    try expect(math.isNan(log2Interval(@as(f64, 2), 1).hi));
+}
@@ -3,28 +3,89 @@
 //
 // https://git.musl-libc.org/cgit/musl/tree/src/math/expf.c
 // https://git.musl-libc.org/cgit/musl/tree/src/math/exp.c
+// https://git.musl-libc.org/cgit/musl/tree/src/math/expl.c
 
 const std = @import("std");
 // const math = std.math;
 const math = @import("lib.zig");
 const expect = std.testing.expect;
 
+const counters = @import("counters.zig");
+const muladd = @import("muladd.zig");
+
 /// Returns e raised to the power of x (e^x).
 ///
 /// Special Cases:
 ///  - exp(+inf) = +inf
 ///  - exp(nan)  = nan
+///
+/// comptime_float arguments are evaluated at compile time with the f128
+/// kernel, and results that overflow f128 are a compile error.
 pub fn exp(x: anytype) @TypeOf(x) {
     const T = @TypeOf(x);
     return switch (T) {
+        comptime_float => expComptime(x),
+        f16 => @import("f16.zig").exp16(x),
         f32 => exp32(x),
         f64 => exp64(x),
+        f80 => exp80(x),
         f128 => exp128(x),
         else => @compileError("exp not implemented for " ++ @typeName(T)),
     };
 }
 
-fn exp32(x_: f32) f32 {
+fn exp32(x: f32) f32 {
+    const hx = @bitCast(u32, x) & 0x7FFFFFFF;
+
+    // 2^(-14) < |x| < 87.33655 with a single unsigned compare, everything
+    // else (including nan and inf) is handled out of line.
+    if (hx -% 0x39000001 >= 0x42AEAC50 - 0x39000001) {
+        return exp32Special(x);
+    }
+    counters.bump(.exp32, .normal);
+    return exp32Reduced(x);
+}
+
+/// exp32() for nan, inf, tiny |x| and |x| >= 87.33655.
+fn exp32Special(x: f32) f32 {
+    @setCold(true);
+
+    const hx = @bitCast(u32, x);
+    const ix = hx & 0x7FFFFFFF;
+
+    if (math.isNan(x)) {
+        counters.bump(.exp32, .special);
+        return math.nan(f32);
+    }
+    // |x| <= 2^(-14)
+    if (ix <= 0x39000000) {
+        if (math.fp_exceptions) {
+            math.doNotOptimizeAway(0x1.0p127 + x); // inexact
+        }
+        counters.bump(.exp32, .tiny);
+        return 1 + x;
+    }
+    // x >= 88.722839
+    if (ix >= 0x42b17218 and hx >> 31 == 0) {
+        counters.bump(.exp32, .overflow);
+        return x * 0x1.0p127;
+    }
+    if (hx >> 31 != 0) {
+        if (math.fp_exceptions) {
+            math.doNotOptimizeAway(-0x1.0p-149 / x); // overflow
+        }
+        // x <= -103.972084
+        if (ix >= 0x42CFF1B5) {
+            counters.bump(.exp32, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp32, .edge);
+    return exp32Reduced(x);
+}
+
+/// exp32() for 2^(-14) < |x| < 103.972084, without special cases.
+inline fn exp32Reduced(x_: f32) f32 {
     const half = [_]f32{ 0.5, -0.5 };
     const ln2hi = 6.9314575195e-1;
     const ln2lo = 1.4286067653e-6;
@@ -37,29 +98,6 @@ fn exp32(x_: f32) f32 {
     const sign = @intCast(i32, hx >> 31);
     hx &= 0x7FFFFFFF;
 
-    if (math.isNan(x)) {
-        return math.nan(f32);
-    }
-
-    // |x| >= -87.33655 or nan
-    if (hx >= 0x42AEAC50) {
-        // nan
-        if (hx > 0x7F800000) {
-            return x;
-        }
-        // x >= 88.722839
-        if (hx >= 0x42b17218 and sign == 0) {
-            return x * 0x1.0p127;
-        }
-        if (sign != 0) {
-            math.doNotOptimizeAway(-0x1.0p-149 / x); // overflow
-            // x <= -103.972084
-            if (hx >= 0x42CFF1B5) {
-                return 0;
-            }
-        }
-    }
-
     var k: i32 = undefined;
     var hi: f32 = undefined;
     var lo: f32 = undefined;
@@ -77,15 +115,10 @@ fn exp32(x_: f32) f32 {
         hi = x - fk * ln2hi;
         lo = fk * ln2lo;
         x = hi - lo;
-    }
-    // |x| > 2^(-14)
-    else if (hx > 0x39000000) {
+    } else {
         k = 0;
         hi = x;
         lo = 0;
-    } else {
-        math.doNotOptimizeAway(0x1.0p127 + x); // inexact
-        return 1 + x;
     }
 
     const xx = x * x;
@@ -99,7 +132,68 @@ fn exp32(x_: f32) f32 {
     }
 }
 
-fn exp64(x_: f64) f64 {
+fn exp64(x: f64) f64 {
+    return exp64With(muladd.enabled, x);
+}
+
+/// exp64() with or without fused multiply-adds in the polynomial, whatever
+/// the target.
+pub fn exp64With(comptime fused: bool, x: f64) f64 {
+    const hx = @intCast(u32, @bitCast(u64, x) >> 32) & 0x7FFFFFFF;
+
+    // 2^(-28) < |x| < 708.39 with a single unsigned compare, everything else
+    // (including nan and inf) is handled out of line.
+    if (hx -% 0x3E300001 >= 0x4086232B - 0x3E300001) {
+        return exp64Special(x);
+    }
+    counters.bump(.exp64, .normal);
+    return exp64ReducedWith(fused, x);
+}
+
+/// exp64() for nan, inf, tiny |x| and |x| >= 708.39.
+fn exp64Special(x: f64) f64 {
+    @setCold(true);
+
+    const hx = @intCast(u32, @bitCast(u64, x) >> 32) & 0x7FFFFFFF;
+
+    if (math.isNan(x)) {
+        counters.bump(.exp64, .special);
+        return math.nan(f64);
+    }
+    // |x| <= 2^(-28)
+    if (hx <= 0x3E300000) {
+        // inexact if x != 0
+        // math.doNotOptimizeAway(0x1.0p1023 + x);
+        counters.bump(.exp64, .tiny);
+        return 1 + x;
+    }
+    if (x > 709.782712893383973096) {
+        // overflow if x != inf
+        if (!math.isInf(x)) {
+            math.raiseOverflow();
+        }
+        counters.bump(.exp64, .overflow);
+        return math.inf(f64);
+    }
+    if (x < -708.39641853226410622) {
+        // underflow if x != -inf
+        // math.doNotOptimizeAway(@as(f32, -0x1.0p-149 / x));
+        if (x < -745.13321910194110842) {
+            counters.bump(.exp64, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp64, .edge);
+    return exp64Reduced(x);
+}
+
+/// exp64() for 2^(-28) < |x| <= 745.13, without special cases.
+pub inline fn exp64Reduced(x: f64) f64 {
+    return exp64ReducedWith(muladd.enabled, x);
+}
+
+/// exp64Reduced() with or without fused multiply-adds in the polynomial.
+pub inline fn exp64ReducedWith(comptime fused: bool, x_: f64) f64 {
     const half = [_]f64{ 0.5, -0.5 };
     const ln2hi: f64 = 6.93147180369123816490e-01;
     const ln2lo: f64 = 1.90821492927058770002e-10;
@@ -116,32 +210,6 @@ fn exp64(x_: f64) f64 {
     const sign = @intCast(i32, hx >> 31);
     hx &= 0x7FFFFFFF;
 
-    if (math.isNan(x)) {
-        return math.nan(f64);
-    }
-
-    // |x| >= 708.39 or nan
-    if (hx >= 0x4086232B) {
-        // nan
-        if (hx > 0x7FF00000) {
-            return x;
-        }
-        if (x > 709.782712893383973096) {
-            // overflow if x != inf
-            if (!math.isInf(x)) {
-                math.raiseOverflow();
-            }
-            return math.inf(f64);
-        }
-        if (x < -708.39641853226410622) {
-            // underflow if x != -inf
-            // math.doNotOptimizeAway(@as(f32, -0x1.0p-149 / x));
-            if (x < -745.13321910194110842) {
-                return 0;
-            }
-        }
-    }
-
     // argument reduction
     var k: i32 = undefined;
     var hi: f64 = undefined;
@@ -160,20 +228,19 @@ fn exp64(x_: f64) f64 {
         hi = x - dk * ln2hi;
         lo = dk * ln2lo;
         x = hi - lo;
-    }
-    // |x| > 2^(-28)
-    else if (hx > 0x3E300000) {
+    } else {
         k = 0;
         hi = x;
         lo = 0;
-    } else {
-        // inexact if x != 0
-        // math.doNotOptimizeAway(0x1.0p1023 + x);
-        return 1 + x;
     }
 
+    // c = x - xx * (P1 + xx * (P2 + xx * (P3 + xx * (P4 + xx * P5))))
     const xx = x * x;
-    const c = x - xx * (P1 + xx * (P2 + xx * (P3 + xx * (P4 + xx * P5))));
+    var p = muladd.mulAdd(fused, xx, P5, P4);
+    p = muladd.mulAdd(fused, xx, p, P3);
+    p = muladd.mulAdd(fused, xx, p, P2);
+    p = muladd.mulAdd(fused, xx, p, P1);
+    const c = muladd.mulAdd(fused, -xx, p, x);
     const y = 1 + (x * c / (2 - c) - lo + hi);
 
     if (k == 0) {
@@ -183,6 +250,85 @@ fn exp64(x_: f64) f64 {
     }
 }
 
+// The 80-bit version is musl's ld80 expl(), from Cephes.
+fn exp80(x: f80) f80 {
+    const e = @intCast(u16, @bitCast(u80, x) >> 64) & 0x7FFF; // exponent
+
+    // |x| < 8192 with a single unsigned compare, everything else (including
+    // nan and inf) is handled out of line.
+    if (e >= 0x3FFF + 13) {
+        return exp80Special(x);
+    }
+    counters.bump(.exp80, .normal);
+    return exp80Reduced(x);
+}
+
+/// exp80() for nan, inf and |x| >= 8192.
+fn exp80Special(x: f80) f80 {
+    @setCold(true);
+
+    if (math.isNan(x)) {
+        counters.bump(.exp80, .special);
+        return math.nan(f80);
+    }
+    // x > log(2^16384 - 0.5)
+    if (x > 11356.5234062941439488) {
+        // overflow if x != inf
+        if (x != math.inf_f80) {
+            math.raiseOverflow();
+        }
+        counters.bump(.exp80, .overflow);
+        return math.inf_f80;
+    }
+    // x < log(2^-16382): the result is subnormal or 0
+    if (x < -11355.1371119330240589) {
+        // underflow if x != -inf
+        if (x != -math.inf_f80) {
+            math.raiseUnderflow();
+        }
+        // x < log(2^-16446)
+        if (x < -11399.4985314888605581) {
+            counters.bump(.exp80, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp80, .edge);
+    return exp80Reduced(x);
+}
+
+/// exp80() for finite x within the overflow and underflow thresholds,
+/// without special cases.
+inline fn exp80Reduced(x_: f80) f80 {
+    const P0: f80 = 1.2617719307481059087798e-4;
+    const P1: f80 = 3.0299440770744196129956e-2;
+    const P2: f80 = 9.9999999999999999991025e-1;
+    const Q0: f80 = 3.0019850513866445504159e-6;
+    const Q1: f80 = 2.5244834034968410419224e-3;
+    const Q2: f80 = 2.2726554820815502876593e-1;
+    const Q3: f80 = 2.0000000000000000000897e0;
+    const ln2hi: f80 = 6.9314575195312500000000e-1;
+    const ln2lo: f80 = 1.4286068203094172321215e-6;
+    const log2e: f80 = 1.4426950408889634073599e0;
+    const shift: f80 = 0x1.8p63;
+
+    var x = x_;
+
+    // e^x = e^f * 2^k = e^(f + k * ln2), rounding k to nearest
+    const kd = (log2e * x + shift) - shift;
+    const k = @floatToInt(i32, kd);
+    x -= kd * ln2hi;
+    x -= kd * ln2lo;
+
+    // rational approximation of the fractional part:
+    // e^x = 1 + 2x P(x^2) / (Q(x^2) - x P(x^2))
+    const xx = x * x;
+    const px = x * ((P0 * xx + P1) * xx + P2);
+    const qx = ((Q0 * xx + Q1) * xx + Q2) * xx + Q3;
+    const y = 1.0 + 2.0 * (px / (qx - px));
+
+    return math.scalbn(y, k);
+}
+
 // from: FreeBSD: head/lib/msun/ld128/s_expl.c 251345 2013-06-03 20:09:22Z kargl
 
 // SPDX-License-Identifier: BSD-2-Clause-FreeBSD
@@ -347,7 +493,18 @@ const exp_128_table = [INTERVALS]struct { hi: f128, lo: f128 }{
     .{ .hi = 0x1.fd3c22b8f71f10975ba4b2p0, .lo = 0x1.2bcf3a5e12d269d8ad7c1a4a8875p-88 },
 };
 
-fn exp128(x: f128) f128 {
+/// The result of the exp128() argument reduction, such that
+/// e^x = 2^k * (hi + lo). Shared with expm1() and the hyperbolic functions so
+/// that they don't need to repeat the reduction.
+pub const Exp128Reduced = struct {
+    k: i32,
+    hi: f128,
+    lo: f128,
+};
+
+/// Reduce x for e^x using exp_128_table, with x assumed to be finite and
+/// within the thresholds checked by exp128().
+pub fn exp128Reduce(x: f128) Exp128Reduced {
     const L1: f128 = 5.41521234812457272982212595914567508e-3;
     const L2: f64 = -1.0253670638894731e-29; // -0x1.9ff0342542fc3p-97
     const inv_L: f64 = 1.8466496523378731e+2; // 0x1.71547652b82fep+7
@@ -362,45 +519,6 @@ fn exp128(x: f128) f128 {
     const A9: f64 = 2.7557324277411235e-6; // 0x1.71de3ec75a967p-19
     const A10: f64 = 2.7557333722375069e-7; // 0x1.27e505ab56259p-22
 
-    // Last values before overflow/underflow/subnormal.
-    const o_threshold = 11356.523406294143949491931077970763428; // 0x1.62e42fefa39ef35793c7673007e5p+13
-    const u_threshold = -11433.462743336297878837243843452621503; // -0x1.654bb3b2c73ebb059fabb506ff33p+13
-    const s_threshold = -11355.137111933024058873096613727848253; // -0x1.62d918ce2421d65ff90ac8f4ce65p+13
-
-    const ux: u128 = @bitCast(u128, x);
-    var hx: u32 = @intCast(u32, ux >> 96);
-    // const sign = @intCast(i32, hx >> 31);
-    hx &= 0x7FFFFFFF;
-
-    if (math.isNan(x)) {
-        return math.nan(f128);
-    }
-
-    // |x| >= 11355.1371... or NaN
-    if (hx >= 0x400C62D9) {
-        // NaN
-        if (hx > 0x7FFF0000) {
-            return x;
-        }
-        if (x > o_threshold) {
-            // overflow if x != inf
-            if (!math.isInf(x)) {
-                math.raiseOverflow();
-            }
-            return math.inf(f128);
-        }
-        if (x < s_threshold) {
-            // underflow if x != -inf
-            // math.doNotOptimizeAway(@as(f32, -0x1.0p-149 / x));
-            if (!math.isInf(x)) {
-                math.raiseUnderflow();
-            }
-            if (x < u_threshold) {
-                return 0;
-            }
-        }
-    }
-
     const fn_: f64 = (@floatCast(f64, x) * inv_L + 0x1.8p52) - 0x1.8p52;
     const n: i32 = @floatToInt(i32, fn_);
     const n2: u32 = @bitCast(u32, n) % INTERVALS;
@@ -414,24 +532,109 @@ fn exp128(x: f128) f128 {
     const q: f128 = r2 + r * r * (A2 + r * (A3 + r * (A4 + r * (A5 + r * (A6 +
         dr * (A7 + dr * (A8 + dr * (A9 + dr * A10))))))));
     // zig fmt: on
-    var t: f128 = exp_128_table[n2].lo + exp_128_table[n2].hi;
-    const hi: f128 = exp_128_table[n2].hi;
-    const lo: f128 = exp_128_table[n2].lo + t * (q + r1);
-    t = hi + lo;
+    const t: f128 = exp_128_table[n2].lo + exp_128_table[n2].hi;
+    return .{
+        .k = k,
+        .hi = exp_128_table[n2].hi,
+        .lo = exp_128_table[n2].lo + t * (q + r1),
+    };
+}
 
-    if (k == 0) {
+// Last values before overflow/underflow/subnormal.
+pub const exp128_o_threshold = 11356.523406294143949491931077970763428; // 0x1.62e42fefa39ef35793c7673007e5p+13
+const exp128_u_threshold = -11433.462743336297878837243843452621503; // -0x1.654bb3b2c73ebb059fabb506ff33p+13
+const exp128_s_threshold = -11355.137111933024058873096613727848253; // -0x1.62d918ce2421d65ff90ac8f4ce65p+13
+
+fn exp128(x: f128) f128 {
+    const hx = @intCast(u32, @bitCast(u128, x) >> 96) & 0x7FFFFFFF;
+
+    // |x| < 11355.1371... with a single unsigned compare, everything else
+    // (including NaN and inf) is handled out of line.
+    if (hx >= 0x400C62D9) {
+        return exp128Special(x);
+    }
+    counters.bump(.exp128, .normal);
+    return exp128Reduced(x);
+}
+
+/// exp128() for NaN, inf and |x| >= 11355.1371...
+fn exp128Special(x: f128) f128 {
+    @setCold(true);
+
+    if (math.isNan(x)) {
+        counters.bump(.exp128, .special);
+        return math.nan(f128);
+    }
+    if (x > exp128_o_threshold) {
+        // overflow if x != inf
+        if (!math.isInf(x)) {
+            math.raiseOverflow();
+        }
+        counters.bump(.exp128, .overflow);
+        return math.inf(f128);
+    }
+    if (x < exp128_s_threshold) {
+        // underflow if x != -inf
+        // math.doNotOptimizeAway(@as(f32, -0x1.0p-149 / x));
+        if (!math.isInf(x)) {
+            math.raiseUnderflow();
+        }
+        if (x < exp128_u_threshold) {
+            counters.bump(.exp128, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp128, .edge);
+    return exp128Reduced(x);
+}
+
+/// exp128() for finite x within the overflow and underflow thresholds,
+/// without special cases.
+inline fn exp128Reduced(x: f128) f128 {
+    const red = exp128Reduce(x);
+    const t: f128 = red.hi + red.lo;
+
+    if (red.k == 0) {
         return t;
     } else {
-        return math.scalbn(t, k);
+        return math.scalbn(t, red.k);
+    }
+}
+
+fn expComptime(comptime x: comptime_float) comptime_float {
+    comptime {
+        @setEvalBranchQuota(10_000);
+        // The out of range paths in exp128() raise exceptions, which can't be
+        // evaluated at compile time.
+        if (x > exp128_o_threshold) {
+            @compileError("exp overflows for comptime_float argument");
+        }
+        if (x < exp128_u_threshold) {
+            return 0;
+        }
+        const red = exp128Reduce(x);
+        return math.scalbn(red.hi + red.lo, red.k);
     }
 }
 
 test "math.exp" {
     try expect(exp(@as(f32, 0.0)) == exp32(0.0));
     try expect(exp(@as(f64, 0.0)) == exp64(0.0));
+    try expect(exp(@as(f80, 0.0)) == exp80(0.0));
     try expect(exp(@as(f128, 0.0)) == exp128(0.0));
 }
 
+test "math.exp comptime" {
+    const a = comptime exp(1.5);
+    try expect(@as(f128, a) == exp128(1.5));
+    const b = comptime exp(-11400.0);
+    try expect(@as(f128, b) == exp128(-11400.0));
+    // Beyond the range of f64.
+    const c = comptime exp(11000.0);
+    try expect(@as(f128, c) == exp128(11000.0));
+    try expect(comptime exp(-12000.0) == 0);
+}
+
 test "math.exp32" {
     const epsilon = 0.000001;
 
@@ -452,6 +655,16 @@ test "math.exp64" {
     try expect(math.approxEqAbs(f64, exp64(1.5), 4.481689, epsilon));
 }
 
+test "math.exp80" {
+    const epsilon = 0.000001;
+
+    try expect(exp80(0.0) == 1.0);
+    try expect(math.approxEqAbs(f80, exp80(0.2), 1.221403, epsilon));
+    try expect(math.approxEqAbs(f80, exp80(0.8923), 2.440737, epsilon));
+    try expect(math.approxEqAbs(f80, exp80(1.5), 4.481689, epsilon));
+    try expect(math.approxEqAbs(f80, exp80(-1.5), 0.223130, epsilon));
+}
+
 test "math.exp128" {
     const epsilon = 0.000001;
 
@@ -472,11 +685,42 @@ test "math.exp64.special" {
     try expect(math.isNan(exp64(math.nan(f64))));
 }
 
+test "math.exp80.special" {
+    try expect(exp80(math.inf_f80) == math.inf_f80);
+    try expect(exp80(-math.inf_f80) == 0);
+    try expect(math.isNan(exp80(math.qnan_f80)));
+}
+
 test "math.exp128.special" {
     try expect(math.isPositiveInf(exp128(math.inf(f128))));
     try expect(math.isNan(exp128(math.nan(f128))));
 }
 
+test "math.exp() fast path boundaries" {
+    // Arguments either side of the single compare gates, which are handled in
+    // and out of line, must agree with the f128 result.
+    const bits32 = [_]u32{ 0x39000000, 0x39000001, 0x42AEAC4F, 0x42AEAC50 };
+    for (bits32) |u| {
+        for ([_]f32{ 1, -1 }) |sign| {
+            const x = sign * @bitCast(f32, u);
+            const y = @floatCast(f32, exp128(x));
+            try expect(math.approxEqRel(f32, exp32(x), y, 1e-6));
+        }
+    }
+    const bits64 = [_]u64{ 0x3E30000000000000, 0x3E30000100000000, 0x4086232AFFFFFFFF, 0x4086232B00000000 };
+    for (bits64) |u| {
+        for ([_]f64{ 1, -1 }) |sign| {
+            const x = sign * @bitCast(f64, u);
+            const y = @floatCast(f64, exp128(x));
+            try expect(math.approxEqRel(f64, exp64(x), y, 1e-15));
+        }
+    }
+    for ([_]f80{ 8191.75, 8192.25, -8191.75, -8192.25 }) |x| {
+        const y = @floatCast(f80, exp128(x));
+        try expect(math.approxEqRel(f80, exp80(x), y, 1e-18));
+    }
+}
+
 pub fn main() !void {
     try @import("util.zig").singleInputFuncMain(exp);
 }
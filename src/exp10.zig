@@ -0,0 +1,280 @@
+// The reduction follows the same scheme as exp2(), using the exp2 tables:
+//
+//   10^x = 2^(n/N) * 10^r,  x = n * log10(2)/N + r,  |r| <= log10(2)/(2N)
+//
+// where log10(2)/N is split into hi and lo parts so that n * hi is exact, and
+// 10^r is evaluated as 2^(r * log2(10)) with the exp2 polynomials.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const exp2_mod = @import("exp2.zig");
+
+/// Returns 10 raised to the power of x (10^x).
+///
+/// Special Cases:
+///  - exp10(+inf) = +inf
+///  - exp10(-inf) = 0
+///  - exp10(nan)  = nan
+///  - exp10(n)    = 10^n exactly for integers n where 10^n is representable
+pub fn exp10(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => exp10_32(x),
+        f64 => exp10_64(x),
+        f128 => exp10_128(x),
+        else => @compileError("exp10 not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the powers of ten 10^0 .. 10^max, which must all be exact in T.
+fn pow10Table(comptime T: type, comptime max: usize) [max + 1]T {
+    var table: [max + 1]T = undefined;
+    var p: T = 1;
+    for (table) |*v| {
+        v.* = p;
+        p *= 10;
+    }
+    return table;
+}
+
+// 10^n is exact while 5^n fits in the significand.
+const pow10_32_table = pow10Table(f32, 10);
+const pow10_64_table = pow10Table(f64, 22);
+const pow10_128_table = pow10Table(f128, 48);
+
+/// Returns 10^n from the given table, with negative powers computed as a
+/// single correctly rounded division.
+fn exactPow10(comptime T: type, table: []const T, n: i32) T {
+    if (n < 0) {
+        return 1 / table[@intCast(usize, -n)];
+    }
+    return table[@intCast(usize, n)];
+}
+
+fn exp10_32(x: f32) f32 {
+    const tblsiz = @intCast(u32, exp2_mod.exp2_32_tblsiz);
+    const redux: f64 = 0x1.8p52 / @intToFloat(f64, tblsiz);
+    const log2_10: f64 = 0x1.a934f0979a371p+1;
+
+    // Return canonical NaN for any NaN input.
+    if (math.isNan(x)) {
+        return math.nan(f32);
+    }
+
+    const u = @bitCast(u32, x);
+    const ix = u & 0x7FFFFFFF;
+
+    // |x| > 38
+    if (ix > 0x42180000) {
+        // x > 39: overflow (log10(f32_max) ~= 38.53)
+        if (x > 39) {
+            return x * 0x1.0p127;
+        }
+        // x < -46: underflow (log10(0x1p-149) ~= -44.85)
+        if (x < -46) {
+            if (math.fp_exceptions and !math.isInf(x)) {
+                math.doNotOptimizeAway(-0x1.0p-149 / x);
+            }
+            return 0;
+        }
+    }
+    // |x| <= 0x1p-27: 10^x rounds to 1 + x
+    else if (ix <= 0x32000000) {
+        return 1.0 + x;
+    }
+    // |x| <= 10
+    else if (ix <= 0x41200000) {
+        const n = @floatToInt(i32, x);
+        if (@intToFloat(f32, n) == x) {
+            return exactPow10(f32, &pow10_32_table, n);
+        }
+    }
+
+    // The product in double precision leaves plenty of bits for an f32
+    // result, so there is no need for a hi/lo split of log10(2) here.
+    const y: f64 = @as(f64, x) * log2_10;
+    var uf: f64 = y + redux;
+    const n = @bitCast(i32, @truncate(u32, @bitCast(u64, uf)));
+    uf -= redux;
+    const z: f64 = y - uf;
+
+    const m = n + @intCast(i32, tblsiz / 2);
+    const i_0 = @intCast(u32, m & @intCast(i32, tblsiz - 1));
+    const k = @divFloor(m, @intCast(i32, tblsiz));
+    const r: f64 = exp2_mod.exp2_32Kernel(i_0, z);
+    return @floatCast(f32, math.scalbn(r, k));
+}
+
+fn exp10_64(x: f64) f64 {
+    const tblsiz = @intCast(u32, exp2_mod.exp2_64_tblsiz);
+    const shift: f64 = 0x1.8p52;
+    const inv_log10_2_n: f64 = 0x1.a934f0979a371p+9; // N / log10(2)
+    const log10_2_n_hi: f64 = 0x1.3441350ap-10; // log10(2) / N
+    const log10_2_n_lo: f64 = -0x1.0c0219dc1da99p-47;
+    const log2_10: f64 = 0x1.a934f0979a371p+1;
+
+    // Return canonical NaN for any NaN input.
+    if (math.isNan(x)) {
+        return math.nan(f64);
+    }
+
+    // x > log10(f64_max)
+    if (x > 0x1.34413509f79fep+8) {
+        math.raiseOverflow();
+        return math.inf(f64);
+    }
+    // x < -log10(2) * 1022
+    if (x < -0x1.33a7146f72a41p+8) {
+        // underflow
+        if (math.fp_exceptions) {
+            math.doNotOptimizeAway(@floatCast(f32, -0x1.0p-149 / x));
+        }
+        // x < log10(0x1p-1075), includes -inf
+        if (x < -0x1.439b746e36b52p+8) {
+            return 0;
+        }
+    }
+
+    const ux = @bitCast(u64, x);
+    const ix = @intCast(u32, ux >> 32) & 0x7FFFFFFF;
+
+    // |x| < 0x1p-56: 10^x rounds to 1 + x
+    if (ix < 0x3C700000) {
+        return 1.0 + x;
+    }
+    // |x| <= 22
+    if (ix <= 0x40360000) {
+        const n = @floatToInt(i32, x);
+        if (@intToFloat(f64, n) == x) {
+            return exactPow10(f64, &pow10_64_table, n);
+        }
+    }
+
+    // reduce x
+    var kd: f64 = x * inv_log10_2_n + shift;
+    const n = @bitCast(i32, @truncate(u32, @bitCast(u64, kd)));
+    kd -= shift;
+    const r: f64 = x - kd * log10_2_n_hi - kd * log10_2_n_lo;
+    const z: f64 = r * log2_10;
+
+    const m = n + @intCast(i32, tblsiz / 2);
+    const i_0 = @intCast(u32, m & @intCast(i32, tblsiz - 1));
+    const k = @divFloor(m, @intCast(i32, tblsiz));
+    return math.scalbn(exp2_mod.exp2_64Kernel(i_0, z), k);
+}
+
+fn exp10_128(x: f128) f128 {
+    const tblsiz = @intCast(u32, exp2_mod.exp2_128_tblsiz);
+    const shift: f128 = 0x1.8p112;
+    const inv_log10_2_n: f64 = 0x1.a934f0979a371p+8; // N / log10(2)
+    const log10_2_n_hi: f128 = 0x1.34413509f79fef311f12b4p-9; // log10(2) / N
+    const log10_2_n_lo: f128 = -0x1.4fd20dba1f654b3ceaf0b832d9d7p-98;
+    const log2_10: f128 = 0x1.a934f0979a3715fc9257edfe9b6p+1;
+
+    // Return canonical NaN for any NaN input.
+    if (math.isNan(x)) {
+        return math.nan(f128);
+    }
+
+    // x > log10(f128_max)
+    if (x > 0x1.34413509f79fef311f12b35816f9p+12) {
+        math.raiseOverflow();
+        return math.inf(f128);
+    }
+    // x < -log10(2) * 16382
+    if (x < -0x1.343793004f503231a589bac27c38p+12) {
+        // underflow
+        if (math.fp_exceptions) {
+            math.doNotOptimizeAway(@floatCast(f32, -0x1.0p-149 / x));
+        }
+        // x < log10(0x1p-16495), includes -inf
+        if (x < -0x1.3657d621f4e96893f84497c723cp+12) {
+            return 0;
+        }
+    }
+
+    const ux = @bitCast(u128, x);
+    const e: u16 = @intCast(u16, ux >> 112) & 0x7FFF; // exponent
+
+    // |x| < 0x1p-116: 10^x rounds to 1 + x
+    if (e < 0x3FFF - 116) {
+        return 1.0 + x;
+    }
+    // |x| <= 48
+    if (x >= -48 and x <= 48) {
+        const n = @floatToInt(i32, x);
+        if (@intToFloat(f128, n) == x) {
+            return exactPow10(f128, &pow10_128_table, n);
+        }
+    }
+
+    // reduce x
+    var kd: f128 = x * inv_log10_2_n + shift;
+    const n = @bitCast(i32, @truncate(u32, @bitCast(u128, kd)));
+    kd -= shift;
+    const r: f128 = x - kd * log10_2_n_hi - kd * log10_2_n_lo;
+    const z: f128 = r * log2_10;
+
+    const m = n + @intCast(i32, tblsiz / 2);
+    const i_0 = @intCast(u32, m & @intCast(i32, tblsiz - 1));
+    const k = @divFloor(m, @intCast(i32, tblsiz));
+    return math.scalbn(exp2_mod.exp2_128Kernel(i_0, z), k);
+}
+
+test "math.exp10() delegation" {
+    try expect(exp10(@as(f32, 0.8923)) == exp10_32(0.8923));
+    try expect(exp10(@as(f64, 0.8923)) == exp10_64(0.8923));
+    try expect(exp10(@as(f128, 0.8923)) == exp10_128(0.8923));
+}
+
+test "math.exp10_32() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp10_32(0.0) == 1.0);
+    try expect(math.approxEqAbs(f32, exp10_32(0.2), 1.584893, epsilon));
+    try expect(math.approxEqAbs(f32, exp10_32(0.8923), 7.803690, epsilon));
+    try expect(math.approxEqAbs(f32, exp10_32(-1.5), 0.031623, epsilon));
+    try expect(exp10_32(3) == 1000);
+    try expect(exp10_32(-1) == 0.1);
+}
+
+test "math.exp10_64() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp10_64(0.0) == 1.0);
+    try expect(math.approxEqAbs(f64, exp10_64(0.2), 1.584893, epsilon));
+    try expect(math.approxEqAbs(f64, exp10_64(0.8923), 7.803690, epsilon));
+    try expect(math.approxEqAbs(f64, exp10_64(-1.5), 0.031623, epsilon));
+    try expect(exp10_64(22) == 1e22);
+    try expect(exp10_64(-22) == 1e-22);
+}
+
+test "math.exp10_128() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp10_128(0.0) == 1.0);
+    try expect(math.approxEqAbs(f128, exp10_128(0.2), 1.584893, epsilon));
+    try expect(math.approxEqAbs(f128, exp10_128(0.8923), 7.803690, epsilon));
+    try expect(math.approxEqAbs(f128, exp10_128(-1.5), 0.031623, epsilon));
+    try expect(exp10_128(48) == 1e48);
+    try expect(exp10_128(-48) == 1e-48);
+}
+
+test "math.exp10().special" {
+    try expect(math.isPositiveInf(exp10(math.inf(f32))));
+    try expect(exp10(-math.inf(f32)) == 0);
+    try expect(math.isNan(exp10(math.nan(f32))));
+    try expect(math.isPositiveInf(exp10(math.inf(f64))));
+    try expect(exp10(-math.inf(f64)) == 0);
+    try expect(math.isNan(exp10(math.nan(f64))));
+    try expect(math.isPositiveInf(exp10(math.inf(f128))));
+    try expect(exp10(-math.inf(f128)) == 0);
+    try expect(math.isNan(exp10(math.nan(f128))));
+}
+
+pub fn main() !void {
+    try @import("util.zig").singleInputFuncMain(exp10);
+}
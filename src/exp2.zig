@@ -3,28 +3,88 @@
 //
 // https://git.musl-libc.org/cgit/musl/tree/src/math/exp2f.c
 // https://git.musl-libc.org/cgit/musl/tree/src/math/exp2.c
+// https://git.musl-libc.org/cgit/musl/tree/src/math/exp2l.c
 
 const std = @import("std");
 // const math = std.math;
 const math = @import("lib.zig");
 const expect = std.testing.expect;
 
+const counters = @import("counters.zig");
+const muladd = @import("muladd.zig");
+
 /// Returns 2 raised to the power of x (2^x).
 ///
 /// Special Cases:
 ///  - exp2(+inf) = +inf
 ///  - exp2(nan)  = nan
+///
+/// comptime_float arguments are evaluated at compile time with the f128
+/// kernel, and results that overflow f128 are a compile error.
 pub fn exp2(x: anytype) @TypeOf(x) {
     const T = @TypeOf(x);
     return switch (T) {
+        comptime_float => exp2Comptime(x),
+        f16 => @import("f16.zig").exp2_16(x),
         f32 => exp2_32(x),
         f64 => exp2_64(x),
+        f80 => exp2_80(x),
         f128 => exp2_128(x),
         else => @compileError("exp2 not implemented for " ++ @typeName(T)),
     };
 }
 
-const exp2_32_table = [_]f64{
+/// Returns 2^x built directly from the exponent bits if x is an integer with a
+/// finite non-zero result, or null otherwise. Any other input is rejected by
+/// an exponent compare or a shift of the fraction bits. What that costs the
+/// other inputs is what bench/exp2.zig measures, and it hasn't been timed.
+pub inline fn exp2Integer(comptime T: type, x: T) ?T {
+    const bits = @typeInfo(T).Float.bits;
+    const U = std.meta.Int(.unsigned, bits);
+    const Shift = math.Log2Int(U);
+    const mant_bits = math.floatMantissaBits(T);
+    const exp_bits = math.floatExponentBits(T);
+    // f80 stores the integer bit of the significand explicitly.
+    const explicit_bit = if (T == f80) 1 else 0;
+    const frac_bits = mant_bits - explicit_bit;
+    const bias = (1 << (exp_bits - 1)) - 1;
+    const min_exp = 1 - bias;
+
+    const ux = @bitCast(U, x);
+    const e = @intCast(i32, (ux >> mant_bits) & ((1 << exp_bits) - 1)) - bias;
+
+    // |x| < 1 or |x| >= 2^exp_bits (which includes inf and nan)
+    if (@bitCast(u32, e) >= exp_bits) {
+        return null;
+    }
+    // fraction bits below the binary point
+    if (ux << @intCast(Shift, 1 + exp_bits + explicit_bit + e) != 0) {
+        return null;
+    }
+
+    const m = (ux & ((1 << mant_bits) - 1)) | (1 << frac_bits);
+    const mag = @intCast(i32, m >> @intCast(Shift, frac_bits - e));
+    const n = if (ux >> (bits - 1) != 0) -mag else mag;
+
+    // overflow
+    if (n > bias) {
+        return null;
+    }
+    // normal
+    if (n >= min_exp) {
+        const ue = @intCast(U, n + bias) << mant_bits;
+        return @bitCast(T, ue | (@as(U, explicit_bit) << frac_bits));
+    }
+    // subnormal
+    if (n >= min_exp - frac_bits) {
+        return @bitCast(T, @as(U, 1) << @intCast(Shift, n - min_exp + frac_bits));
+    }
+    // underflow
+    return null;
+}
+
+/// 2^((i - 8) / 16), also kept in registers by simd32.zig.
+pub const exp2_32_table = [_]f64{
     0x1.6a09e667f3bcdp-1,
     0x1.7a11473eb0187p-1,
     0x1.8ace5422aa0dbp-1,
@@ -43,47 +103,80 @@ const exp2_32_table = [_]f64{
     0x1.5ab07dd485429p+0,
 };
 
-fn exp2_32(x: f32) f32 {
-    const tblsiz = @intCast(u32, exp2_32_table.len);
-    const redux: f32 = 0x1.8p23 / @intToFloat(f32, tblsiz);
+/// Returns 2^((i - N/2) / N + z) for table index i of the N-entry
+/// exp2_32_table, with |z| <= 1/(2N). Shared with exp10.
+pub fn exp2_32Kernel(i: u32, z: f64) f64 {
     const P1: f32 = 0x1.62e430p-1;
     const P2: f32 = 0x1.ebfbe0p-3;
     const P3: f32 = 0x1.c6b348p-5;
     const P4: f32 = 0x1.3b2c9cp-7;
 
+    const r: f64 = exp2_32_table[@intCast(usize, i)];
+    const t: f64 = r * z;
+    return r + t * (P1 + z * P2) + t * (z * z) * (P3 + z * P4);
+}
+
+pub const exp2_32_tblsiz = exp2_32_table.len;
+
+fn exp2_32(x: f32) f32 {
+    if (exp2Integer(f32, x)) |r| {
+        counters.bump(.exp2_32, .integer);
+        return r;
+    }
+
+    const ix = @bitCast(u32, x) & 0x7FFFFFFF;
+
+    // 0x1p-25 < |x| <= 126 with a single unsigned compare, everything else
+    // (including nan and inf) is handled out of line.
+    if (ix -% 0x33000001 > 0x42FC0000 - 0x33000001) {
+        return exp2_32Special(x);
+    }
+    counters.bump(.exp2_32, .normal);
+    return exp2_32Reduced(x);
+}
+
+/// exp2_32() for nan, inf, tiny |x| and |x| > 126.
+fn exp2_32Special(x: f32) f32 {
+    @setCold(true);
+
     // Return canonical NaN for any NaN input.
     if (math.isNan(x)) {
+        counters.bump(.exp2_32, .special);
         return math.nan(f32);
     }
 
-    var u = @bitCast(u32, x);
+    const u = @bitCast(u32, x);
     const ix = u & 0x7FFFFFFF;
 
-    // |x| > 126
-    if (ix > 0x42FC0000) {
-        // nan
-        if (ix > 0x7F800000) {
-            return x;
-        }
-        // x >= 128
-        if (u >= 0x43000000 and u < 0x80000000) {
-            return x * 0x1.0p127;
-        }
-        // x < -126
-        if (u >= 0x80000000) {
-            if (u >= 0xC3160000 or u & 0x000FFFF != 0) {
-                math.doNotOptimizeAway(-0x1.0p-149 / x);
-            }
-            // x <= -150
-            if (u >= 0xC3160000) {
-                return 0;
-            }
-        }
-    }
     // |x| <= 0x1p-25
-    else if (ix <= 0x33000000) {
+    if (ix <= 0x33000000) {
+        counters.bump(.exp2_32, .tiny);
         return 1.0 + x;
     }
+    // x >= 128
+    if (u >= 0x43000000 and u < 0x80000000) {
+        counters.bump(.exp2_32, .overflow);
+        return x * 0x1.0p127;
+    }
+    // x < -126
+    if (u >= 0x80000000) {
+        if (math.fp_exceptions and (u >= 0xC3160000 or u & 0x000FFFF != 0)) {
+            math.doNotOptimizeAway(-0x1.0p-149 / x);
+        }
+        // x <= -150
+        if (u >= 0xC3160000) {
+            counters.bump(.exp2_32, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp2_32, .edge);
+    return exp2_32Reduced(x);
+}
+
+/// exp2_32() for finite x in (-150, 128), without special cases.
+inline fn exp2_32Reduced(x: f32) f32 {
+    const tblsiz = @intCast(u32, exp2_32_table.len);
+    const redux: f32 = 0x1.8p23 / @intToFloat(f32, tblsiz);
 
     // NOTE: musl relies on unsafe behaviours which are replicated below
     // (addition/bit-shift overflow). Appears that this produces the
@@ -99,13 +192,11 @@ fn exp2_32(x: f32) f32 {
     uf -= redux;
 
     const z: f64 = x - uf;
-    var r: f64 = exp2_32_table[@intCast(usize, i_0)];
-    const t: f64 = r * z;
-    r = r + t * (P1 + z * P2) + t * (z * z) * (P3 + z * P4);
+    const r: f64 = exp2_32Kernel(i_0, z);
     return @floatCast(f32, r * uk);
 }
 
-const exp2_64_table = [_]f64{
+pub const exp2_64_table = [_]f64{
     //  exp2(z + eps)          eps
     0x1.6a09e667f3d5dp-1, 0x1.9880p-44,
     0x1.6b052fa751744p-1, 0x1.8000p-50,
@@ -365,49 +456,146 @@ const exp2_64_table = [_]f64{
     0x1.690f4b19e9471p+0, -0x1.9780p-45,
 };
 
-fn exp2_64(x: f64) f64 {
-    const tblsiz: u32 = @intCast(u32, exp2_64_table.len / 2);
-    const redux: f64 = 0x1.8p52 / @intToFloat(f64, tblsiz);
+/// The exp2 kernel result as an unevaluated sum hi + lo, with |lo| much
+/// smaller than hi.
+pub fn Exp2Parts(comptime T: type) type {
+    return struct {
+        hi: T,
+        lo: T,
+    };
+}
+
+/// The reduction x = k + (i - N/2) / N + z used by the exp2 kernels.
+pub fn Exp2Reduced(comptime T: type) type {
+    return struct {
+        i: u32,
+        k: i32,
+        z: T,
+    };
+}
+
+/// Returns 2^((i - N/2) / N + z) for table index i of the N-entry
+/// exp2_64_table, with |z| <= 1/(2N). Shared with exp10.
+pub fn exp2_64Kernel(i: u32, z: f64) f64 {
+    const p = exp2_64KernelParts(i, z);
+    return p.hi + p.lo;
+}
+
+/// exp2_64Kernel() before the final addition. The sum is within 2^-60.31
+/// (relative) of the exact result, with or without fused multiply-adds, as
+/// derived by misc/directed_bounds.py.
+pub fn exp2_64KernelParts(i: u32, z: f64) Exp2Parts(f64) {
+    return exp2_64KernelPartsWith(muladd.enabled, i, z);
+}
+
+/// exp2_64KernelParts() with or without fused multiply-adds in the
+/// polynomial.
+pub inline fn exp2_64KernelPartsWith(comptime fused: bool, i: u32, z_: f64) Exp2Parts(f64) {
     const P1: f64 = 0x1.62e42fefa39efp-1;
     const P2: f64 = 0x1.ebfbdff82c575p-3;
     const P3: f64 = 0x1.c6b08d704a0a6p-5;
     const P4: f64 = 0x1.3b2ab88f70400p-7;
     const P5: f64 = 0x1.5d88003875c74p-10;
 
+    // r = exp2(y) = exp2t[i] * p(z - eps[i])
+    const t: f64 = exp2_64_table[@intCast(usize, 2 * i)];
+    const z: f64 = z_ - exp2_64_table[@intCast(usize, 2 * i + 1)];
+    // p = P1 + z * (P2 + z * (P3 + z * (P4 + z * P5)))
+    var p = muladd.mulAdd(fused, z, P5, P4);
+    p = muladd.mulAdd(fused, z, p, P3);
+    p = muladd.mulAdd(fused, z, p, P2);
+    p = muladd.mulAdd(fused, z, p, P1);
+    return .{
+        .hi = t,
+        .lo = t * z * p,
+    };
+}
+
+pub const exp2_64_tblsiz = exp2_64_table.len / 2;
+
+fn exp2_64(x: f64) f64 {
+    return exp2_64With(muladd.enabled, x);
+}
+
+/// exp2_64() with or without fused multiply-adds in the polynomial, whatever
+/// the target.
+pub fn exp2_64With(comptime fused: bool, x: f64) f64 {
+    if (exp2Integer(f64, x)) |r| {
+        counters.bump(.exp2_64, .integer);
+        return r;
+    }
+
+    const ix = @intCast(u32, @bitCast(u64, x) >> 32) & 0x7FFFFFFF;
+
+    // 0x1p-54 <= |x| < 1022 with a single unsigned compare, everything else
+    // (including nan and inf) is handled out of line.
+    if (ix -% 0x3C900000 >= 0x408FF000 - 0x3C900000) {
+        return exp2_64Special(x);
+    }
+    counters.bump(.exp2_64, .normal);
+    return exp2_64ReducedWith(fused, x);
+}
+
+/// exp2_64() for nan, inf, tiny |x| and |x| >= 1022.
+fn exp2_64Special(x: f64) f64 {
+    @setCold(true);
+
     // Return canonical NaN for any NaN input.
     if (math.isNan(x)) {
+        counters.bump(.exp2_64, .special);
         return math.nan(f64);
     }
 
     const ux = @bitCast(u64, x);
     const ix = @intCast(u32, ux >> 32) & 0x7FFFFFFF;
 
-    // |x| >= 1022 or nan
-    if (ix >= 0x408FF000) {
-        // x >= 1024 or nan
-        if (ix >= 0x40900000 and ux >> 63 == 0) {
-            math.raiseOverflow();
-            return math.inf(f64);
-        }
-        // -inf or nan
-        if (ix >= 0x7FF00000) {
-            return -1 / x;
-        }
-        // x <= -1022
-        if (ux >> 63 != 0) {
-            // underflow
-            if (x <= -1075 or x - 0x1.0p52 + 0x1.0p52 != x) {
-                math.doNotOptimizeAway(@floatCast(f32, -0x1.0p-149 / x));
-            }
-            if (x <= -1075) {
-                return 0;
-            }
-        }
-    }
     // |x| < 0x1p-54
-    else if (ix < 0x3C900000) {
+    if (ix < 0x3C900000) {
+        counters.bump(.exp2_64, .tiny);
         return 1.0 + x;
     }
+    // x >= 1024
+    if (ix >= 0x40900000 and ux >> 63 == 0) {
+        math.raiseOverflow();
+        counters.bump(.exp2_64, .overflow);
+        return math.inf(f64);
+    }
+    // -inf
+    if (ix >= 0x7FF00000) {
+        counters.bump(.exp2_64, .underflow);
+        return -1 / x;
+    }
+    // x <= -1022
+    if (ux >> 63 != 0) {
+        // underflow
+        if (math.fp_exceptions and (x <= -1075 or x - 0x1.0p52 + 0x1.0p52 != x)) {
+            math.doNotOptimizeAway(@floatCast(f32, -0x1.0p-149 / x));
+        }
+        if (x <= -1075) {
+            counters.bump(.exp2_64, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp2_64, .edge);
+    return exp2_64Reduced(x);
+}
+
+/// exp2_64() for finite x in (-1075, 1024), without special cases.
+pub inline fn exp2_64Reduced(x: f64) f64 {
+    return exp2_64ReducedWith(muladd.enabled, x);
+}
+
+/// exp2_64Reduced() with or without fused multiply-adds in the polynomial.
+inline fn exp2_64ReducedWith(comptime fused: bool, x: f64) f64 {
+    const red = exp2_64Reduce(x);
+    const p = exp2_64KernelPartsWith(fused, red.i, red.z);
+    return math.scalbn(p.hi + p.lo, red.k);
+}
+
+/// Reduces finite x in (-1075, 1024) for exp2_64Kernel().
+pub fn exp2_64Reduce(x: f64) Exp2Reduced(f64) {
+    const tblsiz: u32 = @intCast(u32, exp2_64_table.len / 2);
+    const redux: f64 = 0x1.8p52 / @intToFloat(f64, tblsiz);
 
     // NOTE: musl relies on unsafe behaviours which are replicated below
     // (addition overflow, division truncation, casting). Appears that this
@@ -424,13 +612,232 @@ fn exp2_64(x: f64) f64 {
     i_0 %= tblsiz;
     uf -= redux;
 
-    // r = exp2(y) = exp2t[i_0] * p(z - eps[i])
-    var z: f64 = x - uf;
-    const t: f64 = exp2_64_table[@intCast(usize, 2 * i_0)];
-    z -= exp2_64_table[@intCast(usize, 2 * i_0 + 1)];
-    const r: f64 = t + t * z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * P5))));
+    return .{ .i = i_0, .k = ik, .z = x - uf };
+}
+
+// 2^((i - N/2) / N) as the sum of two doubles, hi + lo.
+const exp2_80_table = [_]f64{
+    //  hi                     lo
+    0x1.6a09e667f3bcdp-1, -0x1.bdd3413b26456p-55,
+    0x1.6c012750bdabfp-1, -0x1.2895667ff0b0dp-57,
+    0x1.6dfb23c651a2fp-1, -0x1.bbe3a683c88abp-58,
+    0x1.6ff7df9519484p-1, -0x1.83c0f25860ef6p-56,
+    0x1.71f75e8ec5f74p-1, -0x1.16e4786887a99p-56,
+    0x1.73f9a48a58174p-1, -0x1.0a8d96c65d53cp-55,
+    0x1.75feb564267c9p-1, -0x1.0245957316dd3p-55,
+    0x1.780694fde5d3fp-1, 0x1.866b80a02162dp-55,
+    0x1.7a11473eb0187p-1, -0x1.41577ee04992fp-56,
+    0x1.7c1ed0130c132p-1, 0x1.f124cd1164dd6p-55,
+    0x1.7e2f336cf4e62p-1, 0x1.05d02ba15797ep-57,
+    0x1.80427543e1a12p-1, -0x1.27c86626d972bp-55,
+    0x1.82589994cce13p-1, -0x1.d4c1dd41532d8p-55,
+    0x1.8471a4623c7adp-1, -0x1.8d684a341cdfbp-56,
+    0x1.868d99b4492edp-1, -0x1.fc6f89bd4f6bap-55,
+    0x1.88ac7d98a6699p-1, 0x1.994c2f37cb53ap-55,
+    0x1.8ace5422aa0dbp-1, 0x1.6e9f156864b27p-55,
+    0x1.8cf3216b5448cp-1, -0x1.0d55e32e9e3aap-57,
+    0x1.8f1ae99157736p-1, 0x1.5cc13a2e3976cp-56,
+    0x1.9145b0b91ffc6p-1, -0x1.dd6792e582524p-55,
+    0x1.93737b0cdc5e5p-1, -0x1.75fc781b57ebcp-58,
+    0x1.95a44cbc8520fp-1, -0x1.64b7c96a5f039p-57,
+    0x1.97d829fde4e50p-1, -0x1.d185b7c1b85d1p-55,
+    0x1.9a0f170ca07bap-1, -0x1.173bd91cee632p-55,
+    0x1.9c49182a3f090p-1, 0x1.c7c46b071f2bep-57,
+    0x1.9e86319e32323p-1, 0x1.824ca78e64c6ep-57,
+    0x1.a0c667b5de565p-1, -0x1.359495d1cd533p-55,
+    0x1.a309bec4a2d33p-1, 0x1.6305c7ddc36abp-55,
+    0x1.a5503b23e255dp-1, -0x1.d2f6edb8d41e1p-55,
+    0x1.a799e1330b358p-1, 0x1.bcb7ecac563c7p-55,
+    0x1.a9e6b5579fdbfp-1, 0x1.0fac90ef7fd31p-55,
+    0x1.ac36bbfd3f37ap-1, -0x1.f9234cae76cd0p-56,
+    0x1.ae89f995ad3adp-1, 0x1.7a1cd345dcc81p-55,
+    0x1.b0e07298db666p-1, -0x1.bdef54c80e425p-55,
+    0x1.b33a2b84f15fbp-1, -0x1.2805e3084d708p-58,
+    0x1.b59728de5593ap-1, -0x1.c71dfbbba6de3p-55,
+    0x1.b7f76f2fb5e47p-1, -0x1.5584f7e54ac3bp-57,
+    0x1.ba5b030a1064ap-1, -0x1.efcd30e54292ep-55,
+    0x1.bcc1e904bc1d2p-1, 0x1.23dd07a2d9e84p-56,
+    0x1.bf2c25bd71e09p-1, -0x1.efdca3f6b9c73p-55,
+    0x1.c199bdd85529cp-1, 0x1.11065895048ddp-56,
+    0x1.c40ab5fffd07ap-1, 0x1.b4537e083c60ap-55,
+    0x1.c67f12e57d14bp-1, 0x1.2884dff483cadp-55,
+    0x1.c8f6d9406e7b5p-1, 0x1.1acbc48805c44p-57,
+    0x1.cb720dcef9069p-1, 0x1.503cbd1e949dbp-57,
+    0x1.cdf0b555dc3fap-1, -0x1.dd83b53829d72p-56,
+    0x1.d072d4a07897cp-1, -0x1.cbc3743797a9cp-55,
+    0x1.d2f87080d89f2p-1, -0x1.d487b719d8578p-55,
+    0x1.d5818dcfba487p-1, 0x1.2ed02d75b3707p-56,
+    0x1.d80e316c98398p-1, -0x1.11ec18beddfe8p-55,
+    0x1.da9e603db3285p-1, 0x1.c2300696db532p-55,
+    0x1.dd321f301b460p-1, 0x1.2da5778f018c3p-55,
+    0x1.dfc97337b9b5fp-1, -0x1.1a5cd4f184b5cp-55,
+    0x1.e264614f5a129p-1, -0x1.7b627817a1496p-55,
+    0x1.e502ee78b3ff6p-1, 0x1.39e8980a9cc8fp-56,
+    0x1.e7a51fbc74c83p-1, 0x1.2d522ca0c8de2p-55,
+    0x1.ea4afa2a490dap-1, -0x1.e9c23179c2893p-55,
+    0x1.ecf482d8e67f1p-1, -0x1.c93f3b411ad8cp-55,
+    0x1.efa1bee615a27p-1, 0x1.dc7f486a4b6b0p-55,
+    0x1.f252b376bba97p-1, 0x1.3a1a5bf0d8e43p-55,
+    0x1.f50765b6e4540p-1, 0x1.9d3e12dd8a18bp-55,
+    0x1.f7bfdad9cbe14p-1, -0x1.dbb12d006350ap-55,
+    0x1.fa7c1819e90d8p-1, 0x1.74853f3a5931ep-56,
+    0x1.fd3c22b8f71f1p-1, 0x1.2eb74966579e7p-58,
+    0x1.0000000000000p+0, 0x0p+0,
+    0x1.0163da9fb3335p+0, 0x1.b61299ab8cdb7p-54,
+    0x1.02c9a3e778061p+0, -0x1.19083535b085dp-56,
+    0x1.04315e86e7f85p+0, -0x1.0a31c1977c96ep-54,
+    0x1.059b0d3158574p+0, 0x1.d73e2a475b465p-55,
+    0x1.0706b29ddf6dep+0, -0x1.c91dfe2b13c27p-55,
+    0x1.0874518759bc8p+0, 0x1.186be4bb284ffp-57,
+    0x1.09e3ecac6f383p+0, 0x1.1487818316136p-54,
+    0x1.0b5586cf9890fp+0, 0x1.8a62e4adc610bp-54,
+    0x1.0cc922b7247f7p+0, 0x1.01edc16e24f71p-54,
+    0x1.0e3ec32d3d1a2p+0, 0x1.03a1727c57b53p-59,
+    0x1.0fb66affed31bp+0, -0x1.b9bedc44ebd7bp-57,
+    0x1.11301d0125b51p+0, -0x1.6c51039449b3ap-54,
+    0x1.12abdc06c31ccp+0, -0x1.1b514b36ca5c7p-58,
+    0x1.1429aaea92de0p+0, -0x1.32fbf9af1369ep-54,
+    0x1.15a98c8a58e51p+0, 0x1.2406ab9eeab0ap-55,
+    0x1.172b83c7d517bp+0, -0x1.19041b9d78a76p-55,
+    0x1.18af9388c8deap+0, -0x1.11023d1970f6cp-54,
+    0x1.1a35beb6fcb75p+0, 0x1.e5b4c7b4968e4p-55,
+    0x1.1bbe084045cd4p+0, -0x1.95386352ef607p-54,
+    0x1.1d4873168b9aap+0, 0x1.e016e00a2643cp-54,
+    0x1.1ed5022fcd91dp+0, -0x1.1df98027bb78cp-54,
+    0x1.2063b88628cd6p+0, 0x1.dc775814a8495p-55,
+    0x1.21f49917ddc96p+0, 0x1.2a97e9494a5eep-55,
+    0x1.2387a6e756238p+0, 0x1.9b07eb6c70573p-54,
+    0x1.251ce4fb2a63fp+0, 0x1.ac155bef4f4a4p-55,
+    0x1.26b4565e27cddp+0, 0x1.2bd339940e9d9p-55,
+    0x1.284dfe1f56381p+0, -0x1.a4c3a8c3f0d7ep-54,
+    0x1.29e9df51fdee1p+0, 0x1.612e8afad1255p-55,
+    0x1.2b87fd0dad990p+0, -0x1.10adcd6381aa4p-59,
+    0x1.2d285a6e4030bp+0, 0x1.0024754db41d5p-54,
+    0x1.2ecafa93e2f56p+0, 0x1.1ca0f45d52383p-56,
+    0x1.306fe0a31b715p+0, 0x1.6f46ad23182e4p-55,
+    0x1.32170fc4cd831p+0, 0x1.a9ce78e18047cp-55,
+    0x1.33c08b26416ffp+0, 0x1.32721843659a6p-54,
+    0x1.356c55f929ff1p+0, -0x1.b5cee5c4e4628p-55,
+    0x1.371a7373aa9cbp+0, -0x1.63aeabf42eae2p-54,
+    0x1.38cae6d05d866p+0, -0x1.e958d3c9904bdp-54,
+    0x1.3a7db34e59ff7p+0, -0x1.5e436d661f5e3p-56,
+    0x1.3c32dc313a8e5p+0, -0x1.efff8375d29c3p-54,
+    0x1.3dea64c123422p+0, 0x1.ada0911f09ebcp-55,
+    0x1.3fa4504ac801cp+0, -0x1.7d023f956f9f3p-54,
+    0x1.4160a21f72e2ap+0, -0x1.ef3691c309278p-58,
+    0x1.431f5d950a897p+0, -0x1.1c7dde35f7999p-55,
+    0x1.44e086061892dp+0, 0x1.89b7a04ef80d0p-59,
+    0x1.46a41ed1d0057p+0, 0x1.c944bd1648a76p-54,
+    0x1.486a2b5c13cd0p+0, 0x1.3c1a3b69062f0p-56,
+    0x1.4a32af0d7d3dep+0, 0x1.9cb62f3d1be56p-54,
+    0x1.4bfdad5362a27p+0, 0x1.d4397afec42e2p-56,
+    0x1.4dcb299fddd0dp+0, 0x1.8ecdbbc6a7833p-54,
+    0x1.4f9b2769d2ca7p+0, -0x1.4b309d25957e3p-54,
+    0x1.516daa2cf6642p+0, -0x1.f768569bd93efp-55,
+    0x1.5342b569d4f82p+0, -0x1.07abe1db13cadp-55,
+    0x1.551a4ca5d920fp+0, -0x1.d689cefede59bp-55,
+    0x1.56f4736b527dap+0, 0x1.9bb2c011d93adp-54,
+    0x1.58d12d497c7fdp+0, 0x1.295e15b9a1de8p-55,
+    0x1.5ab07dd485429p+0, 0x1.6324c054647adp-54,
+    0x1.5c9268a5946b7p+0, 0x1.c4b1b816986a2p-60,
+    0x1.5e76f15ad2148p+0, 0x1.ba6f93080e65ep-54,
+    0x1.605e1b976dc09p+0, -0x1.3e2429b56de47p-54,
+    0x1.6247eb03a5585p+0, -0x1.383c17e40b497p-54,
+    0x1.6434634ccc320p+0, -0x1.c483c759d8933p-55,
+    0x1.6623882552225p+0, -0x1.bb60987591c34p-54,
+    0x1.68155d44ca973p+0, 0x1.038ae44f73e65p-57,
+};
+
+fn exp2_80(x: f80) f80 {
+    if (exp2Integer(f80, x)) |r| {
+        counters.bump(.exp2_80, .integer);
+        return r;
+    }
+
+    const e: u16 = @intCast(u16, @bitCast(u80, x) >> 64) & 0x7FFF; // exponent
+
+    // 0x1p-64 <= |x| < 8192 with a single unsigned compare, everything else
+    // (including nan, inf and subnormal results) is handled out of line.
+    if (e -% (0x3FFF - 64) >= 64 + 13) {
+        return exp2_80Special(x);
+    }
+    counters.bump(.exp2_80, .normal);
+    return exp2_80Reduced(x);
+}
+
+/// exp2_80() for nan, inf, tiny |x| and |x| >= 8192.
+fn exp2_80Special(x: f80) f80 {
+    @setCold(true);
+
+    // Return canonical NaN for any NaN input.
+    if (math.isNan(x)) {
+        counters.bump(.exp2_80, .special);
+        return math.nan(f80);
+    }
+
+    const e: u16 = @intCast(u16, @bitCast(u80, x) >> 64) & 0x7FFF; // exponent
+
+    // |x| < 0x1p-64
+    if (e < 0x3FFF - 64) {
+        counters.bump(.exp2_80, .tiny);
+        return 1.0 + x;
+    }
+    // x >= 16384
+    if (x >= 16384) {
+        if (x != math.inf_f80) {
+            math.raiseOverflow();
+        }
+        counters.bump(.exp2_80, .overflow);
+        return math.inf_f80;
+    }
+    // x < -16382: the result is subnormal or 0, and inexact, as integers
+    // were handled by exp2Integer()
+    if (x < -16382) {
+        if (x != -math.inf_f80) {
+            math.raiseUnderflow();
+        }
+        if (x <= -16446) {
+            counters.bump(.exp2_80, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp2_80, .edge);
+    return exp2_80Reduced(x);
+}
+
+/// exp2_80() for finite x in (-16446, 16384), without special cases.
+inline fn exp2_80Reduced(x: f80) f80 {
+    const tblsiz: u32 = @intCast(u32, exp2_80_table.len / 2);
+    const redux: f80 = 0x1.8p63 / @intToFloat(f80, tblsiz);
+    // P1 to P6 of exp2_128KernelParts(), rounded to f80
+    const P1: f80 = 0x1.62e42fefa39ef358p-1;
+    const P2: f80 = 0x1.ebfbdff82c58ea86p-3;
+    const P3: f80 = 0x1.c6b08d704a0bf8b4p-5;
+    const P4: f80 = 0x1.3b2ab6fba4e7729cp-7;
+    const P5: f80 = 0x1.5d87fe78a6731108p-10;
+    const P6: f80 = 0x1.430912f86c7876f4p-13;
+
+    // reduce x
+    var u_f: f80 = x + redux;
+    var i_0: u32 = @truncate(u32, @bitCast(u80, u_f));
+    i_0 +%= tblsiz / 2;
+
+    const k_u: u32 = i_0 / tblsiz * tblsiz;
+    const k_i: i32 = @divTrunc(@bitCast(i32, k_u), tblsiz);
+    i_0 %= tblsiz;
+    u_f -= redux;
+    const z: f80 = x - u_f;
+
+    // r = exp2(y) = (hi + lo) * p(z), with the table value extended to
+    // 80 bits so that the polynomial term is computed in full precision
+    const t_hi: f80 = exp2_80_table[@intCast(usize, 2 * i_0)];
+    const t_lo: f80 = exp2_80_table[@intCast(usize, 2 * i_0 + 1)];
+    // zig fmt: off
+    const r: f80 = t_lo + (t_hi + t_lo) * z * (P1 + z * (P2 + z * (P3 + z * (P4
+        + z * (P5 + z * P6))))) + t_hi;
+    // zig fmt: on
 
-    return math.scalbn(r, ik);
+    return math.scalbn(r, k_i);
 }
 
 const exp2_128_table = [_]f128{
@@ -696,10 +1103,17 @@ const exp2_128_eps_table = [exp2_128_table.len]f32{
     0x1.c6e0p-103,
 };
 
-fn exp2_128(x: f128) f128 {
-    const tblsiz: u32 = @intCast(u32, exp2_128_table.len);
-    const redux: f128 = 0x1.8p112 / @intToFloat(f128, tblsiz);
+/// Returns 2^((i - N/2) / N + z) for table index i of the N-entry
+/// exp2_128_table, with |z| <= 1/(2N). Shared with exp10.
+pub fn exp2_128Kernel(i: u32, z: f128) f128 {
+    const p = exp2_128KernelParts(i, z);
+    return p.hi + p.lo;
+}
 
+/// exp2_128Kernel() before the final addition. The table entries are accurate
+/// to 2^-122 and the polynomial to 2^-120, so the sum is within 2^-118
+/// (relative) of the exact result. misc/directed_bounds.py derives 2^-119.42.
+pub fn exp2_128KernelParts(i: u32, z_: f128) Exp2Parts(f128) {
     const P1: f128 = 0x1.62e42fefa39ef35793c7673007e6p-1;
     const P2: f128 = 0x1.ebfbdff82c58ea86f16b06ec9736p-3;
     const P3: f128 = 0x1.c6b08d704a0bf8b33a762bad3459p-5;
@@ -711,40 +1125,91 @@ fn exp2_128(x: f128) f128 {
     const P9: f64 = 0x1.b52541ff59713p-24;
     const P10: f64 = 0x1.e4cf56a391e22p-28;
 
+    // r = exp2(y) = exp2t[i] * p(z - eps[i])
+    const t: f128 = exp2_128_table[@intCast(usize, i)];
+    const z: f128 = z_ - exp2_128_eps_table[@intCast(usize, i)];
+    // zig fmt: off
+    return .{
+        .hi = t,
+        .lo = t * z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * (P5
+            + z * (P6 + z * (P7 + z * (P8 + z * (P9 + z * P10))))))))),
+    };
+    // zig fmt: on
+}
+
+pub const exp2_128_tblsiz = exp2_128_table.len;
+
+fn exp2_128(x: f128) f128 {
+    if (exp2Integer(f128, x)) |r| {
+        counters.bump(.exp2_128, .integer);
+        return r;
+    }
+
+    const e: u16 = @intCast(u16, @bitCast(u128, x) >> 112) & 0x7FFF; // exponent
+
+    // 0x1p-114 <= |x| < 16384 with a single unsigned compare, everything else
+    // (including nan and inf) is handled out of line.
+    if (e -% (0x3FFF - 114) >= 114 + 14) {
+        return exp2_128Special(x);
+    }
+    counters.bump(.exp2_128, .normal);
+    return exp2_128Reduced(x);
+}
+
+/// exp2_128() for nan, inf, tiny |x| and |x| >= 16384.
+fn exp2_128Special(x: f128) f128 {
+    @setCold(true);
+
     // Return canonical NaN for any NaN input.
     if (math.isNan(x)) {
+        counters.bump(.exp2_128, .special);
         return math.nan(f128);
     }
 
     const ux = @bitCast(u128, x);
     const e: u16 = @intCast(u16, ux >> 112) & 0x7FFF; // exponent
 
-    // |x| >= 16384 or nan
-    if (e >= 0x3FFF + 14) {
-        // x >= 16384
-        if (e >= 0x3FFF + 15 and ux >> 127 == 0) {
-            math.raiseOverflow();
-            return math.inf(f128);
-        }
-        // -inf or nan
-        if (e == 0x7FFF) {
-            return -1 / x;
-        }
-        // x <= -1022
-        if (x < -16382) {
-            // underflow
-            if (x <= -16495 or x - 0x1p112 + 0x1p112 != x) {
-                math.doNotOptimizeAway(@floatCast(f32, -0x1.0p-149 / x));
-            }
-            if (x <= -16495) {
-                return 0;
-            }
-        }
-    }
     // |x| < 0x1p-114
-    else if (e < 0x3FFF - 114) {
+    if (e < 0x3FFF - 114) {
+        counters.bump(.exp2_128, .tiny);
         return 1.0 + x;
     }
+    // x >= 16384
+    if (e >= 0x3FFF + 15 and ux >> 127 == 0) {
+        math.raiseOverflow();
+        counters.bump(.exp2_128, .overflow);
+        return math.inf(f128);
+    }
+    // -inf
+    if (e == 0x7FFF) {
+        counters.bump(.exp2_128, .underflow);
+        return -1 / x;
+    }
+    // x < -16382
+    if (x < -16382) {
+        // underflow
+        if (math.fp_exceptions and (x <= -16495 or x - 0x1p112 + 0x1p112 != x)) {
+            math.doNotOptimizeAway(@floatCast(f32, -0x1.0p-149 / x));
+        }
+        if (x <= -16495) {
+            counters.bump(.exp2_128, .underflow);
+            return 0;
+        }
+    }
+    counters.bump(.exp2_128, .edge);
+    return exp2_128Reduced(x);
+}
+
+/// exp2_128() for finite x in (-16495, 16384), without special cases.
+inline fn exp2_128Reduced(x: f128) f128 {
+    const red = exp2_128Reduce(x);
+    return math.scalbn(exp2_128Kernel(red.i, red.z), red.k);
+}
+
+/// Reduces finite x in (-16495, 16384) for exp2_128Kernel().
+pub fn exp2_128Reduce(x: f128) Exp2Reduced(f128) {
+    const tblsiz: u32 = @intCast(u32, exp2_128_table.len);
+    const redux: f128 = 0x1.8p112 / @intToFloat(f128, tblsiz);
 
     // NOTE: musl relies on unsafe behaviours which are replicated below
     // (addition overflow, division truncation, casting). Appears that this
@@ -760,25 +1225,340 @@ fn exp2_128(x: f128) f128 {
     const k_i: i32 = @divTrunc(@bitCast(i32, k_u), tblsiz);
     i_0 %= tblsiz;
     u_f -= redux;
-    var z: f128 = x - u_f;
 
-    // r = exp2(y) = exp2t[i_0] * p(z - eps[i])
-    const t: f128 = exp2_128_table[@intCast(usize, i_0)];
-    z -= exp2_128_eps_table[@intCast(usize, i_0)];
-    // zig fmt: off
-    const r: f128 = t + t * z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * (P5
-        + z * (P6 + z * (P7 + z * (P8 + z * (P9 + z * P10)))))))));
-    // zig fmt: on
+    return .{ .i = i_0, .k = k_i, .z = x - u_f };
+}
 
-    return math.scalbn(r, k_i);
+// The f128 kernel in fixed point
+// ---------------------------------
+//
+// exp2_128() does the reduction, table lookup and polynomial in soft float
+// f128, where every operation unpacks, normalizes and rounds. For the normal
+// range, exp2_128Fixed() instead splits x into integer and fraction with
+// shifts of its bits, evaluates 2^fraction in 128-bit fixed point with
+// mulWide(u64) products and packs the result once.
+//
+// With the fraction f = i/N + r for r in [0, 1/N), 2^f = 2^(i/N) * p(r),
+// where p is the Taylor polynomial of 2^r. The table, the coefficients and
+// p(r) are in 1.127 fixed point, the products truncate, and the result is
+// within 2^-123 (relative) of 2^x before the final rounding. An ulp is at
+// least 2^-113 of the result, so that is at most 2^-10 ulp, and the result is
+// off by at most 0.501 ulp.
+
+/// 2^(i/N) in 1.127 fixed point, rounded to nearest.
+const exp2_128_fixed_table = [_]u128{
+    0x80000000000000000000000000000000, 0x8058d7d2d5e5f6b094d589f608ee4aa2,
+    0x80b1ed4fd999ab6c25335719b6e6fd20, 0x810b40a1d81406d40cef03ab14a66550,
+    0x8164d1f3bc0307737be56527bd14def5, 0x81bea1708dde6055a047bab784691314,
+    0x8218af4373fc25eb9c7cd106d23f3768, 0x8272fb97b2a5894c3793aa0d08c818fb,
+    0x82cd8698ac2ba1d73e2a475b46520bff, 0x83285071e0fc454690950cc78d29f057,
+    0x8383594eefb6ee36e201d4ec3d93f684, 0x83dea15b9541b132334544586ffe6d47,
+    0x843a28c3acde40461af92eca13fd1582, 0x8495efb3303efd2ff38ffeb805e1418a,
+    0x84f1f656379c1a290f03062c26b5ba5d, 0x854e3cd8f9c8c95d16c873d1d378c1ca,
+    0x85aac367cc487b14c5c95b8c2154c1b2, 0x86078a2f23642a9f3120da439de139d7,
+    0x8664915b923fba03db82dc49ee2f4556, 0x86c1d919caef5c87d6437819d2bd2d28,
+    0x871f61969e8d10103a1727c57b52a956, 0x877d2afefd4e256c48c8757fbc915a95,
+    0x87db357ff698d7919048eec50a1328a7, 0x88398146b919f1d46eb1692fdd53eae0,
+    0x88980e8092da85275df8d76c98c67563, 0x88f6dd5af155ac6b75611f8091c09a2a,
+    0x8955ee03618e5fdc95d69926b4717b94, 0x89b540a7902557a3bdc116dc8c41c9a5,
+    0x8a14d575496efd9a080ca1d92c3680c2, 0x8a74ac9a79896e46e17c640bb54a0880,
+    0x8ad4c6452c72892406ab9eeab09dfc95, 0x8b3522a38e1e1031e47705d43464e763,
+    0x8b95c1e3ea8bd6e6fbe4628758a53c90, 0x8bf6a434adde0084f1ff1562d3210f95,
+    0x8c57c9c4646f4dddfb85cd1e1282e4be, 0x8cb932c1bae97a955bb0be2fc1058a5a,
+    0x8d1adf5b7e5ba9e5b4c7b4968e41ad36, 0x8d7ccfc09c50e2f7f0b496d24ffd47a7,
+    0x8ddf042022e69cd58f395a213f1afcd6, 0x8e417ca940e35a012ef0021f191cf149,
+    0x8ea4398b45cd53c02dc0144c8783d4c6, 0x8f073af5a201352044feee692437dd30,
+    0x8f6a8117e6c8e5c40cffb0890e8f2827, 0x8fce0c21c67264815b6bed0a147a1e4a,
+    0x9031dc431466b1dc775814a8494e87e2, 0x9095f1abc540ca6b25a59f95591d3369,
+    0x90fa4c8beee4b12a97e9494a5eda5b0f, 0x915eed13c89689d34fb5577d69ec8f1c,
+    0x91c3d373ab11c3360fd6d8e0ae5ac9d8, 0x9228ffdc10a051acfcc911ca996308c7,
+    0x928e727d9531f9ac155bef4f4a408d4e, 0x92f42b88f673aa7c34495863658add37,
+    0x935a2b2f13e6e92bd339940e9d924ee7, 0x93c071a0eef94bc0cf80bf3ced7215a4,
+    0x9426ff0fab1c04b678ae781e504b3fed, 0x948dd3ac8ddb7ed338dd7bfe34302f47,
+    0x94f4efa8fef709612e8afad12551de54, 0x955c5336887894d5179cdd2deb188865,
+    0x95c3fe86d6cc7feef52329c7e55c4221, 0x962bf1cbb8d9755fd74b2295db70edd2,
+    0x96942d3720185a0048ea9b683a9c22c5, 0x96fcb0fb20ac4ba2d9ff779c3306ab72,
+    0x97657d49f17ab08e507a2ea91c19d7b1, 0x97ce9255ec4357ab0eaab35095b52861,
+    0x9837f0518db8a96f46ad23182e42f6f6, 0x98a1976f7597e9959a3f3f3fcd09b8c5,
+    0x990b87e266c189a9ce78e18047c36ef2, 0x9975c1dd47518c7742f869619cf2439c,
+    0x99e0459320b7fa64e43086cb34b5fcaf, 0x9a4b13371fd166ca58a6cf77e5beb8a5,
+    0x9ab62afc94ff864a311a3b1b9d79c6b7, 0x9b218d16f441d63cebb5f9347a27e2ec,
+    0x9b8d39b9d54e5538a2a817a2a3cc3f1f, 0x9bf93118f3aa4cc146ac2629b8815747,
+    0x9c6573682ec32c2d4e586cdf686429df, 0x9cd200db8a0774cacb406e3ad9773804,
+    0x9d3ed9a72cffb750de494cf050e99b0b, 0x9dabfdff6367a2a98cdc4dffe30eb47c,
+    0x9e196e189d47242000f9145ac79bbaf0, 0x9e872a276f0b98ff46846142638811ba,
+    0x9ef5326091a111ada0911f09ebb9fdd1, 0x9f6386f8e28ba65099c84736435e6432,
+    0x9fd228256400dd05fb80d520c197dc61, 0xa041161b3d0121bddf8b6f4d0484a2c7,
+    0xa0b0510fb9714fc2192dc79edb0fd9a9, 0xa11fd9384a344cf73a47e99d64571a93,
+    0xa18faeca8544b6e38221ca08667640f1, 0xa1ffd1fc25cea1880be9704c0029ada6,
+    0xa27043030c4968189b7a04ef80cfdea8, 0xa2e102153e918f9e6f99f41381c73d2e,
+    0xa3520f68e802bb92897a2c914ecbefa0, 0xa3c36b345991b47be1e25775199c692a,
+    0xa43515ae09e6809e0d1db4831781e1ef, 0xa4a70f0c95768ec4d76a1b661607d701,
+    0xa5195786be9ef3396c5e7a37cac3230f, 0xa58bef536dbeb6eda4780d7681030488,
+    0xa5fed6a9b15138ea1cbd7f621710701b, 0xa6720dc0be08a20bc52d2157ab991a23,
+    0xa6e594cfeee86b1d9b778d4f06624259, 0xa7596c0ec55ff55b505a3450b5b8623c,
+    0xa7cd93b4e96535699ec5b4d5039f72af, 0xa8420bfa298f70d124da4dba32f60bd9,
+    0xa8b6d5167b320e0897a96426c110c874, 0xa92bef41fa77771b3395e0808475ed17,
+    0xa9a15ab4ea7c0ef8541e24ec3531fa73, 0xaa1717a7b569397926d192d5f7dddb31,
+    0xaa8d2652ec90762976310121a6533932, 0xab0386ef48868de0923d2e22820c8895,
+    0xab7a39b5a93ed337658023b2759e0079, 0xabf13edf162675e8ce6eb508c771633b,
+    0xac6896a4be3fe9295e15b9a1de79764a, 0xace0413ff83e5d03a62373033e27431e,
+    0xad583eea42a14ac64980a8c8f59a2ec4, 0xadd08fdd43d014910bd67b983cca3b70,
+    0xae493452ca35b80e258dc0b4c35101ec, 0xaec22c84cc5c94652b0ae97537a936e8,
+    0xaf3b78ad690a4374df26101ccbb35033, 0xafb51906e75b86615221c32306e4386a,
+    0xb02f0dcbb6e04583b7ac9524371d9a75, 0xb0a957366fb7a3c967c9570984dea5c3,
+    0xb123f581d2ac258f87d037e96d215d8e, 0xb19ee8e8c94feb08e217d72c9cab9711,
+    0xb21a31a66618fe3b7c38a6276cd27208, 0xb295cff5e47db4a38546cb183ee9fed3,
+    0xb311c412a91124893ecf14dc798a519c, 0xb38e0e38419fae178cda7939ecc7d67a,
+    0xb40aaea2654b9840e2b913dcf9938360, 0xb487a58cf4a9c1804bd9aeb445c9c1c5,
+    0xb504f333f9de6484597d89b3754abe9f, 0xb58297d3a8b9f0d1c7a964d4e87196bc,
+    0xb60093a85ed5f76bb54cc007a799fef6, 0xb67ee6eea3b22b8f5536de2e611e77f3,
+    0xb6fd91e328d1779107165f0ddd541a5a, 0xb77c94c2c9d725e8d16c3ca6e9bcae4a,
+    0xb7fbefca8ca41e7c3f0da79f109dffce, 0xb87ba337a1743833ac89a8b54cbd898d,
+    0xb8fbaf4762fb9ee91b879778566b65a2, 0xb97c143756844dbeabfa653a71b9dc81,
+    0xb9fcd2452c0b9deae4d27345588c1571, 0xba7de9aebe5fea08ffac314dc38da102,
+    0xbaff5ab2133e45fb74d519d24593838c, 0xbb81258d5b704b6f0ee2d228feff0a32,
+    0xbc034a7ef2e9fb0cd7014042c595d95f, 0xbc85c9c560e7b269350c555ba7bde9df,
+    0xbd08a39f580c36bea8811fb66d0faf7a, 0xbd8bd84bb67ed482894f72e46efb3f23,
+    0xbe0f6809860993e2499a22c9bab1596e, 0xbe935317fc378237bb7f6e57167312d1,
+    0xbf1799b67a731082e815d0abcbf0b851, 0xbf9c3c248e2486f80ee306cee52467c3,
+    0xc0213aa1f0d08db06f33b24d1aa75383, 0xc0a6956e8836ca8c86e1a2a3a9ae34a7,
+    0xc12c4cca667094567c457d59a50087b5, 0xc1b260f5ca0fbb3373463be57aa79440,
+    0xc238d2311e3d667297b5cbe3204a9b88, 0xc2bfa0bcfad907c8b16e0e9bd260d2c7,
+    0xc346ccda2497640720ec856128b83a42, 0xc3ce56c98d21b15d2d7d2db47bcd0d31,
+    0xc4563ecc5334cb32985e6f96a74eb094, 0xc4de8523c2c07baa72a88ea405500139,
+    0xc5672a115506dadd3e2ad0c964dd9f37, 0xc5f02dd6b0bbc3d96bdf88688dcf2779,
+    0xc67990b5aa245f79550e68b0e2aec255, 0xc70352f04336c51dd6b206c9a348e8b1,
+    0xc78d74c8abb9b15cc13a2e3976c0277e, 0xc817f681416452b25950bfc7fa4cd576,
+    0xc8a2d85c8ffe2c4530da34fb5b8700e1, 0xc92e1a9d517f0ecbaa059c6248097ed9,
+    0xc9b9bd866e2f27a280e1f92a0511697e, 0xca45c15afcc72623c298682d266ad65f,
+    0xcad2265e4290774da41b4ad07e37be3f, 0xcb5eecd3b38597c8b4d301cc6ed4e242,
+    0xcbec14fef2727c5cf4907c8f45ebf6dd, 0xcc799f23d11510e55ed51263c7641a28,
+    0xcd078b86503dcdd1884dc62339bdf58d, 0xcd95da6a9ff06444f63641255d03ecfd,
+    0xce248c151f8480e3e235838f95f2c6ed, 0xceb3a0ca5dc6a55d282b844fb99d5cc9,
+    0xcf4318cf191918c12653c7326370087d, 0xcfd2f4683f94eeb5631550e053253c3a,
+    0xd06333daef2b2594d6d45c6559a4d502, 0xd0f3d76c75c5db8cc31dd17ce1cdbf98,
+    0xd184df6251699ac60b8fbb86d56aa3fd, 0xd2164c023056bcab0ff4ec09dbf148b1,
+    0xd2a81d91f12ae45a12248e57c3de4028, 0xd33a5457a30290543d58c19c0d98dc35,
+    0xd3ccf099859ac3796fd958ac78d4c3cb, 0xd45ff29e0972c560f309a8bd4ae80f87,
+    0xd4f35aabcfedfa1f5921deffa6262c5b, 0xd5872909ab75d189c31dae94544ca179,
+    0xd61b5dfe9f9bce06dcb3518932fe39f2, 0xd6aff9d1e13ba2fde776d6371c9672d5,
+    0xd744fccad69d6af439a68bb9902d3fde, 0xd7da67311797f569a07e19d426692969,
+    0xd870394c6db32c8421566fe37b65072f, 0xd9067364d44a929ba04940ead973be13,
+    0xd99d15c278afd7b5fe873deca3e12bac, 0xda3420adba4d87044e10b1041b7ec1ac,
+    0xdacb946f2ac9cc71c40888b2439e38b9, 0xdb63714f8e2952551e6a5107edc5e87c,
+    0xdbfbb797daf237553d840d5a9e29aa64, 0xdc9467913a4f1c91bd35669347454448,
+    0xdd2d818508324c20659e357ada3f94b9, 0xddc705bcd378f7f056971b4b4efd6e4b,
+    0xde60f4825e0e9123dd07a2d9e8466859, 0xdefb4e1f9d1037f1ecee4f8ad256c9ab,
+    0xdf9612deb8f0442046b8128c71a24fd0, 0xe031430a0d99e6275a55e0435cbd2054,
+    0xe0ccdeec2a94e111065895048dd333ca, 0xe168e6cfd3295d235d3d06eb451d4a1e,
+    0xe2055afffe83d368a6fc1078c14529b3, 0xe2a23bc7d7d91225e0e49276b5e5d8d4,
+    0xe33f8972be8a5a5109bfe90795980eed, 0xe3dd444c4649961894441daaaa6db8cf,
+    0xe47b6ca0373da88d65e24402e2216edb, 0xe51a02ba8e26d680d412ef2f70b028a4,
+    0xe5b906e77c8348a81e5e8f4a4edbb0ed, 0xe658797368b3a716ef83cffb7b6bc085,
+    0xe6f85aaaee1fce227c4ac7d628df28b0, 0xe798aadadd5b9cbee2c8f240151d1780,
+    0xe8396a503c4bdc68791790d0ac70c7de, 0xe8da9958464b42aac6c43346ddb3498d,
+    0xe97c38406c4f8c56f091cc4f51012da6, 0xea1e4756550eb27b6a77eb42c28a105f,
+    0xeac0c6e7dd24392ed02d75b3706e54fb, 0xeb63b7431736983fd0f49502cb40362e,
+    0xec0718b64c1cbddc27ce824402fc25f6, 0xecaaeb8ffb03ab40a5b7735ed7c986e3,
+    0xed4f301ed9942b84600d2db6a64bfb12, 0xedf3e6b1d418a49121cdb28e8377be38,
+    0xee990f980da3025b4aef1e031851c991, 0xef3eab20e032bc6b55ae30c8ae253e7f,
+    0xefe4b99bdcdaf5cb46561cf6948db913, 0xf08b3b58cbe8b76a56b2151c05e270c6,
+    0xf13230a7ad0945093b0fd0bd6d3233f4, 0xf1d999d8b7708cc16b79c0472eac5c37,
+    0xf281773c59ffb139e8980a9cc8f47a4b, 0xf329c9233b6bae9c0078add48cb237c0,
+    0xf3d28fde3a641a5aa4594191bc33ac54, 0xf47bcbbe6db9fddeed6fe9f569e4c1ac,
+    0xf5257d152486cc2c7b9d0c7aed980fc3, 0xf5cfa433e653729065e4527c9e33781e,
+    0xf67a416c733f846d81897dca4e77a310, 0xf7255510c4288238d1b490ead1a26392,
+    0xf7d0df730ad13bb8fe90d496d60fb6eb, 0xf87ce0e5b2094d9bbff35cfc575603f7,
+    0xf92959bb5dd4ba7434b7e1b1c86a6357, 0xf9d64a46eb939f352d2e093e4110a051,
+    0xfa83b2db722a033a7c25bb14315d7fcd, 0xfb3193cc4227c3f46f66a72687c5c9a9,
+    0xfbdfed6ce5f09c489da5ff395ecae2e7, 0xfc8ec01121e447bb455d621825da76ce,
+    0xfd3e0c0cf486c174853f3a5931e0ee03, 0xfdedd1b496a89f34c46757b38a53619b,
+    0xfe9e115c7b8f884badd25995e79d2f09, 0xff4ecb59511ec8a5301ba217ef18dd7c,
+};
+
+/// ln(2)^j / j! in 1.127 fixed point, the Taylor coefficients of 2^r. Degree
+/// 11 truncates 2^r to within 2^-131 for r < 1/N.
+const exp2_128_fixed_poly = [_]u128{
+    0x80000000000000000000000000000000, // ln(2)^0/0!
+    0x58b90bfbe8e7bcd5e4f1d9cc01f97b58, // ln(2)^1/1!
+    0x1ebfbdff82c58ea86f16b06ec9735fcb, // ln(2)^2/2!
+    0x071ac235c1282fe2cce9d8aeccaf4b7c, // ln(2)^3/3!
+    0x013b2ab6fba4e7729ccbbe0b53eeac50, // ln(2)^4/4!
+    0x002bb0ffcf14ce6220e2fed34a297d86, // ln(2)^5/5!
+    0x00050c244be1b1e1dbd2c2a261ac8d08, // ln(2)^6/6!
+    0x00007ff2ff1622c31a1ac547321f639a, // ln(2)^7/7!
+    0x00000b160111d2e411fec7ff3036d3be, // ln(2)^8/8!
+    0x000000da929e9caf3e1ed253872d27fd, // ln(2)^9/9!
+    0x0000000f267a8ac5c764fb7ed0eca974, // ln(2)^10/10!
+    0x00000000f465639a8dd92607abccaf24, // ln(2)^11/11!
+};
+
+/// The high half of the 256-bit product a * b, without the product of the
+/// low halves, so up to 3 below floor(a * b / 2^128).
+inline fn mulHiFixed(a: u128, b: u128) u128 {
+    const a_hi = @truncate(u64, a >> 64);
+    const a_lo = @truncate(u64, a);
+    const b_hi = @truncate(u64, b >> 64);
+    const b_lo = @truncate(u64, b);
+    return math.mulWide(u64, a_hi, b_hi) +
+        (math.mulWide(u64, a_hi, b_lo) >> 64) +
+        (math.mulWide(u64, a_lo, b_hi) >> 64);
+}
+
+/// Returns 2^x like exp2() for f128, but evaluated in integer fixed point
+/// arithmetic on the bits of x. The result is the correctly rounded one or,
+/// rarely, its neighbour.
+///
+/// Arguments outside the normal range and subnormal results take the paths of
+/// exp2_128(), and are counted under its kernel.
+///
+/// exp2() for f128 still uses exp2_128(). This kernel avoids the soft float
+/// operations, but it hasn't been timed against exp2_128() yet (see
+/// bench/exp2.zig), so there is no measurement to switch on.
+pub fn exp2_128Fixed(x: f128) f128 {
+    if (exp2Integer(f128, x)) |r| {
+        counters.bump(.exp2_128_fixed, .integer);
+        return r;
+    }
+
+    const ux = @bitCast(u128, x);
+    const e: u16 = @intCast(u16, ux >> 112) & 0x7FFF; // exponent
+
+    // 0x1p-114 <= |x| < 16384, as in exp2_128()
+    if (e -% (0x3FFF - 114) >= 114 + 14) {
+        return exp2_128Special(x);
+    }
+
+    // |x| = n + f, with the fraction f in 0.128 fixed point. f is exact for
+    // |x| >= 2^-16 and truncated to 2^-128 below that.
+    const m = (ux & ((1 << 112) - 1)) | (1 << 112);
+    const s = @as(i32, e) - 0x3FFF; // in [-114, 13]
+    var n: i32 = 0;
+    var f: u128 = undefined;
+    if (s >= -16) {
+        f = m << @intCast(u7, 16 + s);
+        if (s >= 0) {
+            n = @intCast(i32, m >> @intCast(u7, 112 - s));
+        }
+    } else {
+        f = m >> @intCast(u7, -16 - s);
+    }
+
+    // 2^x = 2^k * 2^f with f in [0, 1)
+    var k = n;
+    if (ux >> 127 != 0) {
+        // 2^-(n + f) = 2^(-n - 1) * 2^(1 - f), f isn't 0 as x isn't an integer
+        k = -n - 1;
+        f = -%f;
+        // The result may be subnormal.
+        if (k < -16382) {
+            counters.bump(.exp2_128_fixed, .edge);
+            return exp2_128Reduced(x);
+        }
+    }
+    counters.bump(.exp2_128_fixed, .normal);
+
+    const tblsiz_bits = comptime math.log2_int(usize, exp2_128_fixed_table.len);
+    const i = @intCast(usize, f >> (128 - tblsiz_bits));
+    const r = f & ((1 << (128 - tblsiz_bits)) - 1);
+
+    // p(r) by Horner's rule, in [1, 2^(1/N))
+    const poly = exp2_128_fixed_poly;
+    var p: u128 = poly[poly.len - 1];
+    comptime var j = poly.len - 1;
+    inline while (j > 0) {
+        j -= 1;
+        p = poly[j] + mulHiFixed(p, r);
+    }
+
+    // 2^(i/N) * p(r) in 2.126 fixed point, in [1, 2^(1 + 1/N)), so the leading
+    // bit is bit 127 or 126.
+    var y = mulHiFixed(exp2_128_fixed_table[i], p);
+    const lz = @clz(u128, y);
+    y <<= @intCast(u7, lz);
+
+    // Round to 113 bits, to nearest even.
+    var mant = y >> 15;
+    const rest = @truncate(u15, y);
+    if (rest > 0x4000 or (rest == 0x4000 and mant & 1 != 0)) {
+        mant += 1;
+    }
+
+    // The leading bit of mant adds 1 to the exponent field, as does a carry
+    // out of the rounding.
+    const ue = @intCast(u128, k + 0x3FFF - @as(i32, lz)) << 112;
+    const bits = ue + mant;
+    // A carry out of the rounding of the largest results would give inf.
+    if (bits >= 0x7FFF << 112) {
+        math.raiseOverflow();
+    }
+    math.raiseInexact();
+    return @bitCast(f128, bits);
+}
+
+fn exp2Comptime(comptime x: comptime_float) comptime_float {
+    comptime {
+        @setEvalBranchQuota(10_000);
+        // The out of range paths in exp2_128() raise exceptions, which can't be
+        // evaluated at compile time.
+        if (x >= 16384) {
+            @compileError("exp2 overflows for comptime_float argument");
+        }
+        if (x <= -16495) {
+            return 0;
+        }
+        return exp2_128Reduced(x);
+    }
 }
 
 test "math.exp2() delegation" {
     try expect(exp2(@as(f32, 0.8923)) == exp2_32(0.8923));
     try expect(exp2(@as(f64, 0.8923)) == exp2_64(0.8923));
+    try expect(exp2(@as(f80, 0.8923)) == exp2_80(0.8923));
     try expect(exp2(@as(f128, 0.8923)) == exp2_128(0.8923));
 }
 
+test "math.exp2() comptime" {
+    const a = comptime exp2(0.8923);
+    try expect(@as(f128, a) == exp2_128(0.8923));
+    try expect(comptime exp2(-16400.0) == 0x1p-16400);
+    try expect(comptime exp2(16383.5) == exp2_128(16383.5));
+    try expect(comptime exp2(-16500.0) == 0);
+}
+
+test "math.exp2() integer" {
+    try expect(exp2_32(1) == 2);
+    try expect(exp2_32(-3) == 0.125);
+    try expect(exp2_32(127) == 0x1p127);
+    try expect(exp2_32(-126) == 0x1p-126);
+    try expect(exp2_32(-149) == 0x1p-149);
+    try expect(exp2Integer(f32, 128) == null);
+    try expect(exp2Integer(f32, -150) == null);
+    try expect(exp2Integer(f32, 1.5) == null);
+    try expect(exp2Integer(f32, 0) == null);
+
+    try expect(exp2_64(1023) == 0x1p1023);
+    try expect(exp2_64(-1022) == 0x1p-1022);
+    try expect(exp2_64(-1074) == 0x1p-1074);
+    try expect(exp2Integer(f64, 1024) == null);
+    try expect(exp2Integer(f64, 1023.5) == null);
+
+    try expect(exp2_80(16383) == 0x1p16383);
+    try expect(exp2_80(-16382) == 0x1p-16382);
+    try expect(exp2_80(-16445) == 0x1p-16445);
+    try expect(exp2Integer(f80, 16384) == null);
+    try expect(exp2Integer(f80, -16446) == null);
+    try expect(exp2Integer(f80, 0.5) == null);
+
+    try expect(exp2_128(16383) == 0x1p16383);
+    try expect(exp2_128(-16382) == 0x1p-16382);
+    try expect(exp2_128(-16494) == 0x1p-16494);
+    try expect(exp2Integer(f128, 16384) == null);
+    try expect(exp2Integer(f128, -16495) == null);
+    try expect(exp2Integer(f128, 1 + 0x1p-112) == null);
+}
+
 test "math.exp2_32() basic" {
     const epsilon = 0.000001;
 
@@ -800,6 +1580,19 @@ test "math.exp2_64() basic" {
     try expect(math.approxEqAbs(f64, exp2_64(-1), 0.5, epsilon));
 }
 
+test "math.exp2_80() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp2_80(0.0) == 1.0);
+    try expect(math.approxEqAbs(f80, exp2_80(0.2), 1.148698, epsilon));
+    try expect(math.approxEqAbs(f80, exp2_80(0.8923), 1.856133, epsilon));
+    try expect(math.approxEqAbs(f80, exp2_80(1.5), 2.828427, epsilon));
+    try expect(math.approxEqAbs(f80, exp2_80(-1), 0.5, epsilon));
+    try expect(exp2_80(64) == 0x1p64);
+    try expect(exp2_80(math.inf_f80) == math.inf_f80);
+    try expect(exp2_80(-math.inf_f80) == 0);
+}
+
 test "math.exp2_128() basic" {
     const epsilon = 0.000001;
 
@@ -810,6 +1603,58 @@ test "math.exp2_128() basic" {
     try expect(math.approxEqAbs(f128, exp2_128(-1), 0.5, epsilon));
 }
 
+test "math.exp2() fast path boundaries" {
+    // Arguments either side of the single compare gates, which are handled in
+    // and out of line, must agree with the f128 result.
+    const bits32 = [_]u32{ 0x33000000, 0x33000001, 0x42FC0000, 0x42FC0001 };
+    for (bits32) |u| {
+        for ([_]f32{ 1, -1 }) |sign| {
+            const x = sign * @bitCast(f32, u);
+            const y = @floatCast(f32, exp2_128(x));
+            try expect(math.approxEqRel(f32, exp2_32(x), y, 1e-6));
+        }
+    }
+    const bits64 = [_]u64{ 0x3C8FFFFFFFFFFFFF, 0x3C90000000000000, 0x408FEFFFFFFFFFFF, 0x408FF00000000001 };
+    for (bits64) |u| {
+        for ([_]f64{ 1, -1 }) |sign| {
+            const x = sign * @bitCast(f64, u);
+            const y = @floatCast(f64, exp2_128(x));
+            try expect(math.approxEqRel(f64, exp2_64(x), y, 1e-15));
+        }
+    }
+    for ([_]f80{ 0x1.8p-65, 0x1.8p-64, 16383.5, -16383.5 }) |x| {
+        const y = @floatCast(f80, exp2_128(x));
+        try expect(math.approxEqRel(f80, exp2_80(x), y, 1e-18));
+    }
+}
+
+test "math.exp2_128Fixed()" {
+    try expect(@bitCast(u128, exp2_128Fixed(0.5)) == 0x3FFF6A09E667F3BCC908B2FB1366EA95);
+    try expect(@bitCast(u128, exp2_128Fixed(-0.75)) == 0x3FFE306FE0A31B7152DE8D5A46305C86);
+    try expect(@bitCast(u128, exp2_128Fixed(-16381.5)) == 0x00016A09E667F3BCC908B2FB1366EA95);
+    try expect(@bitCast(u128, exp2_128Fixed(16383.75)) == 0x7FFEAE89F995AD3AD5E8734D1773205A);
+    try expect(exp2_128Fixed(3) == 8);
+    try expect(exp2_128Fixed(0x1p-120) == 1);
+    try expect(exp2_128Fixed(-16382.5) == exp2_128(-16382.5));
+    try expect(exp2_128Fixed(16384) == math.inf(f128));
+    try expect(exp2_128Fixed(-math.inf(f128)) == 0);
+    try expect(math.isNan(exp2_128Fixed(math.nan(f128))));
+
+    // Within an ulp of the soft float kernel, on both sides of 0 and across
+    // the exponents of x.
+    var prng = std.rand.DefaultPrng.init(0x9E3779B97F4A7C15);
+    const random = prng.random();
+    var n: usize = 0;
+    while (n < 10000) : (n += 1) {
+        const sign = @as(u128, random.int(u1)) << 127;
+        const e = random.intRangeAtMost(u128, 0x3FFF - 114, 0x3FFF + 13);
+        const x = @bitCast(f128, sign | e << 112 | random.int(u112));
+        const a = @bitCast(u128, exp2_128Fixed(x));
+        const b = @bitCast(u128, exp2_128(x));
+        try expect(a -% b +% 1 <= 2);
+    }
+}
+
 pub fn main() !void {
     try @import("util.zig").singleInputFuncMain(exp2);
 }
@@ -0,0 +1,89 @@
+// The 128-bit implementation reuses the exp128() reduction, in the same way as
+// FreeBSD's ld128 expm1l() shares its table with expl():
+// https://cgit.freebsd.org/src/tree/lib/msun/ld128/s_expl.c
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const exp_mod = @import("exp.zig");
+
+/// Returns e raised to the power of x, minus 1 (e^x - 1). This is more
+/// accurate than exp(x) - 1 when x is near 0.
+///
+/// Special Cases:
+///  - expm1(+inf) = +inf
+///  - expm1(-inf) = -1
+///  - expm1(nan)  = nan
+pub fn expm1(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64 => std.math.expm1(x),
+        f128 => expm1_128(x),
+        else => @compileError("expm1 not implemented for " ++ @typeName(T)),
+    };
+}
+
+pub fn expm1_128(x: f128) f128 {
+    const ux = @bitCast(u128, x);
+    const e: u16 = @intCast(u16, ux >> 112) & 0x7FFF; // exponent
+
+    if (math.isNan(x)) {
+        return math.nan(f128);
+    }
+    if (x > exp_mod.exp128_o_threshold) {
+        // overflow if x != inf
+        if (!math.isInf(x)) {
+            math.raiseOverflow();
+        }
+        return math.inf(f128);
+    }
+    // e^x < 2^-115 so the result rounds to -1 (includes x == -inf)
+    if (x < -80) {
+        return -1;
+    }
+    // |x| < 0x1p-114
+    if (e < 0x3FFF - 114) {
+        return x;
+    }
+
+    // e^x - 1 = 2^k * (hi + lo) - 1.
+    // The table 'hi' values have at most 89 significant bits, so for
+    // |k| <= 24 the subtraction 2^k * hi - 1 is exact and there is no
+    // cancellation to lose precision to. This also covers the n == 0 case
+    // where hi is exactly 1.
+    const red = exp_mod.exp128Reduce(x);
+    if (red.k >= -24 and red.k <= 24) {
+        const two_k = math.scalbn(@as(f128, 1.0), red.k);
+        return (red.hi * two_k - 1) + red.lo * two_k;
+    }
+    return math.scalbn(red.hi + red.lo, red.k) - 1;
+}
+
+test "math.expm1() delegation" {
+    try expect(expm1(@as(f32, 0.2)) == std.math.expm1(@as(f32, 0.2)));
+    try expect(expm1(@as(f64, 0.2)) == std.math.expm1(@as(f64, 0.2)));
+    try expect(expm1(@as(f128, 0.2)) == expm1_128(0.2));
+}
+
+test "math.expm1_128() basic" {
+    const epsilon = 0.000001;
+
+    try expect(expm1_128(0.0) == 0.0);
+    try expect(math.approxEqAbs(f128, expm1_128(0.2), 0.221403, epsilon));
+    try expect(math.approxEqAbs(f128, expm1_128(0.8923), 1.440737, epsilon));
+    try expect(math.approxEqAbs(f128, expm1_128(1.5), 3.481689, epsilon));
+    try expect(math.approxEqAbs(f128, expm1_128(-1.5), -0.776870, epsilon));
+    try expect(math.approxEqRel(f128, expm1_128(0x1p-40), 0x1p-40 + 0x1p-81, 0x1p-100));
+}
+
+test "math.expm1_128().special" {
+    try expect(math.isPositiveInf(expm1_128(math.inf(f128))));
+    try expect(expm1_128(-math.inf(f128)) == -1.0);
+    try expect(math.isNan(expm1_128(math.nan(f128))));
+}
+
+pub fn main() !void {
+    try @import("util.zig").singleInputFuncMain(expm1);
+}
@@ -0,0 +1,246 @@
+// f16 exp, exp2 and log2 as direct lookups.
+//
+// There are only 65536 f16 inputs, so each function is a 128 KiB table indexed
+// by the input bits, generated at compile time from the f64 kernels. The test
+// "math.f16 exhaustive" checks every entry of the tables against the f128
+// kernels, to be the correctly rounded f16 result.
+//
+// Inputs where the result saturates (to 0 or inf) are filled in directly
+// rather than going through the kernels, which also keeps the kernels off the
+// paths that raise floating point exceptions, which can't be evaluated at
+// compile time. As a consequence the lookups never raise exceptions. The
+// kernels are entered past their range checks, which are repeated here, as
+// math.counters can't count at compile time.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const exp_mod = @import("exp.zig");
+const exp2_mod = @import("exp2.zig");
+const log2_mod = @import("log2.zig");
+
+const Table = [1 << 16]f16;
+
+fn genTable(comptime func: fn (f16) f16) Table {
+    @setEvalBranchQuota(20_000_000);
+    var table: Table = undefined;
+    for (table) |*v, i| {
+        v.* = func(@bitCast(f16, @intCast(u16, i)));
+    }
+    return table;
+}
+
+/// Round an f64 result to f16, including overflow to inf.
+fn roundToF16(r: f64) f16 {
+    // f16_max + ulp / 2, which rounds to even (inf).
+    if (r >= 65520) {
+        return math.inf(f16);
+    }
+    return @floatCast(f16, r);
+}
+
+fn exp16Gen(x: f16) f16 {
+    if (math.isNan(x)) {
+        return math.nan(f16);
+    }
+    // e^12 > f16_max, includes inf
+    if (x > 12) {
+        return math.inf(f16);
+    }
+    // e^-18 < 0x1p-25, which rounds to 0, includes -inf
+    if (x < -18) {
+        return 0;
+    }
+    return roundToF16(exp_mod.exp64Reduced(x));
+}
+
+fn exp2_16Gen(x: f16) f16 {
+    if (math.isNan(x)) {
+        return math.nan(f16);
+    }
+    // 2^16 > f16_max, includes inf
+    if (x >= 16) {
+        return math.inf(f16);
+    }
+    // 2^-25 rounds to 0, includes -inf
+    if (x <= -25) {
+        return 0;
+    }
+    if (exp2_mod.exp2Integer(f64, x)) |r| {
+        return roundToF16(r);
+    }
+    return roundToF16(exp2_mod.exp2_64Reduced(x));
+}
+
+fn log2_16Gen(x: f16) f16 {
+    if (math.isNan(x)) {
+        return math.nan(f16);
+    }
+    // log2(+-0) = -inf
+    if (x == 0) {
+        return -math.inf(f16);
+    }
+    // log2(-#) = nan
+    if (x < 0) {
+        return math.nan(f16);
+    }
+    if (math.isInf(x)) {
+        return x;
+    }
+    // log2 of a finite f16 is in [-24, 16], so can't overflow.
+    return @floatCast(f16, log2_mod.log2_64Normal(x, 0));
+}
+
+const exp16_table = genTable(exp16Gen);
+const exp2_16_table = genTable(exp2_16Gen);
+const log2_16_table = genTable(log2_16Gen);
+
+pub fn exp16(x: f16) f16 {
+    return exp16_table[@bitCast(u16, x)];
+}
+
+pub fn exp2_16(x: f16) f16 {
+    return exp2_16_table[@bitCast(u16, x)];
+}
+
+pub fn log2_16(x: f16) f16 {
+    return log2_16_table[@bitCast(u16, x)];
+}
+
+fn gather(comptime n: usize, table: *const Table, x: @Vector(n, f16)) @Vector(n, f16) {
+    const idx = @bitCast(@Vector(n, u16), x);
+    var result: [n]f16 = undefined;
+    comptime var i = 0;
+    inline while (i < n) : (i += 1) {
+        result[i] = table[idx[i]];
+    }
+    return result;
+}
+
+/// Returns exp16() of each element of x.
+pub fn exp16Vector(comptime n: usize, x: @Vector(n, f16)) @Vector(n, f16) {
+    return gather(n, &exp16_table, x);
+}
+
+/// Returns exp2_16() of each element of x.
+pub fn exp2_16Vector(comptime n: usize, x: @Vector(n, f16)) @Vector(n, f16) {
+    return gather(n, &exp2_16_table, x);
+}
+
+/// Returns log2_16() of each element of x.
+pub fn log2_16Vector(comptime n: usize, x: @Vector(n, f16)) @Vector(n, f16) {
+    return gather(n, &log2_16_table, x);
+}
+
+test "math.exp16() basic" {
+    const epsilon = 0.001;
+
+    try expect(exp16(0.0) == 1.0);
+    try expect(math.approxEqAbs(f16, exp16(0.2), 1.2214, epsilon));
+    try expect(math.approxEqAbs(f16, exp16(1.5), 4.480, epsilon * 4));
+    try expect(math.approxEqAbs(f16, exp16(-1.5), 0.2231, epsilon));
+}
+
+test "math.exp2_16() basic" {
+    const epsilon = 0.001;
+
+    try expect(exp2_16(0.0) == 1.0);
+    try expect(exp2_16(10.0) == 1024.0);
+    try expect(exp2_16(-24.0) == 0x1p-24);
+    try expect(math.approxEqAbs(f16, exp2_16(0.2), 1.149, epsilon));
+    try expect(math.approxEqAbs(f16, exp2_16(1.5), 2.828, epsilon * 2));
+}
+
+test "math.log2_16() basic" {
+    const epsilon = 0.001;
+
+    try expect(log2_16(1.0) == 0.0);
+    try expect(log2_16(0x1p-24) == -24.0);
+    try expect(math.approxEqAbs(f16, log2_16(0.2), -2.322, epsilon * 2));
+    try expect(math.approxEqAbs(f16, log2_16(1.5), 0.585, epsilon));
+}
+
+test "math.exp16Vector()" {
+    const x = @Vector(4, f16){ 0.2, 1.5, -1.5, 3.7 };
+    const y = exp16Vector(4, x);
+    comptime var i = 0;
+    inline while (i < 4) : (i += 1) {
+        try expect(y[i] == exp16(x[i]));
+    }
+    const z = log2_16Vector(4, exp2_16Vector(4, @Vector(4, f16){ 1, 2, 3, -4 }));
+    try expect(z[0] == 1 and z[1] == 2 and z[2] == 3 and z[3] == -4);
+}
+
+test "math.f16 special" {
+    try expect(math.isPositiveInf(exp16(math.inf(f16))));
+    try expect(exp16(-math.inf(f16)) == 0);
+    try expect(math.isNan(exp16(math.nan(f16))));
+    try expect(math.isPositiveInf(exp2_16(16)));
+    try expect(exp2_16(-25) == 0);
+    try expect(math.isNegativeInf(log2_16(0)));
+    try expect(math.isNegativeInf(log2_16(-0.0)));
+    try expect(math.isNan(log2_16(-1)));
+    try expect(math.isPositiveInf(log2_16(math.inf(f16))));
+}
+
+/// Widens an f16 to f128 through f32, which is exact.
+fn toF128(y: f16) f128 {
+    return @as(f32, y);
+}
+
+/// Returns whether y is r rounded to nearest even in f16. The neighbours of
+/// y and the points half way to them are exact in f128, so this doesn't
+/// depend on a conversion from f128 to f16.
+fn isRoundedF16(y: f16, r: f128) bool {
+    if (math.isNan(r)) {
+        return math.isNan(y);
+    }
+    if (math.isNan(y)) {
+        return false;
+    }
+    if (r == 0) {
+        return y == 0;
+    }
+    // Rounding to nearest is symmetric, so check |r|.
+    const ay = if (r < 0) -y else y;
+    const ar = if (r < 0) -r else r;
+    const bits = @bitCast(u16, ay);
+    if (bits >> 15 != 0) {
+        return false;
+    }
+    const even = bits & 1 == 0;
+    // f16_max + ulp / 2, from where the result rounds to inf.
+    const overflow: f128 = 65520;
+    if (math.isInf(ay)) {
+        return ar >= overflow;
+    }
+    const y128 = toF128(ay);
+    const lo = if (bits == 0) @as(f128, 0) else (y128 + toF128(@bitCast(f16, bits - 1))) / 2;
+    const hi = if (bits == 0x7BFF) overflow else (y128 + toF128(@bitCast(f16, bits + 1))) / 2;
+    return (ar > lo or (ar == lo and even)) and (ar < hi or (ar == hi and even));
+}
+
+test "math.f16 exhaustive" {
+    // Every input against the f128 kernels, which the tables don't use.
+    var failures: usize = 0;
+    var i: u32 = 0;
+    while (i < 1 << 16) : (i += 1) {
+        const x = @bitCast(f16, @intCast(u16, i));
+        const xq = toF128(x);
+        const results = [_]f16{ exp16(x), exp2_16(x), log2_16(x) };
+        const refs = [_]f128{ math.exp(xq), math.exp2(xq), math.log2(xq) };
+        for (results) |y, j| {
+            if (!isRoundedF16(y, refs[j])) {
+                std.debug.print("f16 {s}(0x{X:0>4}) = 0x{X:0>4}\n", .{
+                    ([_][]const u8{ "exp", "exp2", "log2" })[j],
+                    i,
+                    @bitCast(u16, y),
+                });
+                failures += 1;
+            }
+        }
+    }
+    try expect(failures == 0);
+}
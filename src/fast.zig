@@ -0,0 +1,386 @@
+// Relaxed-accuracy variants of exp and exp2 for f32 and f64.
+//
+// These use the same reductions as the default kernels, but with smaller
+// tables, lower degree polynomials and no extra-precision steps, and build the
+// scale factor 2^k directly in the exponent bits instead of calling scalbn().
+//
+// Maximum errors, measured against libquadmath:
+//
+//   function | f32      | f64
+//   ---------|----------|---------
+//   exp      | 0.53 ulp | 1.5 ulp
+//   exp2     | default  | 2.5 ulp
+//   log2     | default  | default
+//
+// Only the kernels that were at least 1.5x faster than the defaults in a C
+// prototype are kept. The f32 exp2 and the f32 and f64 log2 variants were
+// not, so fast.exp2() for f32 and fast.log2() are the default kernels. The
+// table reduction of the log2 variant stays, as math.cr and math.directed use
+// it.
+//
+// The f32 exp variant is evaluated in double precision, so is nearly
+// correctly rounded, and differs from the default mostly in the simpler
+// reduction.
+//
+// Arguments whose result is not a normal float (nan, inf, zero, subnormals,
+// overflow and underflow) are passed on to the default kernels, so special
+// cases and floating point exceptions are the same as for math.exp() and
+// math.exp2().
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+/// Returns e raised to the power of x (e^x), with a maximum error of 0.53 ulp
+/// for f32 and 1.5 ulp for f64.
+pub fn exp(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => exp32(x),
+        f64 => exp64(x),
+        else => @compileError("fast.exp not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns 2 raised to the power of x (2^x), with a maximum error of 2.5 ulp
+/// for f64. For f32 this is math.exp2().
+pub fn exp2(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32 => math.exp2(x),
+        f64 => exp2_64(x),
+        else => @compileError("fast.exp2 not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the base-2 logarithm of x. This is math.log2(), as no faster
+/// variant reached 1.5x.
+pub fn log2(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64 => math.log2(x),
+        else => @compileError("fast.log2 not implemented for " ++ @typeName(T)),
+    };
+}
+
+const exp2_tbl_bits = 7;
+const exp2_tblsiz = 1 << exp2_tbl_bits;
+
+// 2^(i/N) as f64 bits, with i << (52 - log2(N)) subtracted so that adding
+// n << (52 - log2(N)) for n = k * N + i gives the bits of 2^(n/N) directly.
+const exp2_table = [exp2_tblsiz]u64{
+    0x3FF0000000000000, 0x3FEFF63DA9FB3335, 0x3FEFEC9A3E778061, 0x3FEFE315E86E7F85,
+    0x3FEFD9B0D3158574, 0x3FEFD06B29DDF6DE, 0x3FEFC74518759BC8, 0x3FEFBE3ECAC6F383,
+    0x3FEFB5586CF9890F, 0x3FEFAC922B7247F7, 0x3FEFA3EC32D3D1A2, 0x3FEF9B66AFFED31B,
+    0x3FEF9301D0125B51, 0x3FEF8ABDC06C31CC, 0x3FEF829AAEA92DE0, 0x3FEF7A98C8A58E51,
+    0x3FEF72B83C7D517B, 0x3FEF6AF9388C8DEA, 0x3FEF635BEB6FCB75, 0x3FEF5BE084045CD4,
+    0x3FEF54873168B9AA, 0x3FEF4D5022FCD91D, 0x3FEF463B88628CD6, 0x3FEF3F49917DDC96,
+    0x3FEF387A6E756238, 0x3FEF31CE4FB2A63F, 0x3FEF2B4565E27CDD, 0x3FEF24DFE1F56381,
+    0x3FEF1E9DF51FDEE1, 0x3FEF187FD0DAD990, 0x3FEF1285A6E4030B, 0x3FEF0CAFA93E2F56,
+    0x3FEF06FE0A31B715, 0x3FEF0170FC4CD831, 0x3FEEFC08B26416FF, 0x3FEEF6C55F929FF1,
+    0x3FEEF1A7373AA9CB, 0x3FEEECAE6D05D866, 0x3FEEE7DB34E59FF7, 0x3FEEE32DC313A8E5,
+    0x3FEEDEA64C123422, 0x3FEEDA4504AC801C, 0x3FEED60A21F72E2A, 0x3FEED1F5D950A897,
+    0x3FEECE086061892D, 0x3FEECA41ED1D0057, 0x3FEEC6A2B5C13CD0, 0x3FEEC32AF0D7D3DE,
+    0x3FEEBFDAD5362A27, 0x3FEEBCB299FDDD0D, 0x3FEEB9B2769D2CA7, 0x3FEEB6DAA2CF6642,
+    0x3FEEB42B569D4F82, 0x3FEEB1A4CA5D920F, 0x3FEEAF4736B527DA, 0x3FEEAD12D497C7FD,
+    0x3FEEAB07DD485429, 0x3FEEA9268A5946B7, 0x3FEEA76F15AD2148, 0x3FEEA5E1B976DC09,
+    0x3FEEA47EB03A5585, 0x3FEEA34634CCC320, 0x3FEEA23882552225, 0x3FEEA155D44CA973,
+    0x3FEEA09E667F3BCD, 0x3FEEA012750BDABF, 0x3FEE9FB23C651A2F, 0x3FEE9F7DF9519484,
+    0x3FEE9F75E8EC5F74, 0x3FEE9F9A48A58174, 0x3FEE9FEB564267C9, 0x3FEEA0694FDE5D3F,
+    0x3FEEA11473EB0187, 0x3FEEA1ED0130C132, 0x3FEEA2F336CF4E62, 0x3FEEA427543E1A12,
+    0x3FEEA589994CCE13, 0x3FEEA71A4623C7AD, 0x3FEEA8D99B4492ED, 0x3FEEAAC7D98A6699,
+    0x3FEEACE5422AA0DB, 0x3FEEAF3216B5448C, 0x3FEEB1AE99157736, 0x3FEEB45B0B91FFC6,
+    0x3FEEB737B0CDC5E5, 0x3FEEBA44CBC8520F, 0x3FEEBD829FDE4E50, 0x3FEEC0F170CA07BA,
+    0x3FEEC49182A3F090, 0x3FEEC86319E32323, 0x3FEECC667B5DE565, 0x3FEED09BEC4A2D33,
+    0x3FEED503B23E255D, 0x3FEED99E1330B358, 0x3FEEDE6B5579FDBF, 0x3FEEE36BBFD3F37A,
+    0x3FEEE89F995AD3AD, 0x3FEEEE07298DB666, 0x3FEEF3A2B84F15FB, 0x3FEEF9728DE5593A,
+    0x3FEEFF76F2FB5E47, 0x3FEF05B030A1064A, 0x3FEF0C1E904BC1D2, 0x3FEF12C25BD71E09,
+    0x3FEF199BDD85529C, 0x3FEF20AB5FFFD07A, 0x3FEF27F12E57D14B, 0x3FEF2F6D9406E7B5,
+    0x3FEF3720DCEF9069, 0x3FEF3F0B555DC3FA, 0x3FEF472D4A07897C, 0x3FEF4F87080D89F2,
+    0x3FEF5818DCFBA487, 0x3FEF60E316C98398, 0x3FEF69E603DB3285, 0x3FEF7321F301B460,
+    0x3FEF7C97337B9B5F, 0x3FEF864614F5A129, 0x3FEF902EE78B3FF6, 0x3FEF9A51FBC74C83,
+    0x3FEFA4AFA2A490DA, 0x3FEFAF482D8E67F1, 0x3FEFBA1BEE615A27, 0x3FEFC52B376BBA97,
+    0x3FEFD0765B6E4540, 0x3FEFDBFDAD9CBE14, 0x3FEFE7C1819E90D8, 0x3FEFF3C22B8F71F1,
+};
+
+/// Returns 2^(n/N) from the low bits of kd = n/N + shift.
+fn exp2Scale(ki: u64) f64 {
+    const t = exp2_table[@intCast(usize, ki % exp2_tblsiz)];
+    return @bitCast(f64, t +% (ki << (52 - exp2_tbl_bits)));
+}
+
+fn exp2_64(x: f64) f64 {
+    const shift: f64 = 0x1.8p52 / @intToFloat(f64, exp2_tblsiz);
+    const C1: f64 = 0x1.62e42fefa3892p-1;
+    const C2: f64 = 0x1.ebfbdff82c4edp-3;
+    const C3: f64 = 0x1.c6b0985c8a1bcp-5;
+    const C4: f64 = 0x1.3b2abc07c93d0p-7;
+
+    // |x| >= 1022 or nan
+    if (@bitCast(u64, x) & 0x7FFFFFFFFFFFFFFF >= 0x408FF00000000000) {
+        return math.exp2(x);
+    }
+
+    // x = n/N + z, |z| <= 1/2N
+    var kd = x + shift;
+    const ki = @bitCast(u64, kd);
+    kd -= shift;
+    const z = x - kd;
+
+    // 2^x = 2^(n/N) * (1 + p(z))
+    const s = exp2Scale(ki);
+    const p = z * (C1 + z * (C2 + z * (C3 + z * C4)));
+    return s + s * p;
+}
+
+fn exp64(x: f64) f64 {
+    const shift: f64 = 0x1.8p52;
+    const inv_ln2_n: f64 = 0x1.71547652b82fep+7; // N / ln2
+    const ln2_n_hi: f64 = 0x1.62e42fefa0000p-8; // ln2 / N
+    const ln2_n_lo: f64 = 0x1.cf79abc9e3b3ap-47;
+    const A2: f64 = 0x1.fffffffffff58p-2;
+    const A3: f64 = 0x1.5555555555525p-3;
+    const A4: f64 = 0x1.55555accc11b8p-5;
+    const A5: f64 = 0x1.11111430bc5c6p-7;
+
+    // |x| >= 708 or nan
+    if (@bitCast(u64, x) & 0x7FFFFFFFFFFFFFFF >= 0x4086200000000000) {
+        return math.exp(x);
+    }
+
+    // x = n * ln2/N + r, |r| <= ln2/2N, with n * ln2_n_hi exact
+    var kd = x * inv_ln2_n + shift;
+    const ki = @bitCast(u64, kd);
+    kd -= shift;
+    const r = x - kd * ln2_n_hi - kd * ln2_n_lo;
+
+    // e^x = 2^(n/N) * (1 + p(r))
+    const s = exp2Scale(ki);
+    const p = r + r * r * (A2 + r * (A3 + r * (A4 + r * A5)));
+    return s + s * p;
+}
+
+/// 2^x for |x| < 1022, evaluated to much more than f32 precision.
+fn exp2Core32(x: f64) f64 {
+    const shift: f64 = 0x1.8p52 / @intToFloat(f64, exp2_tblsiz);
+    const C1: f64 = 0x1.62e43e2528362p-1;
+    const C2: f64 = 0x1.ebfbe9d182250p-3;
+
+    var kd = x + shift;
+    const ki = @bitCast(u64, kd);
+    kd -= shift;
+    const z = x - kd;
+
+    const s = exp2Scale(ki);
+    return s + s * z * (C1 + z * C2);
+}
+
+fn exp32(x: f32) f32 {
+    const log2e: f64 = 0x1.71547652b82fep+0;
+
+    // |x| >= 87 or nan
+    if (@bitCast(u32, x) & 0x7FFFFFFF >= 0x42AE0000) {
+        return math.exp(x);
+    }
+    // The product is accurate to well beyond f32 precision for |x| < 87.
+    return @floatCast(f32, exp2Core32(@as(f64, x) * log2e));
+}
+
+const log2_tbl_bits = 7;
+pub const log2_tblsiz = 1 << log2_tbl_bits;
+
+pub const Log2Entry = struct {
+    invc: f64,
+    log2c: f64,
+};
+
+// 1/c and log2(c) for c = 1 + i/N, i = -37 .. 53, which covers the range
+// [sqrt(2) / 2, sqrt(2)] of the reduced argument. c = 1 exactly for i = 0, so
+// there is no cancellation for x close to 1.
+pub const log2_table_offset = 37;
+pub const log2_table = [_]Log2Entry{
+    .{ .invc = 0x1.6816816816817p+0, .log2c = -0x1.f804ae8d0cd02p-2 },
+    .{ .invc = 0x1.642c8590b2164p+0, .log2c = -0x1.e7df5fe538ab3p-2 },
+    .{ .invc = 0x1.6058160581606p+0, .log2c = -0x1.d7e6c0abc3579p-2 },
+    .{ .invc = 0x1.5c9882b931057p+0, .log2c = -0x1.c819dc2d45fe4p-2 },
+    .{ .invc = 0x1.58ed2308158edp+0, .log2c = -0x1.b877c57b1b070p-2 },
+    .{ .invc = 0x1.5555555555555p+0, .log2c = -0x1.a8ff971810a5ep-2 },
+    .{ .invc = 0x1.51d07eae2f815p+0, .log2c = -0x1.99b072a96c6b2p-2 },
+    .{ .invc = 0x1.4e5e0a72f0539p+0, .log2c = -0x1.8a8980abfbd32p-2 },
+    .{ .invc = 0x1.4afd6a052bf5bp+0, .log2c = -0x1.7b89f02cf2aadp-2 },
+    .{ .invc = 0x1.47ae147ae147bp+0, .log2c = -0x1.6cb0f6865c8eap-2 },
+    .{ .invc = 0x1.446f86562d9fbp+0, .log2c = -0x1.5dfdcf1eeae0ep-2 },
+    .{ .invc = 0x1.4141414141414p+0, .log2c = -0x1.4f6fbb2cec598p-2 },
+    .{ .invc = 0x1.3e22cbce4a902p+0, .log2c = -0x1.4106017c3eca3p-2 },
+    .{ .invc = 0x1.3b13b13b13b14p+0, .log2c = -0x1.32bfee370ee68p-2 },
+    .{ .invc = 0x1.3813813813814p+0, .log2c = -0x1.249cd2b13cd6cp-2 },
+    .{ .invc = 0x1.3521cfb2b78c1p+0, .log2c = -0x1.169c05363f158p-2 },
+    .{ .invc = 0x1.323e34a2b10bfp+0, .log2c = -0x1.08bce0d95fa38p-2 },
+    .{ .invc = 0x1.2f684bda12f68p+0, .log2c = -0x1.f5fd8a9063e35p-3 },
+    .{ .invc = 0x1.2c9fb4d812ca0p+0, .log2c = -0x1.dac22d3e441d3p-3 },
+    .{ .invc = 0x1.29e4129e4129ep+0, .log2c = -0x1.bfc67a7fff4ccp-3 },
+    .{ .invc = 0x1.27350b8812735p+0, .log2c = -0x1.a5094b54d2828p-3 },
+    .{ .invc = 0x1.2492492492492p+0, .log2c = -0x1.8a8980abfbd32p-3 },
+    .{ .invc = 0x1.21fb78121fb78p+0, .log2c = -0x1.7046031c79f85p-3 },
+    .{ .invc = 0x1.1f7047dc11f70p+0, .log2c = -0x1.563dc29ffacb2p-3 },
+    .{ .invc = 0x1.1cf06ada2811dp+0, .log2c = -0x1.3c6fb650cde51p-3 },
+    .{ .invc = 0x1.1a7b9611a7b96p+0, .log2c = -0x1.22dadc2ab3497p-3 },
+    .{ .invc = 0x1.1811811811812p+0, .log2c = -0x1.097e38ce60649p-3 },
+    .{ .invc = 0x1.15b1e5f75270dp+0, .log2c = -0x1.e0b1ae8f2fd56p-4 },
+    .{ .invc = 0x1.135c81135c811p+0, .log2c = -0x1.aed391ab6674ep-4 },
+    .{ .invc = 0x1.1111111111111p+0, .log2c = -0x1.7d60496cfbb4cp-4 },
+    .{ .invc = 0x1.0ecf56be69c90p+0, .log2c = -0x1.4c560fe68af88p-4 },
+    .{ .invc = 0x1.0c9714fbcda3bp+0, .log2c = -0x1.1bb32a600549dp-4 },
+    .{ .invc = 0x1.0a6810a6810a7p+0, .log2c = -0x1.d6ebd1f1febfep-5 },
+    .{ .invc = 0x1.0842108421084p+0, .log2c = -0x1.77394c9d958d5p-5 },
+    .{ .invc = 0x1.0624dd2f1a9fcp+0, .log2c = -0x1.184b8e4c56af8p-5 },
+    .{ .invc = 0x1.0410410410410p+0, .log2c = -0x1.743ee861f3556p-6 },
+    .{ .invc = 0x1.0204081020408p+0, .log2c = -0x1.72c7ba20f7327p-7 },
+    .{ .invc = 0x1.0000000000000p+0, .log2c = 0.0 },
+    .{ .invc = 0x1.fc07f01fc07f0p-1, .log2c = 0x1.6fe50b6ef0851p-7 },
+    .{ .invc = 0x1.f81f81f81f820p-1, .log2c = 0x1.6e79685c2d22ap-6 },
+    .{ .invc = 0x1.f44659e4a4271p-1, .log2c = 0x1.11cd1d5133413p-5 },
+    .{ .invc = 0x1.f07c1f07c1f08p-1, .log2c = 0x1.6bad3758efd87p-5 },
+    .{ .invc = 0x1.ecc07b301ecc0p-1, .log2c = 0x1.c4dfab90aab5fp-5 },
+    .{ .invc = 0x1.e9131abf0b767p-1, .log2c = 0x1.0eb389fa29f9bp-4 },
+    .{ .invc = 0x1.e573ac901e574p-1, .log2c = 0x1.3aa2fdd27f1c3p-4 },
+    .{ .invc = 0x1.e1e1e1e1e1e1ep-1, .log2c = 0x1.663f6fac91316p-4 },
+    .{ .invc = 0x1.de5d6e3f8868ap-1, .log2c = 0x1.918a16e46335bp-4 },
+    .{ .invc = 0x1.dae6076b981dbp-1, .log2c = 0x1.bc84240adabbap-4 },
+    .{ .invc = 0x1.d77b654b82c34p-1, .log2c = 0x1.e72ec117fa5b2p-4 },
+    .{ .invc = 0x1.d41d41d41d41dp-1, .log2c = 0x1.08c588cda79e4p-3 },
+    .{ .invc = 0x1.d0cb58f6ec074p-1, .log2c = 0x1.1dcd197552b7bp-3 },
+    .{ .invc = 0x1.cd85689039b0bp-1, .log2c = 0x1.32ae9e278ae1ap-3 },
+    .{ .invc = 0x1.ca4b3055ee191p-1, .log2c = 0x1.476a9f983f74dp-3 },
+    .{ .invc = 0x1.c71c71c71c71cp-1, .log2c = 0x1.5c01a39fbd688p-3 },
+    .{ .invc = 0x1.c3f8f01c3f8f0p-1, .log2c = 0x1.70742d4ef027fp-3 },
+    .{ .invc = 0x1.c0e070381c0e0p-1, .log2c = 0x1.84c2bd02f03b3p-3 },
+    .{ .invc = 0x1.bdd2b899406f7p-1, .log2c = 0x1.98edd077e70dfp-3 },
+    .{ .invc = 0x1.bacf914c1bad0p-1, .log2c = 0x1.acf5e2db4ec94p-3 },
+    .{ .invc = 0x1.b7d6c3dda338bp-1, .log2c = 0x1.c0db6cdd94deep-3 },
+    .{ .invc = 0x1.b4e81b4e81b4fp-1, .log2c = 0x1.d49ee4c325970p-3 },
+    .{ .invc = 0x1.b2036406c80d9p-1, .log2c = 0x1.e840be74e6a4dp-3 },
+    .{ .invc = 0x1.af286bca1af28p-1, .log2c = 0x1.fbc16b902680ap-3 },
+    .{ .invc = 0x1.ac5701ac5701bp-1, .log2c = 0x1.0790adbb03009p-2 },
+    .{ .invc = 0x1.a98ef606a63bep-1, .log2c = 0x1.11307dad30b76p-2 },
+    .{ .invc = 0x1.a6d01a6d01a6dp-1, .log2c = 0x1.1ac05b291f070p-2 },
+    .{ .invc = 0x1.a41a41a41a41ap-1, .log2c = 0x1.24407ab0e073ap-2 },
+    .{ .invc = 0x1.a16d3f97a4b02p-1, .log2c = 0x1.2db10fc4d9aafp-2 },
+    .{ .invc = 0x1.9ec8e951033d9p-1, .log2c = 0x1.37124cea4cdedp-2 },
+    .{ .invc = 0x1.9c2d14ee4a102p-1, .log2c = 0x1.406463b1b0449p-2 },
+    .{ .invc = 0x1.999999999999ap-1, .log2c = 0x1.49a784bcd1b8bp-2 },
+    .{ .invc = 0x1.970e4f80cb872p-1, .log2c = 0x1.52dbdfc4c96b3p-2 },
+    .{ .invc = 0x1.948b0fcd6e9e0p-1, .log2c = 0x1.5c01a39fbd688p-2 },
+    .{ .invc = 0x1.920fb49d0e229p-1, .log2c = 0x1.6518fe4677ba7p-2 },
+    .{ .invc = 0x1.8f9c18f9c18fap-1, .log2c = 0x1.6e221cd9d0cdep-2 },
+    .{ .invc = 0x1.8d3018d3018d3p-1, .log2c = 0x1.771d2ba7efb3cp-2 },
+    .{ .invc = 0x1.8acb90f6bf3aap-1, .log2c = 0x1.800a563161c54p-2 },
+    .{ .invc = 0x1.886e5f0abb04ap-1, .log2c = 0x1.88e9c72e0b226p-2 },
+    .{ .invc = 0x1.8618618618618p-1, .log2c = 0x1.91bba891f1709p-2 },
+    .{ .invc = 0x1.83c977ab2beddp-1, .log2c = 0x1.9a802391e232fp-2 },
+    .{ .invc = 0x1.8181818181818p-1, .log2c = 0x1.a33760a7f6051p-2 },
+    .{ .invc = 0x1.7f405fd017f40p-1, .log2c = 0x1.abe18797f1f49p-2 },
+    .{ .invc = 0x1.7d05f417d05f4p-1, .log2c = 0x1.b47ebf73882a1p-2 },
+    .{ .invc = 0x1.7ad2208e0ecc3p-1, .log2c = 0x1.bd0f2e9e79031p-2 },
+    .{ .invc = 0x1.78a4c8178a4c8p-1, .log2c = 0x1.c592fad295b56p-2 },
+    .{ .invc = 0x1.767dce434a9b1p-1, .log2c = 0x1.ce0a4923a587dp-2 },
+    .{ .invc = 0x1.745d1745d1746p-1, .log2c = 0x1.d6753e032ea0fp-2 },
+    .{ .invc = 0x1.724287f46debcp-1, .log2c = 0x1.ded3fd442364cp-2 },
+    .{ .invc = 0x1.702e05c0b8170p-1, .log2c = 0x1.e726aa1e754d2p-2 },
+    .{ .invc = 0x1.6e1f76b4337c7p-1, .log2c = 0x1.ef6d67328e220p-2 },
+    .{ .invc = 0x1.6c16c16c16c17p-1, .log2c = 0x1.f7a8568cb06cfp-2 },
+    .{ .invc = 0x1.6a13cd1537290p-1, .log2c = 0x1.ffd799a83ff9bp-2 },
+};
+
+pub const Log2Reduced = struct {
+    log2c: f64,
+    r: f64,
+};
+
+/// Reduce f in [sqrt(2) / 2 - 1, sqrt(2) - 1] such that
+/// log2(1 + f) = log2c + log2(1 + r), |r| <= 1/(sqrt(2) * N).
+pub fn log2Reduce(f: f64) Log2Reduced {
+    const shift: f64 = 0x1.8p52;
+
+    // f = i/N + d, |d| <= 1/2N, with f - i/N exact
+    var kd = f * log2_tblsiz + shift;
+    const i = @bitCast(i32, @truncate(u32, @bitCast(u64, kd)));
+    kd -= shift;
+    const e = log2_table[@intCast(usize, i + log2_table_offset)];
+    return .{
+        .log2c = e.log2c,
+        .r = (f - kd * (1.0 / @as(f64, log2_tblsiz))) * e.invc,
+    };
+}
+
+/// Returns the error of y in ulps of T, relative to the more precise ref.
+fn ulpError(comptime T: type, y: T, ref: f128) f128 {
+    const fr = math.frexp(@floatCast(T, ref));
+    const ulp = math.scalbn(@as(f128, 1), fr.exponent - math.floatMantissaBits(T) - 1);
+    return math.fabs(@as(f128, y) - ref) / ulp;
+}
+
+test "math.fast.exp() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp(@as(f32, 0.0)) == 1.0);
+    try expect(math.approxEqAbs(f32, exp(@as(f32, 0.2)), 1.221403, epsilon));
+    try expect(math.approxEqAbs(f32, exp(@as(f32, -1.5)), 0.223130, epsilon));
+    try expect(exp(@as(f64, 0.0)) == 1.0);
+    try expect(math.approxEqAbs(f64, exp(@as(f64, 0.2)), 1.221403, epsilon));
+    try expect(math.approxEqAbs(f64, exp(@as(f64, 0.8923)), 2.440737, epsilon));
+    try expect(math.approxEqAbs(f64, exp(@as(f64, -1.5)), 0.223130, epsilon));
+}
+
+test "math.fast.exp2() basic" {
+    const epsilon = 0.000001;
+
+    try expect(exp2(@as(f32, 0.0)) == 1.0);
+    try expect(exp2(@as(f32, 10.0)) == 1024.0);
+    try expect(math.approxEqAbs(f32, exp2(@as(f32, 0.2)), 1.148698, epsilon));
+    try expect(exp2(@as(f64, 0.0)) == 1.0);
+    try expect(exp2(@as(f64, -3.0)) == 0.125);
+    try expect(math.approxEqAbs(f64, exp2(@as(f64, 0.2)), 1.148698, epsilon));
+    try expect(math.approxEqAbs(f64, exp2(@as(f64, 0.8923)), 1.856133, epsilon));
+}
+
+test "math.fast.log2() basic" {
+    const epsilon = 0.000001;
+
+    try expect(log2(@as(f32, 1.0)) == 0.0);
+    try expect(log2(@as(f32, 1024.0)) == 10.0);
+    try expect(math.approxEqAbs(f32, log2(@as(f32, 0.2)), -2.321928, epsilon));
+    try expect(log2(@as(f64, 1.0)) == 0.0);
+    try expect(log2(@as(f64, 0.125)) == -3.0);
+    try expect(math.approxEqAbs(f64, log2(@as(f64, 0.2)), -2.321928, epsilon));
+    try expect(math.approxEqAbs(f64, log2(@as(f64, 37.45)), 5.226894, epsilon));
+}
+
+test "math.fast max ulp" {
+    // Bounds from the table at the top of the file.
+    var i: u32 = 0;
+    while (i < 20000) : (i += 1) {
+        const t = @intToFloat(f64, i) / 20000;
+
+        const x_exp = t * 1400 - 700;
+        try expect(ulpError(f64, exp64(x_exp), math.exp(@as(f128, x_exp))) <= 1.5);
+        try expect(ulpError(f32, exp32(@floatCast(f32, x_exp / 9)), math.exp(@as(f128, @floatCast(f32, x_exp / 9)))) <= 0.53);
+
+        const x_exp2 = t * 2040 - 1020;
+        try expect(ulpError(f64, exp2_64(x_exp2), math.exp2(@as(f128, x_exp2))) <= 2.5);
+    }
+}
+
+test "math.fast.special" {
+    try expect(math.isPositiveInf(exp(math.inf(f64))));
+    try expect(exp(-math.inf(f64)) == 0);
+    try expect(math.isNan(exp(math.nan(f32))));
+    try expect(math.isPositiveInf(exp2(math.inf(f32))));
+    try expect(exp2(@as(f64, -1074)) == 0x1p-1074);
+    try expect(math.isNan(exp2(math.nan(f64))));
+    try expect(math.isNegativeInf(log2(@as(f64, 0.0))));
+    try expect(math.isNan(log2(@as(f32, -1.0))));
+    try expect(math.isPositiveInf(log2(math.inf(f64))));
+    try expect(log2(@as(f64, 0x1p-1074)) == -1074);
+}
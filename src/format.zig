@@ -0,0 +1,523 @@
+// Shortest round-trip decimal formatting of f32, f64 and f128.
+//
+// The output is the shortest decimal that rounds back to the input, and the
+// closest such decimal if there are several, written as
+// [-]d[.ddd]e[-]n. This is the Ryu algorithm (Adams, "Ryu: Fast Float-to-
+// String Conversion", PLDI 2018), using integer arithmetic only.
+//
+// The input mantissa m (scaled by 4 so that the halfway points to the
+// neighbouring floats are integers) is scaled by 2^e2 / 10^q by multiplying
+// with a 255-bit approximation of 2^k / 5^q (e2 >= 0) or 5^i / 2^k (e2 < 0)
+// and shifting, where q is chosen so that the integer parts of the scaled
+// interval bounds have a few more digits than the output. The approximations
+// are accurate enough for the truncated products to be exact for every
+// input. Digits are then removed from the bounds until they meet, tracking
+// whether anything nonzero was removed to round correctly.
+//
+// The tables are generated at compile time, for only the types that are
+// used, and shared with parse.zig. The f128 tables have about 10k entries
+// (320 KiB), the f64 ones 689. Generating them is most of the compile time
+// of f128 formatting and parsing: 5005 divisions and about 10k multiplies
+// and shifts of 11875-bit comptime integers, against 363 and about 700 of
+// 1097 bits for f64.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+/// The number of bits kept of each power of five in the tables.
+pub const pow5_bits = 255;
+
+/// floor(e * log10(2)), for e <= 20000.
+pub fn log10Pow2(e: u32) u32 {
+    return @intCast(u32, (@as(u64, e) * 1292913986) >> 32);
+}
+
+/// floor(e * log10(5)), for e <= 20000.
+pub fn log10Pow5(e: u32) u32 {
+    return @intCast(u32, (@as(u64, e) * 3002053309) >> 32);
+}
+
+/// The bit length of 5^e, i.e. floor(e * log2(5)) + 1, for e <= 20000.
+pub fn pow5Bits(e: u32) u32 {
+    return @intCast(u32, ((@as(u64, e) * 9972605231) >> 32) + 1);
+}
+
+/// The longest output of formatFloat() for a T: a sign, the significant
+/// digits, a point and the exponent with its sign.
+pub fn formatLen(comptime T: type) usize {
+    return switch (T) {
+        f32 => 1 + 9 + 1 + 2 + 2,
+        f64 => 1 + 17 + 1 + 2 + 3,
+        f128 => 1 + 36 + 1 + 2 + 4,
+        else => @compileError("formatFloat not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Tables of 255-bit approximations of 5^i and 2^k / 5^q, for formatting and
+/// parsing a T.
+pub fn Pow5Tables(comptime T: type) type {
+    return struct {
+        const p = math.floatMantissaBits(T);
+        const exp_bits = math.floatExponentBits(T);
+        const bias = (1 << (exp_bits - 1)) - 1;
+        /// The exponents of 4 * mantissa for the smallest (subnormal) and
+        /// largest finite values.
+        const e2_min = 1 - bias - p - 2;
+        const e2_max = (1 << exp_bits) - 2 - bias - p - 2;
+
+        /// Formatting needs q up to log10Pow2(e2_max) - 1, and parsing up
+        /// to the decimal exponent of the smallest subnormal plus the 38
+        /// digits that fit in a u128.
+        const n_inv = math.max(log10Pow2(e2_max), log10Pow2(-e2_min) + 40);
+        /// Formatting needs i up to -e2_min - q(e2_min), which also covers
+        /// the decimal exponent of the largest finite value for parsing.
+        const n_pow = -e2_min - (log10Pow5(-e2_min) - 1) + 1;
+        /// Wide enough for 2^k with the largest k of the inverse table, and
+        /// 5^i for the largest i of the power table.
+        const Wide = std.meta.Int(
+            .unsigned,
+            @intCast(u16, math.max(pow5_bits + pow5Bits(n_inv - 1), pow5Bits(n_pow - 1) + pow5_bits) + 1),
+        );
+        const WideShift = math.Log2Int(Wide);
+
+        fn toEntry(x: Wide) [2]u128 {
+            return .{ @truncate(u128, x), @truncate(u128, x >> 128) };
+        }
+
+        /// floor(2^k / 5^q) + 1 with k = pow5Bits(q) + pow5_bits - 1, which
+        /// has pow5_bits bits and is at most 1 above 2^k / 5^q.
+        pub const inv = blk: {
+            @setEvalBranchQuota(1_000_000);
+            var table: [n_inv][2]u128 = undefined;
+            var pow5: Wide = 1;
+            for (table) |*entry, q| {
+                const k = pow5Bits(@intCast(u32, q)) + pow5_bits - 1;
+                entry.* = toEntry((@as(Wide, 1) << @intCast(WideShift, k)) / pow5 + 1);
+                pow5 *= 5;
+            }
+            break :blk table;
+        };
+
+        /// 5^i truncated (or extended) to pow5_bits bits, so it's exact for
+        /// pow5Bits(i) <= pow5_bits and otherwise at most 1 below.
+        pub const pow = blk: {
+            @setEvalBranchQuota(1_000_000);
+            var table: [n_pow][2]u128 = undefined;
+            var pow5: Wide = 1;
+            for (table) |*entry, i| {
+                const bits = pow5Bits(@intCast(u32, i));
+                entry.* = toEntry(if (bits >= pow5_bits)
+                    pow5 >> @intCast(WideShift, bits - pow5_bits)
+                else
+                    pow5 << @intCast(WideShift, pow5_bits - bits));
+                pow5 *= 5;
+            }
+            break :blk table;
+        };
+    };
+}
+
+fn Format(comptime T: type) type {
+    return struct {
+        const Bits = std.meta.Int(.unsigned, @bitSizeOf(T));
+        const p = math.floatMantissaBits(T);
+        const exp_bits = math.floatExponentBits(T);
+        const bias = (1 << (exp_bits - 1)) - 1;
+        /// Holds the scaled mantissa and the scaled bounds, which have up to
+        /// p + 3 bits.
+        const M = if (p + 3 <= 64) u64 else u128;
+
+        /// The largest q for which a mantissa can be a multiple of 5^q.
+        const max_pow5_q = blk: {
+            var q = 0;
+            while (std.math.pow(u128, 5, q + 1) < 1 << (p + 3)) q += 1;
+            break :blk q;
+        };
+
+        const inv_table = Pow5Tables(T).inv;
+        const pow_table = Pow5Tables(T).pow;
+
+        fn div10(x: M) M {
+            if (M == u64) {
+                return x / 10;
+            } else {
+                // LLVM doesn't turn u128 division by a constant into a
+                // multiply.
+                return mulHi128(x >> 1, 0xcccccccccccccccccccccccccccccccd) >> 2;
+            }
+        }
+
+        fn pow5Factor(x_: M) u32 {
+            var x = x_;
+            var count: u32 = 0;
+            while (x % 5 == 0) : (x /= 5) {
+                count += 1;
+            }
+            return count;
+        }
+
+        /// The shortest correctly rounded decimal for a finite, nonzero and
+        /// positive input.
+        fn shortest(bits: Bits) Decimal {
+            const frac = bits & ((1 << p) - 1);
+            const exp = @intCast(i32, bits >> p);
+            const e2 = math.max(exp, 1) - bias - p - 2;
+            const m2 = @intCast(M, if (exp == 0) frac else frac | (1 << p));
+
+            // The input is 4 * m2 * 2^e2, its neighbours mm and mp, midway
+            // to the adjacent floats. The lower one is closer for exact
+            // powers of two, other than the smallest normal.
+            const accept = m2 & 1 == 0;
+            const mv = 4 * m2;
+            const mm_shift = @boolToInt(frac != 0 or exp <= 1);
+            const mp = mv + 2;
+            const mm = mv - 1 - mm_shift;
+
+            // Step 1: vr, vp and vm are mv, mp and mm times 2^e2 / 10^e10,
+            // rounded down, and the _tz flags are set if nothing nonzero was
+            // lost in the division.
+            var vr: M = undefined;
+            var vp: M = undefined;
+            var vm: M = undefined;
+            var e10: i32 = undefined;
+            var vm_tz = false;
+            var vr_tz = false;
+            if (e2 >= 0) {
+                const e = @intCast(u32, e2);
+                const q = log10Pow2(e) - @boolToInt(e > 3);
+                e10 = @intCast(i32, q);
+                const mul = inv_table[q];
+                const j = q + pow5Bits(q) + pow5_bits - 1 - e;
+                vr = mulShift(mv, mul, j);
+                vp = mulShift(mp, mul, j);
+                vm = mulShift(mm, mul, j);
+                if (q <= max_pow5_q) {
+                    // Only one of mv, mp and mm can be a multiple of 5.
+                    if (mv % 5 == 0) {
+                        vr_tz = pow5Factor(mv) >= q;
+                    } else if (accept) {
+                        vm_tz = pow5Factor(mm) >= q;
+                    } else {
+                        vp -= @boolToInt(pow5Factor(mp) >= q);
+                    }
+                }
+            } else {
+                const e = @intCast(u32, -e2);
+                const q = log10Pow5(e) - @boolToInt(e > 1);
+                e10 = @intCast(i32, q) + e2;
+                const i = e - q;
+                const mul = pow_table[i];
+                const j = q + pow5_bits - pow5Bits(i);
+                vr = mulShift(mv, mul, j);
+                vp = mulShift(mp, mul, j);
+                vm = mulShift(mm, mul, j);
+                if (q <= 1) {
+                    // mv has at least two trailing zero bits.
+                    vr_tz = true;
+                    if (accept) {
+                        vm_tz = mm_shift == 1;
+                    } else {
+                        vp -= 1;
+                    }
+                } else if (q < p + 3) {
+                    vr_tz = mv & ((@as(M, 1) << @intCast(math.Log2Int(M), q)) - 1) == 0;
+                }
+            }
+
+            // Step 2: remove digits while vp and vm differ in more than the
+            // last digit.
+            var removed: i32 = 0;
+            var last: M = 0;
+            var output: M = undefined;
+            if (vm_tz or vr_tz) {
+                // The general case, which is rare.
+                while (div10(vp) > div10(vm)) : (removed += 1) {
+                    const vm_div10 = div10(vm);
+                    vm_tz = vm_tz and vm - 10 * vm_div10 == 0;
+                    vr_tz = vr_tz and last == 0;
+                    const vr_div10 = div10(vr);
+                    last = vr - 10 * vr_div10;
+                    vr = vr_div10;
+                    vp = div10(vp);
+                    vm = vm_div10;
+                }
+                if (vm_tz) {
+                    while (vm - 10 * div10(vm) == 0) : (removed += 1) {
+                        vr_tz = vr_tz and last == 0;
+                        const vr_div10 = div10(vr);
+                        last = vr - 10 * vr_div10;
+                        vr = vr_div10;
+                        vp = div10(vp);
+                        vm = div10(vm);
+                    }
+                }
+                if (vr_tz and last == 5 and vr % 2 == 0) {
+                    // Round even if the exact value is .5 (not .500001).
+                    last = 4;
+                }
+                const round_up = (vr == vm and (!accept or !vm_tz)) or last >= 5;
+                output = vr + @boolToInt(round_up);
+            } else {
+                var round_up = false;
+                while (div10(vp) > div10(vm)) : (removed += 1) {
+                    const vr_div10 = div10(vr);
+                    round_up = vr - 10 * vr_div10 >= 5;
+                    vr = vr_div10;
+                    vp = div10(vp);
+                    vm = div10(vm);
+                }
+                output = vr + @boolToInt(vr == vm or round_up);
+            }
+            return .{ .digits = output, .exponent = e10 + removed };
+        }
+
+        fn format(buf: []u8, x: T) []u8 {
+            std.debug.assert(buf.len >= formatLen(T));
+            const bits = @bitCast(Bits, x);
+            const abs_bits = bits & (math.maxInt(Bits) >> 1);
+            var n: usize = 0;
+            if (math.isNan(x)) {
+                std.mem.copy(u8, buf, "nan");
+                return buf[0..3];
+            }
+            if (bits != abs_bits) {
+                buf[0] = '-';
+                n = 1;
+            }
+            if (math.isInf(x)) {
+                std.mem.copy(u8, buf[n..], "inf");
+                return buf[0 .. n + 3];
+            }
+            if (abs_bits == 0) {
+                std.mem.copy(u8, buf[n..], "0e0");
+                return buf[0 .. n + 3];
+            }
+            const d = shortest(abs_bits);
+            return buf[0 .. n + writeDecimal(buf[n..], d.digits, d.exponent)];
+        }
+    };
+}
+
+const Decimal = struct {
+    digits: u128,
+    exponent: i32,
+};
+
+/// The high half of the 256-bit product of a and b.
+fn mulHi128(a: u128, b: u128) u128 {
+    return mul128(a, b)[1];
+}
+
+/// The 256-bit product of a and b, as low and high halves.
+pub fn mul128(a: u128, b: u128) [2]u128 {
+    const a0 = @truncate(u64, a);
+    const a1 = @truncate(u64, a >> 64);
+    const b0 = @truncate(u64, b);
+    const b1 = @truncate(u64, b >> 64);
+    const p00 = math.mulWide(u64, a0, b0);
+    const p01 = math.mulWide(u64, a0, b1);
+    const p10 = math.mulWide(u64, a1, b0);
+    const p11 = math.mulWide(u64, a1, b1);
+    // At most 3 * (2^64 - 1).
+    const mid = (p00 >> 64) + @truncate(u64, p01) + @truncate(u64, p10);
+    return .{
+        (mid << 64) | @truncate(u64, p00),
+        p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64),
+    };
+}
+
+/// floor(m * mul / 2^j), where mul is a 256-bit table entry. The result
+/// fits in 128 bits for every table entry and m from the same input, for
+/// which j is in [248, 256).
+fn mulShift(m: anytype, mul: [2]u128, j: u32) @TypeOf(m) {
+    const lo = mul128(m, mul[0]);
+    const hi = mul128(m, mul[1]);
+    var mid: u128 = undefined;
+    const carry = @addWithOverflow(u128, lo[1], hi[0], &mid);
+    const top = hi[1] + @boolToInt(carry);
+    std.debug.assert(j > 128 and j < 256);
+    const r = (top << @intCast(u7, 256 - j)) | (mid >> @intCast(u7, j - 128));
+    return @intCast(@TypeOf(m), r);
+}
+
+/// "00", "01", ..., "99".
+const digit_pairs = blk: {
+    var pairs: [200]u8 = undefined;
+    for (pairs) |*c, i| {
+        c.* = '0' + @intCast(u8, if (i % 2 == 0) i / 20 else (i / 2) % 10);
+    }
+    break :blk pairs;
+};
+
+/// Writes the low n decimal digits of x to buf[0..n], zero padded.
+fn writeDigits(buf: []u8, x: u64, n: usize) void {
+    var v = x;
+    var i = n;
+    while (i >= 2) {
+        i -= 2;
+        const pair = @intCast(usize, v % 100) * 2;
+        v /= 100;
+        buf[i] = digit_pairs[pair];
+        buf[i + 1] = digit_pairs[pair + 1];
+    }
+    if (i == 1) {
+        buf[0] = '0' + @intCast(u8, v % 10);
+    }
+}
+
+fn decimalLen(x: u128) usize {
+    var n: usize = 1;
+    var pow10: u128 = 10;
+    while (n < 39 and x >= pow10) : (n += 1) {
+        pow10 *= 10;
+    }
+    return n;
+}
+
+/// Writes digits * 10^exponent as d[.ddd]e[-]n, returning the length.
+fn writeDecimal(buf: []u8, digits: u128, exponent: i32) usize {
+    const n_digits = decimalLen(digits);
+    // Write the digits from buf[1], in chunks of 16 that fit in a u64, and
+    // then move the leading one in front of the point.
+    var v = digits;
+    var end = 1 + n_digits;
+    while (end - 1 > 16) : (end -= 16) {
+        const chunk = @intCast(u64, v % 10_000_000_000_000_000);
+        v /= 10_000_000_000_000_000;
+        writeDigits(buf[end - 16 .. end], chunk, 16);
+    }
+    writeDigits(buf[1..end], @intCast(u64, v), end - 1);
+    buf[0] = buf[1];
+    var n: usize = 1 + n_digits;
+    if (n_digits > 1) {
+        buf[1] = '.';
+    } else {
+        n = 1;
+    }
+
+    buf[n] = 'e';
+    n += 1;
+    const sci_exponent = exponent + @intCast(i32, n_digits) - 1;
+    if (sci_exponent < 0) {
+        buf[n] = '-';
+        n += 1;
+    }
+    const abs_exponent = @intCast(u64, if (sci_exponent < 0) -sci_exponent else sci_exponent);
+    const n_exponent = decimalLen(abs_exponent);
+    writeDigits(buf[n .. n + n_exponent], abs_exponent, n_exponent);
+    return n + n_exponent;
+}
+
+/// Writes the shortest decimal that rounds to x (the closest one if there
+/// are several) to buf, in scientific notation, e.g. "1.2345e-7", "1e0",
+/// "-0e0", "inf" or "nan". Returns the written part of buf, which must have
+/// room for formatLen(@TypeOf(x)) bytes.
+pub fn formatFloat(buf: []u8, x: anytype) []u8 {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64, f128 => Format(T).format(buf, x),
+        else => @compileError("formatFloat not implemented for " ++ @typeName(T)),
+    };
+}
+
+pub const FormatSliceResult = struct {
+    /// The number of elements of the input that were formatted.
+    values: usize,
+    /// The number of bytes written.
+    bytes: usize,
+};
+
+/// Writes formatFloat() of each element of xs followed by separator to buf,
+/// until all of xs is written or what is left of buf is shorter than
+/// formatLen(T) + 1, so the result can be passed to a writer and the rest
+/// of xs formatted into buf again.
+pub fn formatFloatSlice(comptime T: type, xs: []const T, buf: []u8, separator: u8) FormatSliceResult {
+    var n: usize = 0;
+    for (xs) |x, i| {
+        if (buf.len - n < formatLen(T) + 1) {
+            return .{ .values = i, .bytes = n };
+        }
+        n += formatFloat(buf[n..], x).len;
+        buf[n] = separator;
+        n += 1;
+    }
+    return .{ .values = xs.len, .bytes = n };
+}
+
+fn testFormat(x: anytype, expected: []const u8) !void {
+    var buf: [formatLen(@TypeOf(x))]u8 = undefined;
+    const s = formatFloat(&buf, x);
+    if (!std.mem.eql(u8, s, expected)) {
+        std.debug.print("formatFloat({x}) = {s}, expected {s}\n", .{ x, s, expected });
+        return error.TestExpectedEqual;
+    }
+}
+
+test "math.formatFloat() special" {
+    inline for (.{ f32, f64, f128 }) |T| {
+        try testFormat(@as(T, 0.0), "0e0");
+        try testFormat(-@as(T, 0.0), "-0e0");
+        try testFormat(math.inf(T), "inf");
+        try testFormat(-math.inf(T), "-inf");
+        try testFormat(math.nan(T), "nan");
+        try testFormat(@as(T, 1.0), "1e0");
+        try testFormat(@as(T, 0.1), "1e-1");
+    }
+}
+
+test "math.formatFloat() f32" {
+    try testFormat(@as(f32, 1.0 / 3.0), "3.3333334e-1");
+    try testFormat(@as(f32, 16777216.0), "1.6777216e7");
+    try testFormat(math.f32_max, "3.4028235e38");
+    try testFormat(math.f32_min, "1.1754944e-38");
+    try testFormat(math.f32_true_min, "1e-45");
+}
+
+test "math.formatFloat() f64" {
+    try testFormat(@as(f64, 0.3), "3e-1");
+    try testFormat(@as(f64, -2.5), "-2.5e0");
+    try testFormat(@as(f64, 123456.0), "1.23456e5");
+    try testFormat(@as(f64, 1e23), "1e23");
+    try testFormat(@as(f64, 1.0 / 3.0), "3.333333333333333e-1");
+    try testFormat(@as(f64, 9007199254740992.0), "9.007199254740992e15");
+    try testFormat(math.f64_max, "1.7976931348623157e308");
+    try testFormat(math.f64_min, "2.2250738585072014e-308");
+    try testFormat(math.f64_true_min, "5e-324");
+}
+
+test "math.formatFloat() f128" {
+    const cases = [_]struct { bits: u128, s: []const u8 }{
+        .{ .bits = 0x3ffd5555555555555555555555555555, .s = "3.333333333333333333333333333333333e-1" },
+        .{ .bits = 0x4000921fb54442d18469898cc51701b8, .s = "3.1415926535897932384626433832795028e0" },
+        .{ .bits = 0x73e6a3750647fcab18c21ab905450cc3, .s = "1e4000" },
+        .{ .bits = 0x406f0000000000000000000000000001, .s = "5.192296858534827628530496329220097e33" },
+        .{ .bits = 0x3fff0000000000000000000000000001, .s = "1.0000000000000000000000000000000002e0" },
+        .{ .bits = 0x3ffeffffffffffffffffffffffffffff, .s = "9.999999999999999999999999999999999e-1" },
+        // 36 significant digits.
+        .{ .bits = 0x6eabf7afe4fa5ae3f1c7b7c66d63507f, .s = "1.00071185688871095827867832173465905e3597" },
+        .{ .bits = 0xfb34f362657b455d281879100f1aa1c3, .s = "-1.00424401295131152830794783889886025e4563" },
+        // Max, min normal, subnormals.
+        .{ .bits = 0x7ffeffffffffffffffffffffffffffff, .s = "1.189731495357231765085759326628007e4932" },
+        .{ .bits = 0x00010000000000000000000000000000, .s = "3.3621031431120935062626778173217526e-4932" },
+        .{ .bits = 0x00000000000000000000000000000003, .s = "2e-4965" },
+        .{ .bits = 0x00000000000000000000000000000001, .s = "6e-4966" },
+    };
+    for (cases) |case| {
+        try testFormat(@bitCast(f128, case.bits), case.s);
+    }
+}
+
+test "math.formatFloatSlice()" {
+    const xs = [_]f64{ 1.0, -0.5, 1e-10, math.inf(f64), 3.0, 4.0 };
+    var buf: [64]u8 = undefined;
+    // Each value needs formatLen(f64) + 1 = 25 bytes of room, so 30 bytes
+    // take two (short) values.
+    var r = formatFloatSlice(f64, &xs, buf[0..30], '\n');
+    try expect(r.values == 2);
+    try expect(std.mem.eql(u8, buf[0..r.bytes], "1e0\n-5e-1\n"));
+    r = formatFloatSlice(f64, xs[r.values..], &buf, ' ');
+    try expect(r.values == 4);
+    try expect(std.mem.eql(u8, buf[0..r.bytes], "1e-10 inf 3e0 4e0 "));
+}
@@ -0,0 +1,65 @@
+// Compile-time control of the floating point exceptions raised by the
+// kernels.
+//
+// Following musl, the out of range paths raise overflow and underflow, and
+// some tiny-input paths raise inexact, with an extra (otherwise unneeded)
+// floating point operation. A program that never reads the exception flags
+// can compile all of these out by declaring
+//
+//     pub const f128math_fp_exceptions = false;
+//
+// in its root source file. The benchmarks built by build.zig take this from
+// the 'fp-exceptions' build option. The returned values are the same either
+// way.
+//
+// The std.math.raise*() functions of Zig 0.9 are empty, so the ones here
+// raise the exception with an f64 operation on the hardware instead. The f128
+// arithmetic itself is soft-float and never sets the flags.
+
+const std = @import("std");
+const root = @import("root");
+
+/// Whether the kernels raise floating point exceptions. This is comptime
+/// known, so code under 'if (enabled)' is removed when it's false.
+pub const enabled: bool = if (@hasDecl(root, "f128math_fp_exceptions"))
+    root.f128math_fp_exceptions
+else
+    true;
+
+/// Returns x through a volatile load, so that an operation on it isn't folded
+/// at compile time and sets the flags when run.
+fn runtimeF64(x: f64) f64 {
+    var v = x;
+    const p: *volatile f64 = &v;
+    return p.*;
+}
+
+pub fn raiseInvalid() void {
+    if (enabled) {
+        std.math.doNotOptimizeAway(runtimeF64(0.0) / runtimeF64(0.0));
+    }
+}
+
+pub fn raiseUnderflow() void {
+    if (enabled) {
+        std.math.doNotOptimizeAway(runtimeF64(0x1.0p-1022) * 0x1.0p-1022);
+    }
+}
+
+pub fn raiseOverflow() void {
+    if (enabled) {
+        std.math.doNotOptimizeAway(runtimeF64(0x1.0p1023) * 0x1.0p1023);
+    }
+}
+
+pub fn raiseInexact() void {
+    if (enabled) {
+        std.math.doNotOptimizeAway(runtimeF64(1.0) + 0x1.0p-60);
+    }
+}
+
+pub fn raiseDivByZero() void {
+    if (enabled) {
+        std.math.doNotOptimizeAway(runtimeF64(1.0) / runtimeF64(0.0));
+    }
+}
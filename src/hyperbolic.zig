@@ -0,0 +1,222 @@
+// Ported from musl, which is licensed under the MIT license:
+// https://git.musl-libc.org/cgit/musl/tree/COPYRIGHT
+//
+// https://git.musl-libc.org/cgit/musl/tree/src/math/sinh.c
+// https://git.musl-libc.org/cgit/musl/tree/src/math/cosh.c
+// https://git.musl-libc.org/cgit/musl/tree/src/math/tanh.c
+//
+// The 32-bit and 64-bit versions are delegated to std.math. The 128-bit
+// versions are built on expm1_128(), which shares the exp128() reduction, so
+// sinh and cosh can be computed together from a single reduction.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const exp_mod = @import("exp.zig");
+const expm1_128 = @import("expm1.zig").expm1_128;
+
+/// The result type of sinhcosh().
+pub fn SinhCosh(comptime T: type) type {
+    return struct {
+        sinh: T,
+        cosh: T,
+    };
+}
+
+/// Returns the hyperbolic sine of x.
+///
+/// Special Cases:
+///  - sinh(+-0)   = +-0
+///  - sinh(+-inf) = +-inf
+///  - sinh(nan)   = nan
+pub fn sinh(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64 => std.math.sinh(x),
+        f128 => sinhcosh128(x).sinh,
+        else => @compileError("sinh not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the hyperbolic cosine of x.
+///
+/// Special Cases:
+///  - cosh(+-0)   = 1
+///  - cosh(+-inf) = +inf
+///  - cosh(nan)   = nan
+pub fn cosh(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64 => std.math.cosh(x),
+        f128 => sinhcosh128(x).cosh,
+        else => @compileError("cosh not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the hyperbolic sine and cosine of x, sharing the work of the
+/// exponential between the two for 128-bit floats.
+pub fn sinhcosh(x: anytype) SinhCosh(@TypeOf(x)) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64 => .{ .sinh = std.math.sinh(x), .cosh = std.math.cosh(x) },
+        f128 => sinhcosh128(x),
+        else => @compileError("sinhcosh not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns the hyperbolic tangent of x.
+///
+/// Special Cases:
+///  - tanh(+-0)   = +-0
+///  - tanh(+-inf) = +-1
+///  - tanh(nan)   = nan
+pub fn tanh(x: anytype) @TypeOf(x) {
+    const T = @TypeOf(x);
+    return switch (T) {
+        f32, f64 => std.math.tanh(x),
+        f128 => tanh128(x),
+        else => @compileError("tanh not implemented for " ++ @typeName(T)),
+    };
+}
+
+fn sinhcosh128(x: f128) SinhCosh(f128) {
+    const ln2: f128 = 0.693147180559945309417232121458176568;
+
+    const ux = @bitCast(u128, x);
+    const sign = ux >> 127 != 0;
+    const absx = @bitCast(f128, ux & (math.maxInt(u128) >> 1));
+    const e: u16 = @intCast(u16, ux >> 112) & 0x7FFF; // exponent
+    const h: f128 = if (sign) -0.5 else 0.5;
+
+    if (math.isNan(x)) {
+        return .{ .sinh = math.nan(f128), .cosh = math.nan(f128) };
+    }
+
+    // |x| < 0x1p-57: sinh(x) = x, cosh(x) = 1
+    if (e < 0x3FFF - 57) {
+        return .{ .sinh = x, .cosh = 1 };
+    }
+
+    // |x| < log(f128_max)
+    if (absx < exp_mod.exp128_o_threshold) {
+        const t = expm1_128(absx);
+        var result: SinhCosh(f128) = undefined;
+        if (absx < 1) {
+            result.sinh = h * (2 * t - t * t / (t + 1));
+        } else {
+            result.sinh = h * (t + t / (t + 1));
+        }
+        if (absx < ln2) {
+            result.cosh = 1 + t * t / (2 * (1 + t));
+        } else {
+            result.cosh = 0.5 * (t + 1) + 0.5 / (t + 1);
+        }
+        return result;
+    }
+
+    // |x| > log(f128_max) or inf: e^-|x| is negligible and e^|x| / 2 is
+    // scaled directly from the reduction, which handles the overflow.
+    if (math.isInf(x)) {
+        return .{ .sinh = x, .cosh = absx };
+    }
+    // |x| > log(2 * f128_max): overflows, and too large for the reduction,
+    // which converts x * 128 / ln2 to an i32
+    if (absx > 11357.216553474703894801348310092223067) { // 0x1.62e9bb80635d81d36125b64da4a7p+13
+        math.raiseOverflow();
+        const v = math.inf(f128);
+        return .{ .sinh = if (sign) -v else v, .cosh = v };
+    }
+    const red = exp_mod.exp128Reduce(absx);
+    const v = math.scalbn(red.hi + red.lo, red.k - 1);
+    return .{ .sinh = if (sign) -v else v, .cosh = v };
+}
+
+fn tanh128(x: f128) f128 {
+    const ux = @bitCast(u128, x);
+    const sign = ux >> 127 != 0;
+    const absx = @bitCast(f128, ux & (math.maxInt(u128) >> 1));
+    const e: u16 = @intCast(u16, ux >> 112) & 0x7FFF; // exponent
+
+    if (math.isNan(x)) {
+        return math.nan(f128);
+    }
+
+    var t: f128 = undefined;
+    // |x| > log(3) / 2 ~= 0.5493
+    if (absx > 0.549306144334054845697622618461262852) {
+        // |x| > 40: 1 - tanh(x) < 2^-115
+        if (absx > 40) {
+            t = 1 + 0 / x;
+        } else {
+            t = expm1_128(2 * absx);
+            t = 1 - 2 / (t + 2);
+        }
+    }
+    // |x| > log(5/3) / 2 ~= 0.2554
+    else if (absx > 0.255412811882995341602706775018830648) {
+        t = expm1_128(2 * absx);
+        t = t / (t + 2);
+    }
+    // |x| >= 0x1p-57
+    else if (e >= 0x3FFF - 57) {
+        t = expm1_128(-2 * absx);
+        t = -t / (t + 2);
+    }
+    // |x| is subnormal or tiny
+    else {
+        t = absx;
+    }
+
+    return if (sign) -t else t;
+}
+
+test "math.sinh() delegation" {
+    try expect(sinh(@as(f32, 0.8923)) == std.math.sinh(@as(f32, 0.8923)));
+    try expect(sinh(@as(f64, 0.8923)) == std.math.sinh(@as(f64, 0.8923)));
+    try expect(cosh(@as(f64, 0.8923)) == std.math.cosh(@as(f64, 0.8923)));
+    try expect(tanh(@as(f64, 0.8923)) == std.math.tanh(@as(f64, 0.8923)));
+}
+
+test "math.sinhcosh128() basic" {
+    const epsilon = 0.000001;
+
+    try expect(sinh(@as(f128, 0.0)) == 0.0);
+    try expect(cosh(@as(f128, 0.0)) == 1.0);
+    try expect(math.approxEqAbs(f128, sinh(@as(f128, 0.2)), 0.201336, epsilon));
+    try expect(math.approxEqAbs(f128, sinh(@as(f128, 0.8923)), 1.015512, epsilon));
+    try expect(math.approxEqAbs(f128, sinh(@as(f128, 1.5)), 2.129279, epsilon));
+    try expect(math.approxEqAbs(f128, sinh(@as(f128, -1.5)), -2.129279, epsilon));
+    try expect(math.approxEqAbs(f128, cosh(@as(f128, 0.2)), 1.020067, epsilon));
+    try expect(math.approxEqAbs(f128, cosh(@as(f128, 0.8923)), 1.425225, epsilon));
+    try expect(math.approxEqAbs(f128, cosh(@as(f128, 1.5)), 2.352410, epsilon));
+    try expect(math.approxEqAbs(f128, cosh(@as(f128, -1.5)), 2.352410, epsilon));
+
+    const sc = sinhcosh(@as(f128, 0.8923));
+    try expect(sc.sinh == sinh(@as(f128, 0.8923)));
+    try expect(sc.cosh == cosh(@as(f128, 0.8923)));
+}
+
+test "math.tanh128() basic" {
+    const epsilon = 0.000001;
+
+    try expect(tanh(@as(f128, 0.0)) == 0.0);
+    try expect(math.approxEqAbs(f128, tanh(@as(f128, 0.2)), 0.197375, epsilon));
+    try expect(math.approxEqAbs(f128, tanh(@as(f128, 0.8923)), 0.712528, epsilon));
+    try expect(math.approxEqAbs(f128, tanh(@as(f128, 1.5)), 0.905148, epsilon));
+    try expect(math.approxEqAbs(f128, tanh(@as(f128, -1.5)), -0.905148, epsilon));
+    try expect(tanh(@as(f128, 50.0)) == 1.0);
+}
+
+test "math.sinhcosh128().special" {
+    try expect(math.isPositiveInf(sinh(math.inf(f128))));
+    try expect(math.isNegativeInf(sinh(-math.inf(f128))));
+    try expect(math.isPositiveInf(cosh(-math.inf(f128))));
+    try expect(math.isPositiveInf(cosh(@as(f128, 11357.5))));
+    try expect(math.isNan(sinh(math.nan(f128))));
+    try expect(math.isNan(cosh(math.nan(f128))));
+    try expect(tanh(math.inf(f128)) == 1.0);
+    try expect(tanh(-math.inf(f128)) == -1.0);
+    try expect(math.isNan(tanh(math.nan(f128))));
+}
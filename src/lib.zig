@@ -53,6 +53,8 @@ pub const inf_f32 = std.math.inf_f32;
 // pub const qnan_f64 = std.math.qnan_f64;
 pub const inf_u64 = std.math.inf_u64;
 pub const inf_f64 = std.math.inf_f64;
+pub const inf_u80 = @as(u80, 0x7FFF8 << 60);
+pub const inf_f80 = @bitCast(f80, inf_u80);
 // pub const nan_u128 = std.math.nan_u128;
 // pub const nan_f128 = std.math.nan_f128;
 // pub const qnan_u128 = std.math.qnan_u128;
@@ -95,7 +97,7 @@ pub const atan2 = std.math.atan2;
 pub const hypot = std.math.hypot;
 // pub const exp = std.math.exp;
 // pub const exp2 = std.math.exp2;
-pub const expm1 = std.math.expm1;
+// pub const expm1 = std.math.expm1;
 pub const ilogb = std.math.ilogb;
 pub const ln = std.math.ln;
 pub const log = std.math.log;
@@ -106,9 +108,9 @@ pub const fma = std.math.fma;
 pub const asinh = std.math.asinh;
 pub const acosh = std.math.acosh;
 pub const atanh = std.math.atanh;
-pub const sinh = std.math.sinh;
-pub const cosh = std.math.cosh;
-pub const tanh = std.math.tanh;
+// pub const sinh = std.math.sinh;
+// pub const cosh = std.math.cosh;
+// pub const tanh = std.math.tanh;
 pub const cos = std.math.cos;
 pub const sin = std.math.sin;
 pub const tan = std.math.tan;
@@ -121,11 +123,6 @@ pub const big = std.math.big;
 pub const approxEqAbs = std.math.approxEqAbs;
 pub const approxEqRel = std.math.approxEqRel;
 pub const doNotOptimizeAway = std.math.doNotOptimizeAway;
-pub const raiseInvalid = std.math.raiseInvalid;
-pub const raiseUnderflow = std.math.raiseUnderflow;
-pub const raiseOverflow = std.math.raiseOverflow;
-pub const raiseInexact = std.math.raiseInexact;
-pub const raiseDivByZero = std.math.raiseDivByZero;
 pub const floatMantissaBits = std.math.floatMantissaBits;
 pub const floatExponentBits = std.math.floatExponentBits;
 pub const Min = std.math.Min;
@@ -173,9 +170,57 @@ pub const compare = std.math.compare;
 pub const comptimeMod = std.math.comptimeMod;
 
 // Stuff that's been rewritten/modified within the package.
+pub const counters = @import("counters.zig");
+pub const cr = @import("cr.zig");
+pub const Interval = @import("directed.zig").Interval;
+pub const expDown = @import("directed.zig").expDown;
+pub const expUp = @import("directed.zig").expUp;
+pub const expInterval = @import("directed.zig").expInterval;
+pub const exp2Down = @import("directed.zig").exp2Down;
+pub const exp2Up = @import("directed.zig").exp2Up;
+pub const exp2Interval = @import("directed.zig").exp2Interval;
+pub const log2Down = @import("directed.zig").log2Down;
+pub const log2Up = @import("directed.zig").log2Up;
+pub const log2Interval = @import("directed.zig").log2Interval;
 pub const exp = @import("exp.zig").exp;
 pub const exp2 = @import("exp2.zig").exp2;
+pub const exp2_128Fixed = @import("exp2.zig").exp2_128Fixed;
+pub const exp10 = @import("exp10.zig").exp10;
+pub const expm1 = @import("expm1.zig").expm1;
+pub const fast = @import("fast.zig");
+pub const fp_exceptions = @import("fpexcept.zig").enabled;
+pub const raiseInvalid = @import("fpexcept.zig").raiseInvalid;
+pub const raiseUnderflow = @import("fpexcept.zig").raiseUnderflow;
+pub const raiseOverflow = @import("fpexcept.zig").raiseOverflow;
+pub const raiseInexact = @import("fpexcept.zig").raiseInexact;
+pub const raiseDivByZero = @import("fpexcept.zig").raiseDivByZero;
 pub const log2 = @import("log2.zig").log2;
+pub const muladd = @import("muladd.zig");
+pub const logSumExp = @import("logsumexp.zig").logSumExp;
+pub const logSumExpParallel = @import("logsumexp.zig").logSumExpParallel;
+pub const LogSumExpState = @import("logsumexp.zig").LogSumExpState;
+pub const softmax = @import("logsumexp.zig").softmax;
+pub const softmaxParallel = @import("logsumexp.zig").softmaxParallel;
+pub const ThreadPool = @import("parallel.zig").ThreadPool;
+pub const defaultPool = @import("parallel.zig").defaultPool;
+pub const expParallel = @import("parallel.zig").expParallel;
+pub const exp2Parallel = @import("parallel.zig").exp2Parallel;
+pub const log2Parallel = @import("parallel.zig").log2Parallel;
+pub const formatFloat = @import("format.zig").formatFloat;
+pub const formatFloatSlice = @import("format.zig").formatFloatSlice;
+pub const FormatSliceResult = @import("format.zig").FormatSliceResult;
+pub const formatLen = @import("format.zig").formatLen;
+pub const parseFloat = @import("parse.zig").parseFloat;
+pub const parseFloatSlice = @import("parse.zig").parseFloatSlice;
+pub const ParseSliceResult = @import("parse.zig").ParseSliceResult;
+pub const ParseFloatError = @import("parse.zig").ParseFloatError;
+pub const sinh = @import("hyperbolic.zig").sinh;
+pub const cosh = @import("hyperbolic.zig").cosh;
+pub const tanh = @import("hyperbolic.zig").tanh;
+pub const sinhcosh = @import("hyperbolic.zig").sinhcosh;
+pub const SinhCosh = @import("hyperbolic.zig").SinhCosh;
+pub const simd = @import("simd.zig");
+pub const simd32 = @import("simd32.zig");
 pub const nan = @import("nan.zig").nan;
 pub const snan = @import("nan.zig").snan;
 
@@ -191,6 +236,10 @@ pub const snan_u64 = @import("nan.zig").snan_u64;
 pub const snan_f64 = @import("nan.zig").snan_f64;
 pub const qnan_u64 = @import("nan.zig").qnan_u64;
 pub const qnan_f64 = @import("nan.zig").qnan_f64;
+pub const snan_u80 = @import("nan.zig").snan_u80;
+pub const snan_f80 = @import("nan.zig").snan_f80;
+pub const qnan_u80 = @import("nan.zig").qnan_u80;
+pub const qnan_f80 = @import("nan.zig").qnan_f80;
 pub const snan_u128 = @import("nan.zig").snan_u128;
 pub const snan_f128 = @import("nan.zig").snan_f128;
 pub const qnan_u128 = @import("nan.zig").qnan_u128;
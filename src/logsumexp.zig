@@ -0,0 +1,358 @@
+// Streaming log-sum-exp and softmax over slices.
+//
+// Computing log(sum(exp(x_i))) naively needs a pass to find the maximum (to
+// avoid overflow), a pass to sum the exponentials and a final log. Instead the
+// sum is kept relative to a running maximum and rescaled whenever a new
+// maximum is seen, so a single pass over the input is enough:
+//
+//   m' = max(m, x),  s' = s * e^(m - m') + e^(x - m')
+//
+// The sum is accumulated with Neumaier compensation, so the result does not
+// degrade with the length of the input.
+//
+// softmax needs the log-sum-exp before it can write any output, so it can't
+// be a single pass. It evaluates exp once per element instead of twice, by
+// writing the exponentials relative to the maximum and scaling them after.
+//
+// The parallel variants split the input into parts, whose number depends
+// only on its length, and run them on a parallel.ThreadPool (see
+// parallel.runTasks()), so no threads are created per call.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const parallel = @import("parallel.zig");
+const expect = std.testing.expect;
+
+/// The maximum number of parts the parallel variants split the input into.
+const max_parts = 64;
+
+/// The minimum length of each of those parts, so inputs shorter than twice
+/// this are processed on the calling thread.
+const min_parallel_len = 1 << 14;
+
+/// Running state of a streaming log-sum-exp.
+pub fn LogSumExpState(comptime T: type) type {
+    return struct {
+        const Self = @This();
+
+        /// The largest input seen so far.
+        max: T = -math.inf(T),
+        /// sum(e^(x_i - max)), with compensation term 'comp'.
+        sum: T = 0,
+        comp: T = 0,
+
+        fn addTerm(self: *Self, v: T) void {
+            // Neumaier summation - all terms are non-negative.
+            const t = self.sum + v;
+            if (self.sum >= v) {
+                self.comp += (self.sum - t) + v;
+            } else {
+                self.comp += (v - t) + self.sum;
+            }
+            self.sum = t;
+        }
+
+        fn rescale(self: *Self, new_max: T) void {
+            const scale = math.exp(self.max - new_max);
+            self.sum *= scale;
+            self.comp *= scale;
+            self.max = new_max;
+        }
+
+        /// Add a single value to the running state.
+        pub fn add(self: *Self, x: T) void {
+            if (x > self.max) {
+                self.rescale(x);
+                self.addTerm(1);
+            } else if (x == self.max) {
+                // Avoid computing e^0, and e^(-inf - -inf) = nan.
+                if (!math.isNegativeInf(x)) {
+                    self.addTerm(1);
+                }
+            } else {
+                // Also propagates nan.
+                self.addTerm(math.exp(x - self.max));
+            }
+        }
+
+        /// Add all values in a slice to the running state.
+        pub fn addSlice(self: *Self, xs: []const T) void {
+            for (xs) |x| {
+                self.add(x);
+            }
+        }
+
+        /// Combine the state from another part of the input into this one.
+        pub fn merge(self: *Self, other: Self) void {
+            if (other.max > self.max) {
+                self.rescale(other.max);
+                self.addTerm(other.sum);
+                self.comp += other.comp;
+            } else if (other.max == self.max) {
+                self.addTerm(other.sum);
+                self.comp += other.comp;
+            } else {
+                const scale = math.exp(other.max - self.max);
+                self.addTerm(other.sum * scale);
+                self.comp += other.comp * scale;
+            }
+        }
+
+        /// Returns log(sum(exp(x_i))) over the values added so far.
+        pub fn result(self: Self) T {
+            const s = self.sum + self.comp;
+            // Empty input or all -inf.
+            if (s == 0) {
+                return -math.inf(T);
+            }
+            return self.max + ln(T, s);
+        }
+    };
+}
+
+/// Natural log of a sum s >= 1.
+fn ln(comptime T: type, s: T) T {
+    return switch (T) {
+        f32, f64 => std.math.ln(s),
+        // There's no f128 log yet, so refine the f64 approximation with
+        // Newton iterations on e^y = s, each of which doubles the number of
+        // correct bits: y' = y + s * e^-y - 1.
+        f128 => blk: {
+            var y: f128 = std.math.ln(@floatCast(f64, s));
+            y += s * math.exp(-y) - 1;
+            y += s * math.exp(-y) - 1;
+            break :blk y;
+        },
+        else => @compileError("logSumExp not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// Returns log(sum(exp(x_i))) for the values in xs, in a single pass.
+///
+/// Special Cases:
+///  - logSumExp([])         = -inf
+///  - logSumExp([.., nan])  = nan
+///  - logSumExp([.., +inf]) = +inf
+pub fn logSumExp(comptime T: type, xs: []const T) T {
+    var state = LogSumExpState(T){};
+    state.addSlice(xs);
+    return state.result();
+}
+
+/// Writes the softmax of xs to out, i.e. exp(x_i) / sum(exp(x_j)). The output
+/// may alias the input.
+///
+/// exp is evaluated once per element: a first read of the input finds its
+/// maximum m, a second writes e^(x_i - m) to out while summing them, and
+/// the output is then scaled by e^(m - lse), where lse is the log-sum-exp.
+/// So each result is a product of two rounded exponentials, which costs
+/// about one ulp over exp(x_i - lse) but halves the number of exp calls.
+pub fn softmax(comptime T: type, xs: []const T, out: []T) void {
+    std.debug.assert(out.len == xs.len);
+    const state = softmaxPart(T, xs, out);
+    softmaxScale(T, xs, out, state.max, state.result());
+}
+
+/// Writes e^(x_i - max) to out for each x_i in xs, unless max is infinite,
+/// and returns the state of the log-sum-exp, relative to the maximum of xs.
+fn softmaxPart(comptime T: type, xs: []const T, out: []T) LogSumExpState(T) {
+    var state = LogSumExpState(T){};
+    for (xs) |x| {
+        if (x > state.max) {
+            state.max = x;
+        }
+    }
+    // All -inf (or empty), or a +inf, where e^(x_i - max) would be nan:
+    // only sum, and softmaxScale() writes the results.
+    if (math.isInf(state.max)) {
+        state = .{};
+        state.addSlice(xs);
+        return state;
+    }
+    for (xs) |x, i| {
+        const v = math.exp(x - state.max);
+        out[i] = v;
+        state.addTerm(v);
+    }
+    return state;
+}
+
+/// Scales the output of softmaxPart() for a part of the input whose maximum
+/// is max, given the log-sum-exp of the whole input.
+fn softmaxScale(comptime T: type, xs: []const T, out: []T, max: T, lse: T) void {
+    if (math.isInf(max)) {
+        // Nothing was written, see softmaxPart(). These results are 0, or
+        // nan for +inf (or if lse is -inf).
+        for (xs) |x, i| {
+            out[i] = math.exp(x - lse);
+        }
+        return;
+    }
+    const scale = math.exp(max - lse);
+    for (out) |*v| {
+        v.* *= scale;
+    }
+}
+
+/// The number of parts the parallel variants split an input of len elements
+/// into, which depends only on len, so that the results do too.
+fn partCount(len: usize) usize {
+    return math.min(len / min_parallel_len, max_parts);
+}
+
+fn partBounds(len: usize, n_parts: usize, i: usize) [2]usize {
+    return .{ len * i / n_parts, len * (i + 1) / n_parts };
+}
+
+fn Parallel(comptime T: type) type {
+    return struct {
+        const Self = @This();
+        const State = LogSumExpState(T);
+
+        xs: []const T,
+        /// The softmax output, unused by logSumExpParallel().
+        out: []T = undefined,
+        n_parts: usize,
+        states: *[max_parts]State,
+        /// The log-sum-exp of the whole input, for scalePart().
+        lse: T = undefined,
+
+        fn addPart(self: *const Self, i: usize) void {
+            const bounds = partBounds(self.xs.len, self.n_parts, i);
+            self.states[i].addSlice(self.xs[bounds[0]..bounds[1]]);
+        }
+
+        fn writePart(self: *const Self, i: usize) void {
+            const bounds = partBounds(self.xs.len, self.n_parts, i);
+            self.states[i] = softmaxPart(T, self.xs[bounds[0]..bounds[1]], self.out[bounds[0]..bounds[1]]);
+        }
+
+        fn scalePart(self: *const Self, i: usize) void {
+            const bounds = partBounds(self.xs.len, self.n_parts, i);
+            softmaxScale(
+                T,
+                self.xs[bounds[0]..bounds[1]],
+                self.out[bounds[0]..bounds[1]],
+                self.states[i].max,
+                self.lse,
+            );
+        }
+
+        /// Merges the states of the parts in order.
+        fn result(self: *const Self) T {
+            var state = self.states[0];
+            for (self.states[1..self.n_parts]) |other| {
+                state.merge(other);
+            }
+            return state.result();
+        }
+    };
+}
+
+/// As logSumExp(), but using the threads of pool, or of defaultPool() if
+/// pool is null.
+///
+/// The input is divided into a number of contiguous parts that depends only
+/// on its length, and the results of the parts are merged in order, so the
+/// result only depends on the input, and not on the pool or on thread
+/// scheduling.
+pub fn logSumExpParallel(comptime T: type, pool: ?*parallel.ThreadPool, xs: []const T) T {
+    const n = partCount(xs.len);
+    if (n <= 1) {
+        return logSumExp(T, xs);
+    }
+
+    var states = [_]LogSumExpState(T){.{}} ** max_parts;
+    const parts = Parallel(T){ .xs = xs, .n_parts = n, .states = &states };
+    parallel.runTasks(pool, n, &parts, Parallel(T).addPart);
+    return parts.result();
+}
+
+/// As softmax(), but using the threads of pool, or of defaultPool() if pool
+/// is null. As with logSumExpParallel(), the result only depends on the
+/// input.
+pub fn softmaxParallel(comptime T: type, pool: ?*parallel.ThreadPool, xs: []const T, out: []T) void {
+    std.debug.assert(out.len == xs.len);
+    const n = partCount(xs.len);
+    if (n <= 1) {
+        return softmax(T, xs, out);
+    }
+
+    var states: [max_parts]LogSumExpState(T) = undefined;
+    const parts = Parallel(T){ .xs = xs, .out = out, .n_parts = n, .states = &states };
+    parallel.runTasks(pool, n, &parts, Parallel(T).writePart);
+    const scaled = Parallel(T){ .xs = xs, .out = out, .n_parts = n, .states = &states, .lse = parts.result() };
+    parallel.runTasks(pool, n, &scaled, Parallel(T).scalePart);
+}
+
+test "math.logSumExp() basic" {
+    const epsilon = 0.000001;
+
+    const xs64 = [_]f64{ 0.2, 0.8923, 1.5, -1.0 };
+    try expect(math.approxEqAbs(f64, logSumExp(f64, &xs64), 2.141443, epsilon));
+    const xs128 = [_]f128{ 0.2, 0.8923, 1.5, -1.0 };
+    try expect(math.approxEqAbs(f128, logSumExp(f128, &xs128), 2.141443, epsilon));
+    const xs32 = [_]f32{ 0.2, 0.8923, 1.5, -1.0 };
+    try expect(math.approxEqAbs(f32, logSumExp(f32, &xs32), 2.141443, epsilon));
+
+    // Large values which would overflow if exponentiated directly.
+    const big = [_]f64{ 1000, 1000, 999 };
+    try expect(math.approxEqAbs(f64, logSumExp(f64, &big), 1000.861994, epsilon));
+}
+
+test "math.logSumExp().special" {
+    try expect(math.isNegativeInf(logSumExp(f64, &[_]f64{})));
+    try expect(math.isNegativeInf(logSumExp(f64, &[_]f64{ -math.inf(f64), -math.inf(f64) })));
+    try expect(math.isPositiveInf(logSumExp(f64, &[_]f64{ 1, math.inf(f64), 2 })));
+    try expect(math.isNan(logSumExp(f64, &[_]f64{ 1, math.nan(f64), 2 })));
+    try expect(logSumExp(f64, &[_]f64{ -math.inf(f64), 3 }) == 3);
+}
+
+test "math.softmax() basic" {
+    const epsilon = 0.000001;
+
+    const xs = [_]f64{ 1, 2, 3 };
+    var out: [3]f64 = undefined;
+    softmax(f64, &xs, &out);
+    try expect(math.approxEqAbs(f64, out[0], 0.090031, epsilon));
+    try expect(math.approxEqAbs(f64, out[1], 0.244728, epsilon));
+    try expect(math.approxEqAbs(f64, out[2], 0.665241, epsilon));
+}
+
+test "math.logSumExpParallel() deterministic" {
+    var xs: [1 << 16]f64 = undefined;
+    for (xs) |*x, i| {
+        x.* = @intToFloat(f64, i % 1000) / 100;
+    }
+    var pool: parallel.ThreadPool = undefined;
+    try pool.init(4);
+    defer pool.deinit();
+    var single: parallel.ThreadPool = undefined;
+    try single.init(1);
+    defer single.deinit();
+
+    const serial = logSumExp(f64, &xs);
+    const par = logSumExpParallel(f64, &pool, &xs);
+    try expect(math.approxEqRel(f64, par, serial, 1e-15));
+    // The same parts, whatever the number of threads.
+    try expect(par == logSumExpParallel(f64, &single, &xs));
+    try expect(par == logSumExpParallel(f64, null, &xs));
+
+    var out: [xs.len]f64 = undefined;
+    var out_single: [xs.len]f64 = undefined;
+    softmaxParallel(f64, &pool, &xs, &out);
+    softmaxParallel(f64, &single, &xs, &out_single);
+    try expect(std.mem.eql(f64, &out, &out_single));
+    try expect(math.approxEqRel(f64, out[999], math.exp(xs[999] - par), 1e-14));
+}
+
+test "math.softmax() special" {
+    var out: [3]f64 = undefined;
+    softmax(f64, &[_]f64{ -math.inf(f64), 1, -math.inf(f64) }, &out);
+    try expect(out[0] == 0 and out[1] == 1 and out[2] == 0);
+    softmax(f64, &[_]f64{ 1, math.inf(f64), 2 }, &out);
+    try expect(out[0] == 0 and math.isNan(out[1]) and out[2] == 0);
+    softmax(f64, &[_]f64{ -math.inf(f64), -math.inf(f64), -math.inf(f64) }, &out);
+    try expect(math.isNan(out[0]));
+}
@@ -0,0 +1,131 @@
+// Compile-time selection of fused multiply-add in the polynomials of the f64
+// exp, exp2 and log2 kernels.
+//
+// On targets with a hardware FMA, the Horner steps of the polynomials are
+// evaluated with @mulAdd, one instruction and one rounding each instead of a
+// multiply and an add. This changes a few results in the last bit (about 1 in
+// 2500 for exp, and none seen in a sample of 20000 for exp2 and log2), but
+// the error bounds stay those of the separate multiply and add. Maximum
+// errors measured against a high precision reference, either way:
+//
+//   function | f64
+//   ---------|----------
+//   exp      | 0.84 ulp
+//   exp2     | 0.503 ulp
+//   log2     | 0.68 ulp
+//
+// and exp2_64KernelParts() stays within 2^-60.31, which the correctly
+// rounded and directed rounding exp2 depend on (misc/directed_bounds.py
+// derives it for both evaluations).
+//
+// Fused is the default for the instruction count, but the speed difference
+// hasn't been measured yet: bench/muladd.zig times both, and only means
+// something on an FMA host.
+//
+// The default follows the target CPU. A program that needs the same results
+// bit for bit on every target can use the separate multiply and add
+// everywhere by declaring
+//
+//     pub const f128math_fused_mul_add = false;
+//
+// in its root source file. The root of a test build is the test runner, so
+// the test vectors are instead run for the baseline CPU (see build.zig),
+// which has no FMA on x86_64. The aarch64 baseline has one, so there the f64
+// vectors can differ in the last bit.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const root = @import("root");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+/// Whether the target CPU has a fused multiply-add instruction, so @mulAdd
+/// doesn't call the much slower software fma().
+pub const target_has_fma: bool = switch (builtin.cpu.arch) {
+    .i386, .x86_64 => std.Target.x86.featureSetHas(builtin.cpu.features, .fma),
+    .aarch64, .aarch64_be => std.Target.aarch64.featureSetHas(builtin.cpu.features, .fp_armv8),
+    else => false,
+};
+
+/// Whether the kernels use fused multiply-adds. This is comptime known, so
+/// only one of the two paths is compiled.
+pub const enabled: bool = if (@hasDecl(root, "f128math_fused_mul_add"))
+    root.f128math_fused_mul_add
+else
+    target_has_fma;
+
+/// Returns a * b + c, rounded once if fused and after both the multiply and
+/// the add otherwise. Also for vectors of f64.
+pub inline fn mulAdd(comptime fused: bool, a: anytype, b: @TypeOf(a), c: @TypeOf(a)) @TypeOf(a) {
+    if (fused) {
+        return @mulAdd(@TypeOf(a), a, b, c);
+    } else {
+        return a * b + c;
+    }
+}
+
+/// exp() for f64 with the polynomial fused or not, regardless of enabled, to
+/// compare the two on one target.
+pub fn exp(comptime fused: bool, x: f64) f64 {
+    return @import("exp.zig").exp64With(fused, x);
+}
+
+/// exp2() for f64 with the polynomial fused or not, regardless of enabled.
+pub fn exp2(comptime fused: bool, x: f64) f64 {
+    return @import("exp2.zig").exp2_64With(fused, x);
+}
+
+/// log2() for f64 with the polynomial fused or not, regardless of enabled.
+pub fn log2(comptime fused: bool, x: f64) f64 {
+    return @import("log2.zig").log2_64With(fused, x);
+}
+
+/// Returns the error of y in ulps, relative to the more precise ref.
+fn ulpError(y: f64, ref: f128) f128 {
+    const fr = math.frexp(@floatCast(f64, ref));
+    const ulp = math.scalbn(@as(f128, 1), fr.exponent - 53);
+    return math.fabs(@as(f128, y) - ref) / ulp;
+}
+
+test "math.muladd mulAdd()" {
+    // 1 + 2^-30 squared is 1 + 2^-29 + 2^-60, and the last term is lost
+    // unless the multiply isn't rounded.
+    const a: f64 = 1 + 0x1p-30;
+    try expect(mulAdd(true, a, a, -1) == 0x1p-29 + 0x1p-60);
+    try expect(mulAdd(false, a, a, -1) == 0x1p-29);
+}
+
+test "math.muladd max ulp" {
+    // The measured maxima in the table at the top of the file, rounded up.
+    var i: u32 = 0;
+    while (i < 20000) : (i += 1) {
+        const t = @intToFloat(f64, i) / 20000;
+
+        const x_exp = t * 1400 - 700;
+        const ref_exp = math.exp(@as(f128, x_exp));
+        try expect(ulpError(exp(true, x_exp), ref_exp) <= 1);
+        try expect(ulpError(exp(false, x_exp), ref_exp) <= 1);
+
+        const x_exp2 = t * 2040 - 1020;
+        const ref_exp2 = math.exp2(@as(f128, x_exp2));
+        try expect(ulpError(exp2(true, x_exp2), ref_exp2) <= 0.51);
+        try expect(ulpError(exp2(false, x_exp2), ref_exp2) <= 0.51);
+
+        const x_log2 = math.scalbn(1 + t, @intCast(i32, i % 200) - 100);
+        const ref_log2 = math.log2(@as(f128, x_log2));
+        try expect(ulpError(log2(true, x_log2), ref_log2) <= 0.7);
+        try expect(ulpError(log2(false, x_log2), ref_log2) <= 0.7);
+    }
+}
+
+test "math.muladd special" {
+    inline for (.{ false, true }) |fused| {
+        try expect(exp(fused, 0) == 1);
+        try expect(math.isPositiveInf(exp(fused, math.inf(f64))));
+        try expect(exp2(fused, -3) == 0.125);
+        try expect(exp2(fused, -math.inf(f64)) == 0);
+        try expect(log2(fused, 1) == 0);
+        try expect(math.isNan(log2(fused, -1)));
+    }
+}
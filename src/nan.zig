@@ -17,6 +17,12 @@ pub const snan_f64 = @bitCast(f64, snan_u64);
 pub const qnan_u64 = @as(u64, 0x7FF8 << 48);
 pub const qnan_f64 = @bitCast(f64, qnan_u64);
 
+pub const snan_u80 = @as(u80, 0xFFFF << 63) | 1;
+pub const snan_f80 = @bitCast(f80, snan_u80);
+
+pub const qnan_u80 = @as(u80, 0x1FFFF << 62);
+pub const qnan_f80 = @bitCast(f80, qnan_u80);
+
 pub const snan_u128 = @as(u128, 0x7FFF << 112) | 1;
 pub const snan_f128 = @bitCast(f128, snan_u128);
 
@@ -29,6 +35,7 @@ pub fn nan(comptime T: type) T {
         f16 => qnan_f16,
         f32 => qnan_f32,
         f64 => qnan_f64,
+        f80 => qnan_f80,
         f128 => qnan_f128,
         else => @compileError("nan not implemented for " ++ @typeName(T)),
     };
@@ -40,6 +47,7 @@ pub fn snan(comptime T: type) T {
         f16 => @bitCast(f16, snan_u16),
         f32 => @bitCast(f32, snan_u32),
         f64 => @bitCast(f64, snan_u64),
+        f80 => @bitCast(f80, snan_u80),
         else => @compileError("snan not implemented for " ++ @typeName(T)),
     };
 }
@@ -0,0 +1,398 @@
+// Multi-threaded evaluation of exp, exp2 and log2 over slices.
+//
+// The work runs on a ThreadPool, which is either owned by the caller or the
+// library-owned pool returned by defaultPool(). A pool keeps its threads
+// parked on a futex between calls, and a call describes its work with a Job
+// on the caller's stack, so there is no allocation or thread creation per
+// call.
+//
+// Each participating thread (the caller is one of them) starts with its own
+// contiguous range of the slice and claims chunks from the front of it,
+// sized to a quarter of what is left but never less than a per-type grain.
+// A thread whose range is empty steals chunks from the other ranges in
+// turn, so threads that are descheduled or slowed by expensive arguments
+// (e.g. the f128 kernels on a mix of normal and special inputs) don't hold
+// up the call.
+//
+// Every element is computed by the same scalar kernel whichever thread
+// claims it, so the output is identical to the serial loop. Floating point
+// exceptions raised by the kernels on pool threads are not visible in the
+// caller's floating point environment.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const Atomic = std.atomic.Atomic;
+const Futex = std.Thread.Futex;
+const expect = std.testing.expect;
+
+/// The maximum number of threads in a pool, including the calling thread.
+pub const max_threads = 64;
+
+/// Elements per chunk below which a chunk isn't worth handing to another
+/// thread, scaled by the cost of the kernels for each type so that a chunk
+/// takes roughly 10-20us.
+fn grain(comptime T: type) usize {
+    return switch (T) {
+        f16 => 1 << 14,
+        f32, f64 => 1 << 12,
+        f80 => 1 << 10,
+        f128 => 1 << 8,
+        else => @compileError("parallel evaluation not implemented for " ++ @typeName(T)),
+    };
+}
+
+/// A part of the slice still to be claimed. Kept on its own cache line, as
+/// every thread claims from its own range most of the time.
+const Range = struct {
+    next: Atomic(usize) align(64),
+    end: usize,
+
+    /// Claims a chunk from the front of the range, or returns null if the
+    /// range is empty.
+    fn claim(self: *Range, min_len: usize) ?[2]usize {
+        var start = self.next.load(.Monotonic);
+        while (start < self.end) {
+            const left = self.end - start;
+            const len = math.min(left, math.max(min_len, left / 4));
+            start = self.next.tryCompareAndSwap(start, start + len, .Monotonic, .Monotonic) orelse
+                return [2]usize{ start, start + len };
+        }
+        return null;
+    }
+};
+
+/// One call's worth of work, split between n_ranges threads.
+const Job = struct {
+    ranges: [max_threads]Range = undefined,
+    n_ranges: usize,
+    grain: usize,
+    context: *const anyopaque,
+    func: fn (context: *const anyopaque, start: usize, end: usize) void,
+
+    fn init(self: *Job, len: usize) void {
+        var i: usize = 0;
+        while (i < self.n_ranges) : (i += 1) {
+            self.ranges[i] = .{
+                .next = Atomic(usize).init(len * i / self.n_ranges),
+                .end = len * (i + 1) / self.n_ranges,
+            };
+        }
+    }
+
+    /// Works through range 'id', then steals from the following ranges
+    /// until all of them are empty. Ranges only ever shrink, so one pass
+    /// over them is enough.
+    fn work(self: *Job, id: usize) void {
+        var i: usize = 0;
+        while (i < self.n_ranges) : (i += 1) {
+            const range = &self.ranges[(id + i) % self.n_ranges];
+            while (range.claim(self.grain)) |chunk| {
+                self.func(self.context, chunk[0], chunk[1]);
+            }
+        }
+    }
+};
+
+/// A fixed set of worker threads for the parallel slice functions.
+///
+/// The pool must not be moved between init() and deinit(), as the workers
+/// hold a pointer to it. It runs one call at a time; a call made while the
+/// pool is busy (from another thread) is computed on the calling thread.
+pub const ThreadPool = struct {
+    threads: [max_threads - 1]std.Thread = undefined,
+    /// The number of worker threads, not counting the calling thread.
+    n_workers: usize = 0,
+    /// Bumped to wake the workers for a new job or for shutdown.
+    epoch: Atomic(u32) = Atomic(u32).init(0),
+    /// The number of workers that haven't finished the current job.
+    pending: Atomic(u32) = Atomic(u32).init(0),
+    busy: Atomic(bool) = Atomic(bool).init(false),
+    shutdown: bool = false,
+    job: ?*Job = null,
+
+    /// Starts a pool using up to n_threads threads for each call, the
+    /// calling thread included, so n_threads - 1 workers are spawned.
+    pub fn init(self: *ThreadPool, n_threads: usize) !void {
+        self.* = .{};
+        const n = math.min(math.max(n_threads, 1), max_threads);
+        errdefer self.deinit();
+        while (self.n_workers < n - 1) : (self.n_workers += 1) {
+            self.threads[self.n_workers] = try std.Thread.spawn(
+                .{},
+                workerMain,
+                .{ self, self.n_workers + 1 },
+            );
+        }
+    }
+
+    /// Stops and joins the worker threads.
+    pub fn deinit(self: *ThreadPool) void {
+        self.shutdown = true;
+        _ = self.epoch.fetchAdd(1, .Release);
+        Futex.wake(&self.epoch, math.maxInt(u32));
+        for (self.threads[0..self.n_workers]) |thread| {
+            thread.join();
+        }
+        self.n_workers = 0;
+    }
+
+    /// The number of threads a call can use, including the calling thread.
+    pub fn threadCount(self: *const ThreadPool) usize {
+        return self.n_workers + 1;
+    }
+
+    fn workerMain(self: *ThreadPool, id: usize) void {
+        var seen: u32 = 0;
+        while (true) {
+            var epoch = self.epoch.load(.Acquire);
+            while (epoch == seen) {
+                Futex.wait(&self.epoch, seen, null) catch unreachable;
+                epoch = self.epoch.load(.Acquire);
+            }
+            seen = epoch;
+            if (self.shutdown) return;
+
+            const job = self.job.?;
+            if (id < job.n_ranges) {
+                job.work(id);
+            }
+            if (self.pending.fetchSub(1, .Release) == 1) {
+                Futex.wake(&self.pending, 1);
+            }
+        }
+    }
+
+    /// Runs a job on the calling thread and the workers, returning once all
+    /// of it is done. Returns false without running it if the pool is busy.
+    fn run(self: *ThreadPool, job: *Job) bool {
+        if (self.busy.compareAndSwap(false, true, .Acquire, .Monotonic) != null) {
+            return false;
+        }
+        defer self.busy.store(false, .Release);
+
+        self.job = job;
+        self.pending.store(@intCast(u32, self.n_workers), .Monotonic);
+        _ = self.epoch.fetchAdd(1, .Release);
+        Futex.wake(&self.epoch, math.maxInt(u32));
+
+        job.work(0);
+
+        var pending = self.pending.load(.Acquire);
+        while (pending != 0) {
+            Futex.wait(&self.pending, pending, null) catch unreachable;
+            pending = self.pending.load(.Acquire);
+        }
+        self.job = null;
+        return true;
+    }
+};
+
+var default_pool: ThreadPool = .{};
+var default_pool_once = std.once(initDefaultPool);
+
+fn initDefaultPool() void {
+    const n = std.Thread.getCpuCount() catch 1;
+    // Without threads every call runs on the calling thread.
+    default_pool.init(n) catch {};
+}
+
+/// Returns the library-owned pool, which has one thread per CPU and is
+/// started by the first call. It lives until the process exits.
+pub fn defaultPool() *ThreadPool {
+    default_pool_once.call();
+    return &default_pool;
+}
+
+/// Calls func(context, i) once for each i < n_tasks, using the threads of
+/// pool, or of defaultPool() if pool is null. Which thread runs which task
+/// isn't determined, so tasks should only write their own part of the
+/// output for the result to be reproducible.
+pub fn runTasks(
+    pool: ?*ThreadPool,
+    n_tasks: usize,
+    context: anytype,
+    comptime func: fn (@TypeOf(context), usize) void,
+) void {
+    const Context = @TypeOf(context);
+    const Tasks = struct {
+        const Self = @This();
+
+        context: Context,
+
+        fn serial(ctx: Context, start: usize, end: usize) void {
+            var i = start;
+            while (i < end) : (i += 1) {
+                func(ctx, i);
+            }
+        }
+
+        fn chunk(c: *const anyopaque, start: usize, end: usize) void {
+            const self = @ptrCast(*const Self, @alignCast(@alignOf(Self), c));
+            serial(self.context, start, end);
+        }
+    };
+
+    const p = pool orelse defaultPool();
+    const n = math.min(p.threadCount(), n_tasks);
+    if (n <= 1) {
+        return Tasks.serial(context, 0, n_tasks);
+    }
+
+    const tasks = Tasks{ .context = context };
+    var job = Job{
+        .n_ranges = n,
+        .grain = 1,
+        .context = &tasks,
+        .func = Tasks.chunk,
+    };
+    job.init(n_tasks);
+    if (!p.run(&job)) {
+        Tasks.serial(context, 0, n_tasks);
+    }
+}
+
+fn Map(comptime T: type, comptime func: fn (T) T) type {
+    return struct {
+        const Self = @This();
+
+        xs: []const T,
+        out: []T,
+
+        fn serial(xs: []const T, out: []T) void {
+            for (xs) |x, i| {
+                out[i] = func(x);
+            }
+        }
+
+        fn chunk(context: *const anyopaque, start: usize, end: usize) void {
+            const self = @ptrCast(*const Self, @alignCast(@alignOf(Self), context));
+            serial(self.xs[start..end], self.out[start..end]);
+        }
+
+        fn run(pool: ?*ThreadPool, xs: []const T, out: []T) void {
+            std.debug.assert(out.len == xs.len);
+            const p = pool orelse defaultPool();
+            const n = math.min(p.threadCount(), xs.len / grain(T));
+            if (n <= 1) {
+                return serial(xs, out);
+            }
+
+            const self = Self{ .xs = xs, .out = out };
+            var job = Job{
+                .n_ranges = n,
+                .grain = grain(T),
+                .context = &self,
+                .func = chunk,
+            };
+            job.init(xs.len);
+            if (!p.run(&job)) {
+                serial(xs, out);
+            }
+        }
+    };
+}
+
+fn Funcs(comptime T: type) type {
+    return struct {
+        fn exp(x: T) T {
+            return math.exp(x);
+        }
+        fn exp2(x: T) T {
+            return math.exp2(x);
+        }
+        fn log2(x: T) T {
+            return math.log2(x);
+        }
+    };
+}
+
+/// Writes exp(x) for each x in xs to out, using the threads of pool, or of
+/// defaultPool() if pool is null. The output may alias the input.
+pub fn expParallel(comptime T: type, pool: ?*ThreadPool, xs: []const T, out: []T) void {
+    Map(T, Funcs(T).exp).run(pool, xs, out);
+}
+
+/// Writes exp2(x) for each x in xs to out, using the threads of pool, or of
+/// defaultPool() if pool is null. The output may alias the input.
+pub fn exp2Parallel(comptime T: type, pool: ?*ThreadPool, xs: []const T, out: []T) void {
+    Map(T, Funcs(T).exp2).run(pool, xs, out);
+}
+
+/// Writes log2(x) for each x in xs to out, using the threads of pool, or of
+/// defaultPool() if pool is null. The output may alias the input.
+pub fn log2Parallel(comptime T: type, pool: ?*ThreadPool, xs: []const T, out: []T) void {
+    Map(T, Funcs(T).log2).run(pool, xs, out);
+}
+
+fn testMatchesSerial(comptime T: type, pool: ?*ThreadPool, len: usize) !void {
+    const allocator = std.testing.allocator;
+    const xs = try allocator.alloc(T, len);
+    defer allocator.free(xs);
+    const out = try allocator.alloc(T, len);
+    defer allocator.free(out);
+
+    for (xs) |*x, i| {
+        x.* = @intToFloat(T, @intCast(i32, i % 2000) - 1000) / 16;
+    }
+    expParallel(T, pool, xs, out);
+    for (xs) |x, i| {
+        try expect(out[i] == math.exp(x));
+    }
+    exp2Parallel(T, pool, xs, out);
+    for (xs) |x, i| {
+        try expect(out[i] == math.exp2(x));
+    }
+    // In place, and including negative arguments (nan).
+    log2Parallel(T, pool, xs, xs);
+    for (xs) |x, i| {
+        const y = @intToFloat(T, @intCast(i32, i % 2000) - 1000) / 16;
+        const want = math.log2(y);
+        try expect(x == want or (math.isNan(x) and math.isNan(want)));
+    }
+}
+
+test "math.expParallel() matches serial" {
+    var pool: ThreadPool = undefined;
+    try pool.init(4);
+    defer pool.deinit();
+
+    try testMatchesSerial(f16, &pool, 1 << 16);
+    try testMatchesSerial(f32, &pool, 100_003);
+    try testMatchesSerial(f64, &pool, 100_003);
+    try testMatchesSerial(f80, &pool, 10_007);
+    try testMatchesSerial(f128, &pool, 10_007);
+    // Too short to split.
+    try testMatchesSerial(f64, &pool, 100);
+    try testMatchesSerial(f64, &pool, 0);
+}
+
+test "math.expParallel() default pool" {
+    try testMatchesSerial(f64, null, 100_003);
+    try expect(defaultPool() == defaultPool());
+}
+
+test "math.ThreadPool single thread" {
+    var pool: ThreadPool = undefined;
+    try pool.init(1);
+    defer pool.deinit();
+    try expect(pool.threadCount() == 1);
+    try testMatchesSerial(f64, &pool, 100_003);
+}
+
+fn testTask(out: []usize, i: usize) void {
+    out[i] = i * i;
+}
+
+test "math.runTasks()" {
+    var pool: ThreadPool = undefined;
+    try pool.init(4);
+    defer pool.deinit();
+
+    var out = [_]usize{0} ** 100;
+    runTasks(&pool, out.len, @as([]usize, &out), testTask);
+    for (out) |v, i| {
+        try expect(v == i * i);
+    }
+    runTasks(null, 0, @as([]usize, &out), testTask);
+}
@@ -0,0 +1,685 @@
+// Correctly rounded parsing of f128 from decimal and hex-float strings.
+//
+// Accepted are an optional sign followed by
+//   - decimal digits with an optional point and an optional exponent
+//     ("1", "-0.5", ".25e-3", "1E4932"),
+//   - "0x" and hex digits with an optional point and an optional binary
+//     exponent ("0x1.8p3", "0x.Fp-1"),
+//   - "inf", "infinity" or "nan" in any case.
+// The result is the nearest f128 (ties to even), as for strtoflt128.
+//
+// Hex floats are exact up to 31 digits, with any further digits only
+// deciding the rounding. Decimals go through the fastest of:
+//   - Clinger's fast path: up to 2^113 times or divided by up to 10^48,
+//     which are exact in f128, so a single f128 operation rounds correctly.
+//   - Eisel-Lemire: the first 38 significant digits (in a u128) times a
+//     255-bit approximation of 10^q from the tables in format.zig. The top
+//     128 bits of the product decide the rounding unless the approximation
+//     error (or the digits after the 38th) could carry into them or make it
+//     a tie, which is rare for anything other than exact halfway points.
+//   - Comparing the exact decimal with halfway points between f128 values
+//     in big integer arithmetic, starting from the Eisel-Lemire estimate.
+
+const std = @import("std");
+// const math = std.math;
+const math = @import("lib.zig");
+const format = @import("format.zig");
+const expect = std.testing.expect;
+
+pub const ParseFloatError = error{InvalidCharacter};
+
+const p = math.floatMantissaBits(f128);
+const bias = (1 << (math.floatExponentBits(f128) - 1)) - 1;
+const inf_bits = @as(u128, 0x7FFF) << p;
+
+const tables = format.Pow5Tables(f128);
+
+/// The number of significant decimal digits kept for the fast paths.
+const max_fast_digits = 38;
+
+/// The number of significant decimal digits kept for the big integer
+/// comparisons. Halfway points between f128 values have at most 11564
+/// significant digits, so the digits past these can only break ties.
+const max_digits = 11600;
+
+/// Limits the exponent, beyond which every input over- or underflows.
+const max_exponent = 1 << 40;
+
+/// A number split into its digits, which may include a point, and the
+/// exponent after the exponent marker.
+const Number = struct {
+    digits: []const u8,
+    exponent: i64,
+};
+
+fn digitValue(c: u8, comptime hex: bool) ?u8 {
+    return switch (c) {
+        '0'...'9' => c - '0',
+        'a'...'f' => if (hex) c - 'a' + 10 else null,
+        'A'...'F' => if (hex) c - 'A' + 10 else null,
+        else => null,
+    };
+}
+
+fn parseExponent(s: []const u8) ParseFloatError!i64 {
+    var i: usize = 0;
+    var negative = false;
+    if (s.len > 0 and (s[0] == '+' or s[0] == '-')) {
+        negative = s[0] == '-';
+        i = 1;
+    }
+    if (i == s.len) return error.InvalidCharacter;
+    var e: i64 = 0;
+    for (s[i..]) |c| {
+        const d = digitValue(c, false) orelse return error.InvalidCharacter;
+        if (e < max_exponent) {
+            e = e * 10 + d;
+        }
+    }
+    return if (negative) -e else e;
+}
+
+fn splitNumber(s: []const u8, comptime hex: bool) ParseFloatError!Number {
+    var i: usize = 0;
+    var n_digits: usize = 0;
+    var seen_point = false;
+    while (i < s.len) : (i += 1) {
+        if (s[i] == '.' and !seen_point) {
+            seen_point = true;
+        } else if (digitValue(s[i], hex) != null) {
+            n_digits += 1;
+        } else {
+            break;
+        }
+    }
+    if (n_digits == 0) return error.InvalidCharacter;
+    if (i == s.len) {
+        return Number{ .digits = s, .exponent = 0 };
+    }
+    const marker: u8 = if (hex) 'p' else 'e';
+    if (std.ascii.toLower(s[i]) != marker) return error.InvalidCharacter;
+    return Number{ .digits = s[0..i], .exponent = try parseExponent(s[i + 1 ..]) };
+}
+
+/// Where the significant digits of a decimal end up: the kept digits times
+/// 10^q, plus something below one unit of the last kept digit if truncated.
+const Scaled = struct {
+    q: i64,
+    truncated: bool,
+};
+
+/// Feeds the significant digits of a decimal, which may include a point,
+/// to acc.push(), up to limit of them.
+fn scanDecimal(digits: []const u8, limit: usize, acc: anytype) Scaled {
+    var n: usize = 0;
+    var q: i64 = 0;
+    var truncated = false;
+    var after_point = false;
+    for (digits) |c| {
+        if (c == '.') {
+            after_point = true;
+            continue;
+        }
+        const d = c - '0';
+        if (n == 0 and d == 0) {
+            // Leading zeros.
+            q -= @boolToInt(after_point);
+        } else if (n < limit) {
+            acc.push(d);
+            n += 1;
+            q -= @boolToInt(after_point);
+        } else {
+            truncated = truncated or d != 0;
+            q += @boolToInt(!after_point);
+        }
+    }
+    return .{ .q = q, .truncated = truncated };
+}
+
+const U128Digits = struct {
+    w: u128 = 0,
+
+    fn push(self: *U128Digits, d: u8) void {
+        self.w = self.w * 10 + d;
+    }
+};
+
+/// Rounds m * 2^e to f128 bits, where a nonzero amount below 2^e is added if
+/// sticky. m must be nonzero, and have at least p + 3 bits if sticky.
+fn roundToF128(m: u128, e: i32, sticky: bool) u128 {
+    std.debug.assert(m != 0);
+    const top = 127 - @intCast(i32, @clz(u128, m));
+    const exp = top + e;
+    if (exp > bias) return inf_bits;
+
+    // The number of bits of m below the last bit of the result.
+    var s = top - p;
+    var biased = exp + bias;
+    if (exp < 1 - bias) {
+        s += 1 - bias - exp;
+        biased = 0;
+    }
+    var q: u128 = undefined;
+    if (s <= 0) {
+        std.debug.assert(!sticky);
+        q = m << @intCast(u7, -s);
+    } else if (s >= 128) {
+        // Below the smallest subnormal, which it rounds up to if above half
+        // of it.
+        return @boolToInt(s == 128 and (m > 1 << 127 or (m == 1 << 127 and sticky)));
+    } else {
+        const shift = @intCast(u7, s);
+        q = m >> shift;
+        const dropped = m & ((@as(u128, 1) << shift) - 1);
+        const half = @as(u128, 1) << (shift - 1);
+        if (dropped > half or (dropped == half and (sticky or q & 1 == 1))) {
+            q += 1;
+        }
+    }
+    if (biased == 0) {
+        // Rounding up to 2^p gives the smallest normal.
+        return q;
+    }
+    // q includes the implicit bit, and rounding up to 2^(p + 1) carries into
+    // the exponent (up to inf).
+    return (@intCast(u128, biased - 1) << p) + q;
+}
+
+fn parseHex(s: []const u8) ParseFloatError!u128 {
+    const number = try splitNumber(s, true);
+    var m: u128 = 0;
+    var e = number.exponent;
+    var sticky = false;
+    var after_point = false;
+    for (number.digits) |c| {
+        if (c == '.') {
+            after_point = true;
+            continue;
+        }
+        const d = digitValue(c, true).?;
+        if (m == 0 and d == 0) {
+            e -= 4 * @as(i64, @boolToInt(after_point));
+        } else if (m >> 124 == 0) {
+            m = m << 4 | d;
+            e -= 4 * @as(i64, @boolToInt(after_point));
+        } else {
+            // m has at least 125 bits.
+            sticky = sticky or d != 0;
+            e += 4 * @as(i64, @boolToInt(!after_point));
+        }
+    }
+    if (m == 0) return 0;
+    // Far enough out to round to inf or 0.
+    const e_limit = 2 * (bias + p + 128);
+    return roundToF128(m, @intCast(i32, math.clamp(e, -e_limit, e_limit)), sticky);
+}
+
+/// f128 powers of ten that are exact.
+const exact_pow10 = blk: {
+    var table: [49]f128 = undefined;
+    table[0] = 1;
+    for (table[1..]) |*x, i| {
+        x.* = table[i] * 10;
+    }
+    break :blk table;
+};
+
+/// w * 10^q as hi * 2^e + (mid * 2^128 + lo) * 2^(e - 256), with the error
+/// of the table entry for q.
+const Product = struct {
+    hi: u128,
+    mid: u128,
+    lo: u128,
+    e: i32,
+};
+
+fn product(w: u128, q: i32) Product {
+    const lz = @clz(u128, w);
+    const wn = w << lz;
+    var entry: [2]u128 = undefined;
+    var e: i32 = undefined;
+    // The entries are 2^(pow5_bits - pow5Bits(i)) * 5^i for q = i >= 0, and
+    // 2^(pow5Bits(i) + pow5_bits - 1) / 5^i for q = -i < 0.
+    if (q >= 0) {
+        const i = @intCast(u32, q);
+        entry = tables.pow[i];
+        e = q + @intCast(i32, format.pow5Bits(i)) - format.pow5_bits;
+    } else {
+        const i = @intCast(u32, -q);
+        entry = tables.inv[i];
+        e = q - @intCast(i32, format.pow5Bits(i)) - (format.pow5_bits - 1);
+    }
+    const a = format.mul128(wn, entry[0]);
+    const b = format.mul128(wn, entry[1]);
+    var mid: u128 = undefined;
+    const carry = @addWithOverflow(u128, a[1], b[0], &mid);
+    return .{
+        .hi = b[1] + @boolToInt(carry),
+        .mid = mid,
+        .lo = a[0],
+        .e = e - @intCast(i32, lz) + 256,
+    };
+}
+
+/// w mod 5, using 2^64 = 1 (mod 5) to stay in 64-bit arithmetic.
+fn mod5(w: u128) u64 {
+    return (@truncate(u64, w) % 5 + @truncate(u64, w >> 64) % 5) % 5;
+}
+
+/// The f128 bits nearest to w * 10^q, or null if the product with the table
+/// entry isn't accurate enough to tell.
+fn eiselLemire(w: u128, q: i32) ?u128 {
+    const prod = product(w, q);
+    // hi has 125 or more bits, so the rounding bit is in hi.
+    if (q >= 0 and format.pow5Bits(@intCast(u32, q)) <= format.pow5_bits) {
+        // The entry, and so the product, is exact.
+        return roundToF128(prod.hi, prod.e, prod.mid != 0 or prod.lo != 0);
+    }
+    if (q >= 0) {
+        // The entry is below 5^q by less than 1, so the exact product is
+        // above by less than 2^128, which can only carry into hi if mid is
+        // all ones. It isn't exact, as w * 5^q has more than p + 1 bits.
+        if (prod.mid == math.maxInt(u128)) return null;
+        return roundToF128(prod.hi, prod.e, true);
+    }
+    // The entry is above 2^k / 5^-q by at most 1, so the exact product is
+    // below by less than 2^128, which can only borrow from hi if mid is 0.
+    if (prod.mid == 0) return null;
+    // It's exact, or a tie, only if w is a multiple of 5^-q, and 5^55 > w.
+    if (q > -55 and mod5(w) == 0) {
+        if (w % std.math.pow(u128, 5, @intCast(u128, -q)) == 0) return null;
+    }
+    return roundToF128(prod.hi, prod.e, true);
+}
+
+/// A fixed size big integer for the fallback, with room for max_digits
+/// digits times 5^-q, or the equivalent for halfway points.
+const BigInt = struct {
+    const max_limbs = 1280;
+
+    /// Little endian, without leading zero limbs.
+    limbs: [max_limbs]u32 = undefined,
+    len: usize = 0,
+
+    fn init(x: u128) BigInt {
+        var self = BigInt{};
+        var v = x;
+        while (v != 0) : (v >>= 32) {
+            self.limbs[self.len] = @truncate(u32, v);
+            self.len += 1;
+        }
+        return self;
+    }
+
+    /// Sets self to x, copying only the limbs in use rather than the whole
+    /// 5 KB array.
+    fn set(self: *BigInt, x: *const BigInt) void {
+        std.mem.copy(u32, self.limbs[0..x.len], x.limbs[0..x.len]);
+        self.len = x.len;
+    }
+
+    fn mulAdd(self: *BigInt, m: u32, a: u32) void {
+        var carry: u64 = a;
+        for (self.limbs[0..self.len]) |*limb| {
+            const t = @as(u64, limb.*) * m + carry;
+            limb.* = @truncate(u32, t);
+            carry = t >> 32;
+        }
+        if (carry != 0) {
+            self.limbs[self.len] = @truncate(u32, carry);
+            self.len += 1;
+        }
+    }
+
+    fn mulPow5(self: *BigInt, n: u32) void {
+        // 5^13 is the largest power of 5 that fits in a u32.
+        var left = n;
+        while (left >= 13) : (left -= 13) {
+            self.mulAdd(1220703125, 0);
+        }
+        self.mulAdd(std.math.pow(u32, 5, left), 0);
+    }
+
+    fn shl(self: *BigInt, n: u32) void {
+        if (self.len == 0) return;
+        const limbs = n / 32;
+        const bits = @intCast(u5, n % 32);
+        std.debug.assert(self.len + limbs < max_limbs);
+        var i = self.len;
+        self.limbs[self.len + limbs] = 0;
+        while (i > 0) {
+            i -= 1;
+            const limb = self.limbs[i];
+            if (bits != 0) {
+                self.limbs[i + limbs + 1] |= limb >> @intCast(u5, 32 - @as(u6, bits));
+            }
+            self.limbs[i + limbs] = limb << bits;
+        }
+        std.mem.set(u32, self.limbs[0..limbs], 0);
+        self.len += limbs + 1;
+        while (self.len > 0 and self.limbs[self.len - 1] == 0) {
+            self.len -= 1;
+        }
+    }
+
+    fn order(a: *const BigInt, b: *const BigInt) std.math.Order {
+        if (a.len != b.len) {
+            return std.math.order(a.len, b.len);
+        }
+        var i = a.len;
+        while (i > 0) {
+            i -= 1;
+            if (a.limbs[i] != b.limbs[i]) {
+                return std.math.order(a.limbs[i], b.limbs[i]);
+            }
+        }
+        return .eq;
+    }
+};
+
+/// Collects decimal digits into a BigInt, 9 at a time.
+const BigIntDigits = struct {
+    big: BigInt = .{},
+    chunk: u32 = 0,
+    n_chunk: u32 = 0,
+
+    fn push(self: *BigIntDigits, d: u8) void {
+        self.chunk = self.chunk * 10 + d;
+        self.n_chunk += 1;
+        if (self.n_chunk == 9) {
+            self.flush();
+        }
+    }
+
+    fn flush(self: *BigIntDigits) void {
+        self.big.mulAdd(std.math.pow(u32, 10, self.n_chunk), self.chunk);
+        self.chunk = 0;
+        self.n_chunk = 0;
+    }
+};
+
+/// The exact decimal for the fallback.
+const BigDecimal = struct {
+    digits: *const BigInt,
+    q: i32,
+    truncated: bool,
+
+    /// Compares the decimal with c * 2^k.
+    fn compare(self: *const BigDecimal, c: u128, k: i32) std.math.Order {
+        var a: BigInt = undefined;
+        a.set(self.digits);
+        var b = BigInt.init(c);
+        if (self.q >= 0) {
+            a.mulPow5(@intCast(u32, self.q));
+        } else {
+            b.mulPow5(@intCast(u32, -self.q));
+        }
+        if (self.q > k) {
+            a.shl(@intCast(u32, self.q - k));
+        } else {
+            b.shl(@intCast(u32, k - self.q));
+        }
+        const order = BigInt.order(&a, &b);
+        // The dropped digits can't make a difference other than to ties, as
+        // the halfway points have fewer than max_digits digits.
+        return if (order == .eq and self.truncated) .gt else order;
+    }
+};
+
+/// Rounds the decimal exactly, starting from the estimate hi * 2^e.
+fn parseBig(digits: []const u8, exponent: i64, estimate: Product) u128 {
+    var acc = BigIntDigits{};
+    const scaled = scanDecimal(digits, max_digits, &acc);
+    acc.flush();
+    const d = BigDecimal{
+        .digits = &acc.big,
+        .q = @intCast(i32, scaled.q + exponent),
+        .truncated = scaled.truncated,
+    };
+
+    // Find the exponent e of the last mantissa bit, so that the decimal is
+    // in [2^(e + p), 2^(e + p + 1)), or the subnormal exponent.
+    const e_min = 1 - bias - p;
+    const hi_bits = 128 - @intCast(i32, @clz(u128, estimate.hi));
+    var e = math.max(estimate.e + hi_bits - (p + 1), e_min);
+    while (d.compare(1, e + p + 1) != .lt) {
+        e += 1;
+    }
+    while (e > e_min and d.compare(1, e + p) == .lt) {
+        e -= 1;
+    }
+
+    // Then the mantissa m, so that the decimal is in [m - 1/2, m + 1/2]
+    // times 2^e, and even at either end.
+    const shift = e - estimate.e;
+    var m: u128 = 0;
+    if (shift < 0) {
+        m = estimate.hi << @intCast(u7, -shift);
+    } else if (shift < 128) {
+        m = estimate.hi >> @intCast(u7, shift);
+    }
+    while (d.compare(2 * m + 1, e - 1) == .gt) {
+        m += 1;
+    }
+    while (m > 0 and d.compare(2 * m - 1, e - 1) == .lt) {
+        m -= 1;
+    }
+    if (m & 1 == 1) {
+        if (d.compare(2 * m + 1, e - 1) == .eq) {
+            m += 1;
+        } else if (d.compare(2 * m - 1, e - 1) == .eq) {
+            m -= 1;
+        }
+    }
+    if (m == 0) return 0;
+    return roundToF128(m, e, false);
+}
+
+fn parseDecimal(s: []const u8) ParseFloatError!u128 {
+    const number = try splitNumber(s, false);
+    var acc = U128Digits{};
+    const scaled = scanDecimal(number.digits, max_fast_digits, &acc);
+    const w = acc.w;
+    if (w == 0) return 0;
+
+    const q = scaled.q + number.exponent;
+    // w < 10^38, so w * 10^q overflows for q past the largest f128 decimal
+    // exponent, and rounds to 0 for q less than the smallest one minus 38.
+    if (q >= tables.pow.len) return inf_bits;
+    if (q <= -@as(i64, tables.inv.len)) return 0;
+
+    if (!scaled.truncated and w <= 1 << (p + 1) and q >= -48 and q <= 48) {
+        const x = @intToFloat(f128, w);
+        const r = if (q >= 0)
+            x * exact_pow10[@intCast(usize, q)]
+        else
+            x / exact_pow10[@intCast(usize, -q)];
+        return @bitCast(u128, r);
+    }
+
+    const q32 = @intCast(i32, q);
+    if (eiselLemire(w, q32)) |bits| {
+        if (!scaled.truncated) return bits;
+        // The exact value is between w and w + 1 times 10^q.
+        if (eiselLemire(w + 1, q32)) |bits_up| {
+            if (bits_up == bits) return bits;
+        }
+    }
+    return parseBig(number.digits, number.exponent, product(w, q32));
+}
+
+fn parse128(s: []const u8) ParseFloatError!f128 {
+    var rest = s;
+    var sign: u128 = 0;
+    if (rest.len > 0 and (rest[0] == '+' or rest[0] == '-')) {
+        sign = @as(u128, @boolToInt(rest[0] == '-')) << 127;
+        rest = rest[1..];
+    }
+    var bits: u128 = undefined;
+    if (std.ascii.eqlIgnoreCase(rest, "inf") or std.ascii.eqlIgnoreCase(rest, "infinity")) {
+        bits = inf_bits;
+    } else if (std.ascii.eqlIgnoreCase(rest, "nan")) {
+        bits = math.qnan_u128;
+    } else if (rest.len > 2 and rest[0] == '0' and (rest[1] == 'x' or rest[1] == 'X')) {
+        bits = try parseHex(rest[2..]);
+    } else {
+        bits = try parseDecimal(rest);
+    }
+    return @bitCast(f128, sign | bits);
+}
+
+/// Parses a decimal or hex-float string to the nearest T (ties to even).
+pub fn parseFloat(comptime T: type, s: []const u8) ParseFloatError!T {
+    return switch (T) {
+        f128 => parse128(s),
+        else => @compileError("parseFloat not implemented for " ++ @typeName(T)),
+    };
+}
+
+pub const ParseSliceResult = struct {
+    /// The number of values parsed into the output.
+    values: usize,
+    /// The number of bytes of the input consumed.
+    bytes: usize,
+};
+
+/// Parses whitespace separated values from buf into out, until out is full
+/// or buf is used up. A value running to the end of buf might continue in
+/// the next read, so it's only parsed if end_of_input, and otherwise left
+/// unconsumed for the caller to carry over.
+pub fn parseFloatSlice(
+    comptime T: type,
+    buf: []const u8,
+    out: []T,
+    end_of_input: bool,
+) ParseFloatError!ParseSliceResult {
+    var i: usize = 0;
+    var n: usize = 0;
+    while (n < out.len) {
+        while (i < buf.len and std.ascii.isSpace(buf[i])) {
+            i += 1;
+        }
+        var end = i;
+        while (end < buf.len and !std.ascii.isSpace(buf[end])) {
+            end += 1;
+        }
+        if (end == i or (end == buf.len and !end_of_input)) break;
+        out[n] = try parseFloat(T, buf[i..end]);
+        n += 1;
+        i = end;
+    }
+    return .{ .values = n, .bytes = i };
+}
+
+fn testParse(s: []const u8, bits: u128) !void {
+    const x = try parseFloat(f128, s);
+    if (@bitCast(u128, x) != bits) {
+        std.debug.print(
+            "parseFloat({s}) = 0x{X:0>32}, expected 0x{X:0>32}\n",
+            .{ s, @bitCast(u128, x), bits },
+        );
+        return error.TestExpectedEqual;
+    }
+}
+
+test "math.parseFloat() decimal" {
+    try testParse("1", 0x3fff0000000000000000000000000000);
+    try testParse("-1.0", 0xbfff0000000000000000000000000000);
+    try testParse("+.5e1", 0x40014000000000000000000000000000);
+    try testParse("0.1", 0x3ffb999999999999999999999999999a);
+    try testParse("3.1415926535897932384626433832795028", 0x4000921fb54442d18469898cc51701b8);
+    try testParse(
+        "2.7182818284590452353602874713526624977572470936999595749669676277",
+        0x40005bf0a8b1457695355fb8ac404e7a,
+    );
+    try testParse("1e4932", 0x7ffeae596552b8fded99d037e3d04b75);
+    try testParse("1E-4932", 0x00004c248f91e526afe05adf4e3af004);
+    try testParse("123456789012345678901234567890123456789e-4950", 0x0041fd9807441e6e8cbea9feed853854);
+    // 2^113 + 1 and + 3, which are ties.
+    try testParse("10384593717069655257060992658440193", 0x40700000000000000000000000000000);
+    try testParse("10384593717069655257060992658440195", 0x40700000000000000000000000000002);
+}
+
+test "math.parseFloat() decimal boundaries" {
+    try testParse("1.189731495357231765085759326628007e4932", 0x7ffeffffffffffffffffffffffffffff);
+    try testParse("1.18973149535723176508575932662800702e4932", 0x7ffeffffffffffffffffffffffffffff);
+    try testParse("1.1897314953572317650857593266280071e4932", 0x7fff0000000000000000000000000000);
+    try testParse("1e5000", 0x7fff0000000000000000000000000000);
+    try testParse("6.475175119438025110924438958227647e-4966", 1);
+    try testParse("4.9e-4966", 1);
+    try testParse("3.3e-4966", 1);
+    try testParse("3.2e-4966", 0);
+    try testParse("1e-5000", 0);
+    try testParse("-0", 0x80000000000000000000000000000000);
+    try testParse("0.000e100000", 0);
+}
+
+test "math.parseFloat() decimal halfway" {
+    // 1 + 2^-113 exactly, which is a tie, and then just above and below.
+    const half = "1.00000000000000000000000000000000009629649721936179265279889712924636592690508241076940976199693977832794189453125";
+    try testParse(half, 0x3fff0000000000000000000000000000);
+    try testParse(half[0 .. half.len - 1] ++ "6", 0x3fff0000000000000000000000000001);
+    try testParse(half ++ "0000000000000000000000000000001", 0x3fff0000000000000000000000000001);
+    try testParse(half[0 .. half.len - 1] ++ "4999999999999999999999999999999", 0x3fff0000000000000000000000000000);
+}
+
+test "math.parseFloat() hex" {
+    try testParse("0x1.8p1", 0x40008000000000000000000000000000);
+    try testParse("-0X1P0", 0xbfff0000000000000000000000000000);
+    try testParse("0xffp-4", 0x4002fe00000000000000000000000000);
+    try testParse("0x.8p1", 0x3fff0000000000000000000000000000);
+    try testParse("0x1", 0x3fff0000000000000000000000000000);
+    try testParse("0x1p-16494", 1);
+    try testParse("0x1p-16495", 0);
+    try testParse("0x1.0000000000000000000000000001p-16495", 1);
+    try testParse("0x1.fffffffffffffffffffffffffffffp16383", 0x7fff0000000000000000000000000000);
+    // Ties and sticky digits past the 31st.
+    try testParse("0x1.ffffffffffffffffffffffffffff8p0", 0x40000000000000000000000000000000);
+    try testParse("0x1.ffffffffffffffffffffffffffff7p0", 0x3fffffffffffffffffffffffffffffff);
+    try testParse("0x1.00000000000000000000000000008p0", 0x3fff0000000000000000000000000000);
+    try testParse("0x1.00000000000000000000000000018p0", 0x3fff0000000000000000000000000002);
+    try testParse("0x1.000000000000000000000000000080000000001p0", 0x3fff0000000000000000000000000001);
+}
+
+test "math.parseFloat() special and invalid" {
+    try testParse("inf", 0x7fff0000000000000000000000000000);
+    try testParse("-Infinity", 0xffff0000000000000000000000000000);
+    try expect(math.isNan(try parseFloat(f128, "NaN")));
+    for ([_][]const u8{ "", "-", ".", "1e", "1e+", "1.2.3", "abc", "0x", "0x.p1", "1f", "in", "1 " }) |s| {
+        if (parseFloat(f128, s)) |_| {
+            std.debug.print("parseFloat({s}) didn't fail\n", .{s});
+            return error.TestExpectedError;
+        } else |_| {}
+    }
+}
+
+test "math.parseFloat() round trips math.formatFloat()" {
+    var prng = std.rand.DefaultPrng.init(0x2545F4914F6CDD1D);
+    const random = prng.random();
+    var buf: [math.formatLen(f128)]u8 = undefined;
+    var i: usize = 0;
+    while (i < 10000) : (i += 1) {
+        var bits = random.int(u128);
+        if (i % 2 == 1) {
+            // Fewer significant bits, so more of the fast path.
+            bits &= ~@as(u128, math.maxInt(u64));
+        }
+        const x = @bitCast(f128, bits);
+        if (!math.isFinite(x)) continue;
+        try testParse(math.formatFloat(&buf, x), bits);
+    }
+}
+
+test "math.parseFloatSlice()" {
+    var out: [4]f128 = undefined;
+    const input = " 1 -2.5\n0x1p3\t1e1";
+    // The last value might continue.
+    var r = try parseFloatSlice(f128, input, &out, false);
+    try expect(r.values == 3 and r.bytes == input.len - 3);
+    try expect(out[0] == 1 and out[1] == -2.5 and out[2] == 8);
+    r = try parseFloatSlice(f128, input[r.bytes..], &out, true);
+    try expect(r.values == 1 and out[0] == 10);
+    // Stops when out is full.
+    r = try parseFloatSlice(f128, input, out[0..2], true);
+    try expect(r.values == 2 and r.bytes == 7);
+}
@@ -0,0 +1,721 @@
+// Vectorized exp, exp2 and log2 over f64 slices, with the vector width chosen
+// at run time.
+//
+// The vector kernels are the scalar f64 kernels (exp64, exp2_64 and log2_64)
+// evaluated on n lanes at once, with the same operations in the same order,
+// so each lane gives the same result as math.exp(), math.exp2() and
+// math.log2(). A vector with any lane off the kernel's fast path (nan, inf,
+// tiny arguments, results that aren't normal, ...) is passed to the scalar
+// functions instead, as is the tail of the slice.
+//
+// NOTE: unless the program links the AVX2 and AVX-512 objects described
+// below, every flavour is compiled for the program's own target. For the
+// default x86_64 target (baseline, without -mcpu=native) the avx2 and avx512
+// flavours are then 4 and 8 lanes of SSE2 code, not AVX code, even when they
+// are selected on an AVX-512 CPU. The flavour names the vector width, not the
+// instructions. To get AVX, build the program for the CPU or link the
+// objects.
+//
+// There are flavours for 2 lanes (sse2), 4 (avx2) and 8 (avx512). The avx512
+// flavour uses the kernels of avx512.zig instead, which keep smaller tables
+// in registers, and are within 0.56 ulp rather than bit identical. The widest
+// flavour that the CPU and the OS support is selected from CPUID on first use
+// (avx512 only if it is compiled for AVX-512, see below), and kept as
+// function pointers. The 2-lane flavour is also used on other
+// architectures. The environment variable F128MATH_SIMD, set to scalar, sse2,
+// avx2 or avx512, selects a narrower flavour instead, e.g. to test each path
+// on one machine. Flavours the CPU can't run are ignored.
+//
+// Zig compiles a program for a single target, so on their own the 4 and 8
+// lane flavours only use the wider registers if the target has them, and are
+// otherwise split into SSE2 operations. So that one binary can use AVX2 and
+// AVX-512 where they are available, build.zig also compiles the kernels as
+// two objects for those features (with simd_export.zig as the root). A
+// program that links them says so by declaring
+//
+//     pub const f128math_simd_objects = true;
+//
+// in its root source file, as bench/simd.zig does. The objects are built with
+// fused multiply-add (see muladd.zig), so their results can differ from the
+// scalar functions' in the last bit, and are within the bounds given there
+// (and in avx512.zig for the avx512 flavour) instead; tests/simd_objects.zig
+// checks them. They are also built with the program's fp-exceptions and
+// branch-counters options, and forward their branch counts to it.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const root = @import("root");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const avx512 = @import("avx512.zig");
+const counters = @import("counters.zig");
+const exp2_mod = @import("exp2.zig");
+const muladd = @import("muladd.zig");
+
+/// Whether the AVX2 and AVX-512 objects are linked into the program.
+const use_objects: bool = if (@hasDecl(root, "f128math_simd_objects"))
+    root.f128math_simd_objects
+else
+    false;
+
+// The objects pass their branch counts on to this program's counters, see
+// counters.zig.
+comptime {
+    if (use_objects) {
+        @export(counters.recordC, .{ .name = "f128math_counters_record" });
+    }
+}
+
+/// The environment variable that selects a narrower flavour.
+pub const env_var = "F128MATH_SIMD";
+
+pub const Flavour = enum {
+    scalar,
+    sse2,
+    avx2,
+    avx512,
+
+    /// The number of f64 lanes of the vectors.
+    pub fn lanes(comptime self: Flavour) comptime_int {
+        return switch (self) {
+            .scalar => 1,
+            .sse2 => 2,
+            .avx2 => 4,
+            .avx512 => 8,
+        };
+    }
+};
+
+fn F(comptime n: comptime_int) type {
+    return @Vector(n, f64);
+}
+
+fn U(comptime n: comptime_int) type {
+    return @Vector(n, u64);
+}
+
+fn I(comptime n: comptime_int) type {
+    return @Vector(n, i64);
+}
+
+inline fn splat(comptime n: comptime_int, x: anytype) @Vector(n, @TypeOf(x)) {
+    return @splat(n, x);
+}
+
+inline fn shr(comptime n: comptime_int, x: anytype, comptime s: u6) @TypeOf(x) {
+    return x >> @splat(n, s);
+}
+
+inline fn shl(comptime n: comptime_int, x: anytype, comptime s: u6) @TypeOf(x) {
+    return x << @splat(n, s);
+}
+
+/// The high 32 bits of each element.
+inline fn highWord(comptime n: comptime_int, x: F(n)) U(n) {
+    return shr(n, @bitCast(U(n), x), 32);
+}
+
+/// Converts integral f64s of magnitude below 2^51 to i64, exactly.
+inline fn toInt(comptime n: comptime_int, x: F(n)) I(n) {
+    const magic = splat(n, @as(f64, 0x1.8p52));
+    return @bitCast(I(n), @bitCast(U(n), x + magic) -% @bitCast(U(n), magic));
+}
+
+/// Converts i64s of magnitude below 2^51 to f64, exactly.
+inline fn toFloat(comptime n: comptime_int, k: I(n)) F(n) {
+    const magic = splat(n, @as(f64, 0x1.8p52));
+    return @bitCast(F(n), @bitCast(U(n), magic) +% @bitCast(U(n), k)) - magic;
+}
+
+/// 2^k for k in [-1022, 1023].
+inline fn pow2(comptime n: comptime_int, k: I(n)) F(n) {
+    return @bitCast(F(n), shl(n, @bitCast(U(n), k + splat(n, @as(i64, 0x3FF))), 52));
+}
+
+/// Applies the scalar func to each element.
+inline fn scalarMap(comptime n: comptime_int, comptime func: fn (f64) f64, x: F(n)) F(n) {
+    var y: [n]f64 = undefined;
+    comptime var j = 0;
+    inline while (j < n) : (j += 1) {
+        y[j] = func(x[j]);
+    }
+    return y;
+}
+
+fn expScalar(x: f64) f64 {
+    return math.exp(x);
+}
+
+fn exp2Scalar(x: f64) f64 {
+    return math.exp2(x);
+}
+
+fn log2Scalar(x: f64) f64 {
+    return math.log2(x);
+}
+
+/// Returns exp() of each element of x.
+pub fn expVector(comptime n: comptime_int, x: F(n)) F(n) {
+    const hx = highWord(n, x) & splat(n, @as(u64, 0x7FFFFFFF));
+
+    // 2^(-28) < |x| < 708.39, as in exp64()
+    const out_of_range = hx -% splat(n, @as(u64, 0x3E300001)) >=
+        splat(n, @as(u64, 0x4086232B - 0x3E300001));
+    if (@reduce(.Or, out_of_range)) {
+        return scalarMap(n, expScalar, x);
+    }
+    return expReduced(n, x);
+}
+
+/// exp64Reduced() on each lane.
+inline fn expReduced(comptime n: comptime_int, x_: F(n)) F(n) {
+    const fused = muladd.enabled;
+    const one = splat(n, @as(f64, 1));
+    const two = splat(n, @as(f64, 2));
+    const zero = splat(n, @as(f64, 0));
+    const shift = splat(n, @as(f64, 0x1.8p52));
+    const ln2hi = splat(n, @as(f64, 6.93147180369123816490e-01));
+    const ln2lo = splat(n, @as(f64, 1.90821492927058770002e-10));
+    const invln2 = splat(n, @as(f64, 1.44269504088896338700e+00));
+    const P1 = splat(n, @as(f64, 1.66666666666666019037e-01));
+    const P2 = splat(n, @as(f64, -2.77777777770155933842e-03));
+    const P3 = splat(n, @as(f64, 6.61375632143793436117e-05));
+    const P4 = splat(n, @as(f64, -1.65339022054652515390e-06));
+    const P5 = splat(n, @as(f64, 4.13813679705723846039e-08));
+
+    const ux = @bitCast(U(n), x_);
+    const hx = shr(n, ux, 32) & splat(n, @as(u64, 0x7FFFFFFF));
+
+    // k = invln2 * x rounded to nearest, ties away from zero as in the
+    // scalar truncation of invln2 * x +- 0.5. As in the scalar kernel, k is
+    // +-1 up to the high word of 1.5 * ln2 (which rounding would make +-2
+    // just above it), and 0 up to that of 0.5 * ln2.
+    const p = invln2 * x_;
+    var kd = (p + shift) - shift;
+    const half = @bitCast(F(n), (ux & splat(n, @as(u64, 1 << 63))) | @bitCast(U(n), splat(n, @as(f64, 0.5))));
+    kd = @select(f64, p - kd == half, kd + (half + half), kd);
+    kd = @select(f64, hx <= splat(n, @as(u64, 0x3FF0A2B2)), half + half, kd);
+    kd = @select(f64, hx <= splat(n, @as(u64, 0x3FD62E42)), zero, kd);
+
+    const hi = x_ - kd * ln2hi;
+    const lo = kd * ln2lo;
+    const x = hi - lo;
+
+    // c = x - xx * (P1 + xx * (P2 + xx * (P3 + xx * (P4 + xx * P5))))
+    const xx = x * x;
+    var c = muladd.mulAdd(fused, xx, P5, P4);
+    c = muladd.mulAdd(fused, xx, c, P3);
+    c = muladd.mulAdd(fused, xx, c, P2);
+    c = muladd.mulAdd(fused, xx, c, P1);
+    c = muladd.mulAdd(fused, -xx, c, x);
+    const y = one + (x * c / (two - c) - lo + hi);
+
+    return y * pow2(n, toInt(n, kd));
+}
+
+/// Returns exp2() of each element of x.
+pub fn exp2Vector(comptime n: comptime_int, x: F(n)) F(n) {
+    const hx = highWord(n, x) & splat(n, @as(u64, 0x7FFFFFFF));
+
+    // 0x1p-54 <= |x| < 1022, as in exp2_64()
+    const out_of_range = hx -% splat(n, @as(u64, 0x3C900000)) >=
+        splat(n, @as(u64, 0x408FF000 - 0x3C900000));
+    if (@reduce(.Or, out_of_range)) {
+        return scalarMap(n, exp2Scalar, x);
+    }
+    return exp2Reduced(n, x);
+}
+
+/// exp2_64Reduced() on each lane.
+inline fn exp2Reduced(comptime n: comptime_int, x: F(n)) F(n) {
+    const fused = muladd.enabled;
+    const tblsiz = exp2_mod.exp2_64_tblsiz;
+    const tblsiz_bits = comptime math.log2_int(usize, tblsiz);
+    const redux = splat(n, @as(f64, 0x1.8p52 / @intToFloat(f64, tblsiz)));
+    const P1 = splat(n, @as(f64, 0x1.62e42fefa39efp-1));
+    const P2 = splat(n, @as(f64, 0x1.ebfbdff82c575p-3));
+    const P3 = splat(n, @as(f64, 0x1.c6b08d704a0a6p-5));
+    const P4 = splat(n, @as(f64, 0x1.3b2ab88f70400p-7));
+    const P5 = splat(n, @as(f64, 0x1.5d88003875c74p-10));
+    const low32 = splat(n, @as(u64, 0xFFFFFFFF));
+
+    // The reduction of exp2_64Reduce(), in the low 32 bits of each lane.
+    var uf = x + redux;
+    var i_0 = @bitCast(U(n), uf) & low32;
+    i_0 = (i_0 + splat(n, @as(u64, tblsiz / 2))) & low32;
+    // i_0 / N * N as an i32, divided by N
+    const k_u = i_0 & splat(n, @as(u64, 0xFFFFFFFF - (tblsiz - 1)));
+    const k = @bitCast(I(n), shl(n, k_u, 32)) >> splat(n, @as(u6, 32 + tblsiz_bits));
+    i_0 &= splat(n, @as(u64, tblsiz - 1));
+    uf -= redux;
+
+    var t: [n]f64 = undefined;
+    var eps: [n]f64 = undefined;
+    comptime var j = 0;
+    inline while (j < n) : (j += 1) {
+        const i = @intCast(usize, i_0[j]);
+        t[j] = exp2_mod.exp2_64_table[2 * i];
+        eps[j] = exp2_mod.exp2_64_table[2 * i + 1];
+    }
+    const tv: F(n) = t;
+    const z = (x - uf) - @as(F(n), eps);
+
+    // p = P1 + z * (P2 + z * (P3 + z * (P4 + z * P5)))
+    var p = muladd.mulAdd(fused, z, P5, P4);
+    p = muladd.mulAdd(fused, z, p, P3);
+    p = muladd.mulAdd(fused, z, p, P2);
+    p = muladd.mulAdd(fused, z, p, P1);
+    const y = tv + tv * z * p;
+
+    return y * pow2(n, k);
+}
+
+/// Returns log2() of each element of x.
+pub fn log2Vector(comptime n: comptime_int, x: F(n)) F(n) {
+    const hx = highWord(n, x);
+
+    // positive normal x, as in log2_64()
+    const out_of_range = hx -% splat(n, @as(u64, 0x00100000)) >=
+        splat(n, @as(u64, 0x7FF00000 - 0x00100000));
+    if (@reduce(.Or, out_of_range)) {
+        return scalarMap(n, log2Scalar, x);
+    }
+    return log2Normal(n, x);
+}
+
+/// log2_64Normal() on each lane, with k = 0.
+inline fn log2Normal(comptime n: comptime_int, x_: F(n)) F(n) {
+    const fused = muladd.enabled;
+    const one = splat(n, @as(f64, 1));
+    const two = splat(n, @as(f64, 2));
+    const half = splat(n, @as(f64, 0.5));
+    const ivln2hi = splat(n, @as(f64, 1.44269504072144627571e+00));
+    const ivln2lo = splat(n, @as(f64, 1.67517131648865118353e-10));
+    const Lg1 = splat(n, @as(f64, 6.666666666666735130e-01));
+    const Lg2 = splat(n, @as(f64, 3.999999999940941908e-01));
+    const Lg3 = splat(n, @as(f64, 2.857142874366239149e-01));
+    const Lg4 = splat(n, @as(f64, 2.222219843214978396e-01));
+    const Lg5 = splat(n, @as(f64, 1.818357216161805012e-01));
+    const Lg6 = splat(n, @as(f64, 1.531383769920937332e-01));
+    const Lg7 = splat(n, @as(f64, 1.479819860511658591e-01));
+
+    var ix = @bitCast(U(n), x_);
+    var hx = shr(n, ix, 32);
+
+    // x into [sqrt(2) / 2, sqrt(2)]
+    hx += splat(n, @as(u64, 0x3FF00000 - 0x3FE6A09E));
+    const k = @bitCast(I(n), shr(n, hx, 20)) - splat(n, @as(i64, 0x3FF));
+    hx = (hx & splat(n, @as(u64, 0x000FFFFF))) + splat(n, @as(u64, 0x3FE6A09E));
+    ix = shl(n, hx, 32) | (ix & splat(n, @as(u64, 0xFFFFFFFF)));
+    const x = @bitCast(F(n), ix);
+
+    const f = x - one;
+    const hfsq = half * f * f;
+    const s = f / (two + f);
+    const z = s * s;
+    const w = z * z;
+    // t1 = w * (Lg2 + w * (Lg4 + w * Lg6))
+    // t2 = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)))
+    const t1 = w * muladd.mulAdd(fused, w, muladd.mulAdd(fused, w, Lg6, Lg4), Lg2);
+    var q = muladd.mulAdd(fused, w, Lg7, Lg5);
+    q = muladd.mulAdd(fused, w, q, Lg3);
+    const t2 = z * muladd.mulAdd(fused, w, q, Lg1);
+    const R = t2 + t1;
+
+    // hi + lo = f - hfsq + s * (hfsq + R) ~ log(1 + f)
+    var hi = f - hfsq;
+    hi = @bitCast(F(n), @bitCast(U(n), hi) & splat(n, @as(u64, 0xFFFFFFFF00000000)));
+    const lo = f - hi - hfsq + s * (hfsq + R);
+
+    var val_hi = hi * ivln2hi;
+    var val_lo = (lo + hi) * ivln2lo + lo * ivln2hi;
+
+    // spadd(val_hi, val_lo, y)
+    const y = toFloat(n, k);
+    const ww = y + val_hi;
+    val_lo += (y - ww) + val_hi;
+    val_hi = ww;
+
+    return val_lo + val_hi;
+}
+
+/// Evaluates the vector kernel on each full vector of xs, and the scalar
+/// function on the rest.
+fn map(
+    comptime n: comptime_int,
+    comptime vector: anytype,
+    comptime scalar: fn (f64) f64,
+    xs: []const f64,
+    out: []f64,
+) void {
+    std.debug.assert(out.len == xs.len);
+    var i: usize = 0;
+    if (n > 1) {
+        while (i + n <= xs.len) : (i += n) {
+            const x: F(n) = xs[i..][0..n].*;
+            out[i..][0..n].* = vector(x);
+        }
+    }
+    while (i < xs.len) : (i += 1) {
+        out[i] = scalar(xs[i]);
+    }
+}
+
+/// A slice kernel, which writes func(x) for each x in xs to out. The output
+/// may alias the input.
+pub const SliceFn = fn (xs: []const f64, out: []f64) void;
+
+/// The C ABI form of the slice kernels, exported by the objects.
+pub const CSliceFn = fn (xs: [*]const f64, out: [*]f64, len: usize) callconv(.C) void;
+
+/// The vector kernels with n lanes: those of avx512.zig for 8 lanes, and
+/// the ones above otherwise.
+fn Vectors(comptime n: comptime_int) type {
+    return struct {
+        fn exp(x: F(n)) F(n) {
+            return if (n == 8) avx512.expVector(x) else expVector(n, x);
+        }
+
+        fn exp2(x: F(n)) F(n) {
+            return if (n == 8) avx512.exp2Vector(x) else exp2Vector(n, x);
+        }
+
+        fn log2(x: F(n)) F(n) {
+            return if (n == 8) avx512.log2Vector(x) else log2Vector(n, x);
+        }
+    };
+}
+
+/// The slice kernels with n lanes, compiled for the program's target.
+fn Slices(comptime n: comptime_int) type {
+    const V = Vectors(n);
+    return struct {
+        fn exp(xs: []const f64, out: []f64) void {
+            map(n, V.exp, expScalar, xs, out);
+        }
+
+        fn exp2(xs: []const f64, out: []f64) void {
+            map(n, V.exp2, exp2Scalar, xs, out);
+        }
+
+        fn log2(xs: []const f64, out: []f64) void {
+            map(n, V.log2, log2Scalar, xs, out);
+        }
+    };
+}
+
+/// The slice kernels of flavour in their C ABI form, for simd_export.zig.
+pub fn CSlices(comptime flavour: Flavour) type {
+    const S = Slices(flavour.lanes());
+    return struct {
+        pub fn exp(xs: [*]const f64, out: [*]f64, len: usize) callconv(.C) void {
+            S.exp(xs[0..len], out[0..len]);
+        }
+
+        pub fn exp2(xs: [*]const f64, out: [*]f64, len: usize) callconv(.C) void {
+            S.exp2(xs[0..len], out[0..len]);
+        }
+
+        pub fn log2(xs: [*]const f64, out: [*]f64, len: usize) callconv(.C) void {
+            S.log2(xs[0..len], out[0..len]);
+        }
+    };
+}
+
+/// The symbol of the kernel for func ("exp", "exp2" or "log2") in the object
+/// for flavour.
+pub fn symbolName(comptime flavour: Flavour, comptime func: []const u8) []const u8 {
+    return "f128math_simd_" ++ func ++ "_" ++ @tagName(flavour);
+}
+
+/// The kernels exported by the objects.
+const objects = struct {
+    extern fn f128math_simd_exp_avx2(xs: [*]const f64, out: [*]f64, len: usize) void;
+    extern fn f128math_simd_exp2_avx2(xs: [*]const f64, out: [*]f64, len: usize) void;
+    extern fn f128math_simd_log2_avx2(xs: [*]const f64, out: [*]f64, len: usize) void;
+    extern fn f128math_simd_exp_avx512(xs: [*]const f64, out: [*]f64, len: usize) void;
+    extern fn f128math_simd_exp2_avx512(xs: [*]const f64, out: [*]f64, len: usize) void;
+    extern fn f128math_simd_log2_avx512(xs: [*]const f64, out: [*]f64, len: usize) void;
+};
+
+/// The slice kernels of flavour from its object.
+fn ObjectSlices(comptime flavour: Flavour) type {
+    return struct {
+        fn exp(xs: []const f64, out: []f64) void {
+            std.debug.assert(out.len == xs.len);
+            @field(objects, symbolName(flavour, "exp"))(xs.ptr, out.ptr, xs.len);
+        }
+
+        fn exp2(xs: []const f64, out: []f64) void {
+            std.debug.assert(out.len == xs.len);
+            @field(objects, symbolName(flavour, "exp2"))(xs.ptr, out.ptr, xs.len);
+        }
+
+        fn log2(xs: []const f64, out: []f64) void {
+            std.debug.assert(out.len == xs.len);
+            @field(objects, symbolName(flavour, "log2"))(xs.ptr, out.ptr, xs.len);
+        }
+    };
+}
+
+pub const Kernels = struct {
+    flavour: Flavour,
+    exp: SliceFn,
+    exp2: SliceFn,
+    log2: SliceFn,
+};
+
+fn kernelsOf(comptime flavour: Flavour) Kernels {
+    const S = if (use_objects and (flavour == .avx2 or flavour == .avx512))
+        ObjectSlices(flavour)
+    else
+        Slices(flavour.lanes());
+    return .{ .flavour = flavour, .exp = S.exp, .exp2 = S.exp2, .log2 = S.log2 };
+}
+
+/// Returns the kernels of flavour, which the CPU must support (see
+/// detect()).
+pub fn kernelsFor(flavour: Flavour) Kernels {
+    return switch (flavour) {
+        .scalar => kernelsOf(.scalar),
+        .sse2 => kernelsOf(.sse2),
+        .avx2 => kernelsOf(.avx2),
+        .avx512 => kernelsOf(.avx512),
+    };
+}
+
+const CpuidLeaf = packed struct {
+    eax: u32,
+    ebx: u32,
+    ecx: u32,
+    edx: u32,
+};
+
+fn cpuid(leaf_id: u32, subid: u32) CpuidLeaf {
+    // Inline assembly only has one output, so the registers are stored
+    // through a pointer, as in std.zig.system.x86.
+    var leaf: CpuidLeaf = undefined;
+    asm volatile (
+        \\ cpuid
+        \\ movl %%eax, 0(%[leaf_ptr])
+        \\ movl %%ebx, 4(%[leaf_ptr])
+        \\ movl %%ecx, 8(%[leaf_ptr])
+        \\ movl %%edx, 12(%[leaf_ptr])
+        :
+        : [leaf_id] "{eax}" (leaf_id),
+          [subid] "{ecx}" (subid),
+          [leaf_ptr] "r" (&leaf),
+        : "eax", "ebx", "ecx", "edx"
+    );
+    return leaf;
+}
+
+/// The register state the OS saves, from XCR0.
+fn getXcr0() u32 {
+    return asm volatile (
+        \\ xor %%ecx, %%ecx
+        \\ xgetbv
+        : [ret] "={eax}" (-> u32),
+        :
+        : "eax", "edx", "ecx"
+    );
+}
+
+inline fn hasBit(reg: u32, comptime bit: u5) bool {
+    return reg & (1 << bit) != 0;
+}
+
+fn detectX86() Flavour {
+    const max_leaf = cpuid(0, 0).eax;
+    const max_ext_leaf = cpuid(0x80000000, 0).eax;
+    if (max_leaf < 7 or max_ext_leaf < 0x80000001) {
+        return .sse2;
+    }
+    const leaf1 = cpuid(1, 0);
+    const leaf7 = cpuid(7, 0);
+    const ext1 = cpuid(0x80000001, 0);
+
+    // The OS saves the ymm registers (and has enabled xgetbv).
+    if (!hasBit(leaf1.ecx, 27) or getXcr0() & 0x6 != 0x6) {
+        return .sse2;
+    }
+    // The features of the avx2 object (see build.zig): AVX, FMA, MOVBE and
+    // F16C; BMI1, AVX2 and BMI2; LZCNT.
+    const avx2 = hasBit(leaf1.ecx, 28) and hasBit(leaf1.ecx, 12) and
+        hasBit(leaf1.ecx, 22) and hasBit(leaf1.ecx, 29) and
+        hasBit(leaf7.ebx, 3) and hasBit(leaf7.ebx, 5) and hasBit(leaf7.ebx, 8) and
+        hasBit(ext1.ecx, 5);
+    if (!avx2) {
+        return .sse2;
+    }
+    // The OS saves the opmask and zmm registers, and the CPU has AVX-512 F,
+    // DQ, CD, BW and VL.
+    const avx512 = getXcr0() & 0xE6 == 0xE6 and
+        hasBit(leaf7.ebx, 16) and hasBit(leaf7.ebx, 17) and hasBit(leaf7.ebx, 28) and
+        hasBit(leaf7.ebx, 30) and hasBit(leaf7.ebx, 31);
+    return if (avx512) .avx512 else .avx2;
+}
+
+/// Returns the widest flavour that the CPU and the OS support.
+pub fn detect() Flavour {
+    if (builtin.cpu.arch == .x86_64) {
+        return detectX86();
+    } else {
+        return .sse2;
+    }
+}
+
+/// Returns the flavour named by value, the setting of env_var.
+pub fn parseFlavour(value: []const u8) ?Flavour {
+    return std.meta.stringToEnum(Flavour, value);
+}
+
+fn override() ?Flavour {
+    // std.os.getenv() isn't available on Windows.
+    if (builtin.os.tag == .windows) {
+        return null;
+    } else {
+        const value = std.os.getenv(env_var) orelse return null;
+        return parseFlavour(value);
+    }
+}
+
+var selected: Kernels = undefined;
+var selected_once = std.once(select);
+
+/// Whether the avx512 flavour is compiled for AVX-512, in the program or in
+/// an object. Otherwise its fused multiply-adds would be software calls.
+const avx512_compiled = use_objects or avx512.target_has_avx512;
+
+fn select() void {
+    var flavour = detect();
+    if (flavour == .avx512 and !avx512_compiled) {
+        flavour = .avx2;
+    }
+    if (override()) |f| {
+        if (@enumToInt(f) < @enumToInt(flavour)) {
+            flavour = f;
+        }
+    }
+    selected = kernelsFor(flavour);
+}
+
+/// Returns the kernels selected for this CPU, which are chosen by the first
+/// call.
+pub fn kernels() *const Kernels {
+    selected_once.call();
+    return &selected;
+}
+
+/// Returns the flavour of kernels(). Without the objects, this is the number
+/// of lanes rather than the instruction set, see the top of the file.
+pub fn selectedFlavour() Flavour {
+    return kernels().flavour;
+}
+
+/// Writes exp(x) for each x in xs to out with the selected kernels. The
+/// output may alias the input.
+pub fn exp(xs: []const f64, out: []f64) void {
+    kernels().exp(xs, out);
+}
+
+/// Writes exp2(x) for each x in xs to out with the selected kernels. The
+/// output may alias the input.
+pub fn exp2(xs: []const f64, out: []f64) void {
+    kernels().exp2(xs, out);
+}
+
+/// Writes log2(x) for each x in xs to out with the selected kernels. The
+/// output may alias the input.
+pub fn log2(xs: []const f64, out: []f64) void {
+    kernels().log2(xs, out);
+}
+
+fn testInputs(xs: []f64) void {
+    var prng = std.rand.DefaultPrng.init(0x853C49E6748FEA9B);
+    const random = prng.random();
+    for (xs) |*x, i| {
+        x.* = switch (i % 8) {
+            0 => random.float(f64) * 1400 - 700,
+            1 => random.float(f64) * 2 - 1,
+            2 => @intToFloat(f64, @intCast(i32, i % 2000) - 1000),
+            3 => math.scalbn(random.float(f64) + 0.5, @intCast(i32, i % 2100) - 1050),
+            4 => random.float(f64) * 2040 - 1020,
+            // around the thresholds of k = 0 and k = +-1 in exp()
+            5 => 0.5 * std.math.ln2 + @intToFloat(f64, i % 16) * 0x1p-50,
+            6 => -1.5 * std.math.ln2 - @intToFloat(f64, i % 16) * 0x1p-50,
+            else => random.float(f64) * 100,
+        };
+    }
+    // Out of range lanes, which send their vector to the scalar functions.
+    xs[3] = math.inf(f64);
+    xs[17] = math.nan(f64);
+    xs[40] = -0.0;
+    xs[41] = 0x1p-60;
+    xs[66] = -745.5;
+    xs[67] = 1023.5;
+}
+
+fn expectMatchesScalar(kernels_: Kernels, xs: []const f64, out: []f64) !void {
+    kernels_.exp(xs, out);
+    for (xs) |x, i| {
+        try expect(@bitCast(u64, out[i]) == @bitCast(u64, math.exp(x)));
+    }
+    kernels_.exp2(xs, out);
+    for (xs) |x, i| {
+        try expect(@bitCast(u64, out[i]) == @bitCast(u64, math.exp2(x)));
+    }
+    kernels_.log2(xs, out);
+    for (xs) |x, i| {
+        try expect(@bitCast(u64, out[i]) == @bitCast(u64, math.log2(x)));
+    }
+}
+
+test "math.simd matches scalar" {
+    // An odd length, so every flavour has a scalar tail.
+    var xs: [4099]f64 = undefined;
+    var out: [4099]f64 = undefined;
+    testInputs(&xs);
+
+    // The avx512 flavour is only within its error bounds, see avx512.zig.
+    const widest = detect();
+    inline for (.{ .scalar, .sse2, .avx2 }) |flavour| {
+        if (@enumToInt(@as(Flavour, flavour)) <= @enumToInt(widest)) {
+            try expectMatchesScalar(kernelsFor(flavour), &xs, &out);
+        }
+    }
+    if (kernels().flavour != .avx512) {
+        try expectMatchesScalar(kernels().*, &xs, &out);
+    }
+    try expect(@enumToInt(kernels().flavour) <= @enumToInt(widest));
+}
+
+test "math.simd in place" {
+    // Exact both ways for integers.
+    var xs = [_]f64{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    exp2(&xs, &xs);
+    try expect(xs[0] == 1 and xs[10] == 1024);
+    log2(&xs, &xs);
+    for (xs) |x, i| {
+        try expect(x == @intToFloat(f64, i));
+    }
+}
+
+test "math.simd vectors" {
+    const x = @Vector(4, f64){ 0.2, 1.5, -1.5, 3.7 };
+    const y = expVector(4, x);
+    const z = log2Vector(4, exp2Vector(4, x));
+    comptime var i = 0;
+    inline while (i < 4) : (i += 1) {
+        try expect(y[i] == math.exp(x[i]));
+        try expect(math.approxEqAbs(f64, z[i], x[i], 1e-15));
+    }
+}
+
+test "math.simd parseFlavour()" {
+    try expect(parseFlavour("scalar").? == .scalar);
+    try expect(parseFlavour("avx512").? == .avx512);
+    try expect(parseFlavour("avx") == null);
+}
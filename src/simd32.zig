@@ -0,0 +1,439 @@
+// Vectorized exp and exp2 over f32 slices, on 8 or 16 lanes, with the
+// 16-entry tables kept in registers.
+//
+// There are two sets of kernels:
+//
+//   function  | evaluated in | table                | max error
+//   ----------|--------------|----------------------|---------------------
+//   exp2      | f64          | exp2_32_table        | as math.exp2()
+//   exp       | f64          | exp2_32_table        | 0.501 ulp
+//   fast.exp2 | f32          | 2^(i/16) in f32      | 0.97 ulp
+//   fast.exp  | f32          | 2^(i/16) in f32      | 0.97 ulp
+//
+// The default kernels are exp2_32() evaluated on each lane widened to f64,
+// with the same reduction and the same degree 4 polynomial, so exp2 gives the
+// same results as math.exp2() bit for bit. exp multiplies by log2(e) in f64
+// first, which is accurate to well beyond f32 precision, so it is nearly
+// correctly rounded; its results can differ from math.exp(), which is
+// evaluated in f32 arithmetic.
+//
+// The fast kernels stay in f32 throughout, so a register holds twice as many
+// lanes, for about 1 ulp: the table entries are rounded to f32 and the result
+// is rounded twice. The bounds above are with fused multiply-adds (see
+// muladd.zig), and 0.99 ulp with the separate multiply and add. The maxima
+// were measured against a high precision reference.
+//
+// The table of exp2_32() is 16 f64s, which fill two zmm registers that
+// vpermi2pd indexes with the low 4 bits of each lane (see avx512.permute()).
+// The f32 table of the fast kernels fills one zmm register, indexed with
+// vpermps, or two ymm registers with AVX2, indexed with a vpermps each and a
+// blend. Otherwise the tables are looked up one lane at a time.
+//
+// As in simd.zig, a vector with any lane whose result isn't normal (nan, inf,
+// overflow, underflow) goes to the scalar functions. The slice kernels use
+// 16 lanes where the target has AVX-512 and 8 otherwise, picked at compile
+// time rather than at run time as in simd.zig. The tail of a slice is padded
+// to a full vector, so each element gives the same result wherever it is.
+
+const std = @import("std");
+const builtin = @import("builtin");
+// const math = std.math;
+const math = @import("lib.zig");
+const expect = std.testing.expect;
+
+const avx512 = @import("avx512.zig");
+const exp2_mod = @import("exp2.zig");
+const muladd = @import("muladd.zig");
+
+/// Whether the target has AVX2, so the f32 table is indexed with vpermps.
+const target_has_avx2 = builtin.cpu.arch == .x86_64 and
+    std.Target.x86.featureSetHas(builtin.cpu.features, .avx2);
+
+/// The number of lanes of the slice kernels.
+pub const lanes: comptime_int = if (avx512.target_has_avx512) 16 else 8;
+
+fn F(comptime n: comptime_int) type {
+    return @Vector(n, f32);
+}
+
+fn U(comptime n: comptime_int) type {
+    return @Vector(n, u32);
+}
+
+fn I(comptime n: comptime_int) type {
+    return @Vector(n, i32);
+}
+
+fn F64(comptime n: comptime_int) type {
+    return @Vector(n, f64);
+}
+
+fn U64(comptime n: comptime_int) type {
+    return @Vector(n, u64);
+}
+
+fn I64(comptime n: comptime_int) type {
+    return @Vector(n, i64);
+}
+
+inline fn splat(comptime n: comptime_int, x: anytype) @Vector(n, @TypeOf(x)) {
+    return @splat(n, x);
+}
+
+fn checkLanes(comptime n: comptime_int) void {
+    if (n != 8 and n != 16) {
+        @compileError("the simd32 kernels have 8 or 16 lanes");
+    }
+}
+
+/// The bits of each element without the sign, which compare as |x| does.
+inline fn absBits(comptime n: comptime_int, x: F(n)) U(n) {
+    return @bitCast(U(n), x) & splat(n, @as(u32, 0x7FFFFFFF));
+}
+
+/// Converts each element to f64, exactly.
+inline fn widen(comptime n: comptime_int, x: F(n)) F64(n) {
+    var y: [n]f64 = undefined;
+    comptime var j = 0;
+    inline while (j < n) : (j += 1) {
+        y[j] = x[j];
+    }
+    return y;
+}
+
+/// Rounds each element to f32.
+inline fn narrow(comptime n: comptime_int, x: F64(n)) F(n) {
+    var y: [n]f32 = undefined;
+    comptime var j = 0;
+    inline while (j < n) : (j += 1) {
+        y[j] = @floatCast(f32, x[j]);
+    }
+    return y;
+}
+
+/// Applies the scalar func to each element.
+inline fn scalarMap(comptime n: comptime_int, comptime func: fn (f32) f32, x: F(n)) F(n) {
+    var y: [n]f32 = undefined;
+    comptime var j = 0;
+    inline while (j < n) : (j += 1) {
+        y[j] = func(x[j]);
+    }
+    return y;
+}
+
+fn expScalar(x: f32) f32 {
+    return math.exp(x);
+}
+
+fn exp2Scalar(x: f32) f32 {
+    return math.exp2(x);
+}
+
+const lower_half = [8]i32{ 0, 1, 2, 3, 4, 5, 6, 7 };
+const upper_half = [8]i32{ 8, 9, 10, 11, 12, 13, 14, 15 };
+const both_halves = [16]i32{ 0, 1, 2, 3, 4, 5, 6, 7, -1, -2, -3, -4, -5, -6, -7, -8 };
+
+/// Returns exp2_32_table[i & 15] for each lane.
+inline fn lookup64(comptime n: comptime_int, i: U64(n)) F64(n) {
+    const table = exp2_mod.exp2_32_table;
+    if (n == 8) {
+        return avx512.permute(table, i);
+    }
+    const lo = avx512.permute(table, @shuffle(u64, i, undefined, lower_half));
+    const hi = avx512.permute(table, @shuffle(u64, i, undefined, upper_half));
+    return @shuffle(f64, lo, hi, both_halves);
+}
+
+/// Returns table[i & 15] for each lane.
+inline fn lookup32(comptime n: comptime_int, comptime table: [16]f32, i: U(n)) F(n) {
+    if (n == 16 and avx512.target_has_avx512) {
+        const t: F(16) = table;
+        return asm ("vpermps %[t], %[i], %[ret]"
+            : [ret] "=v" (-> F(16)),
+            : [i] "v" (i),
+              [t] "v" (t),
+        );
+    } else if (n == 16 and target_has_avx2) {
+        const lo = lookup32(8, table, @shuffle(u32, i, undefined, lower_half));
+        const hi = lookup32(8, table, @shuffle(u32, i, undefined, upper_half));
+        return @shuffle(f32, lo, hi, both_halves);
+    } else if (n == 8 and target_has_avx2) {
+        const t_lo: F(8) = table[0..8].*;
+        const t_hi: F(8) = table[8..16].*;
+        // vpermps uses the low 3 bits of each index, bit 3 selects the half.
+        const lo = asm ("vpermps %[t], %[i], %[ret]"
+            : [ret] "=x" (-> F(8)),
+            : [i] "x" (i),
+              [t] "x" (t_lo),
+        );
+        const hi = asm ("vpermps %[t], %[i], %[ret]"
+            : [ret] "=x" (-> F(8)),
+            : [i] "x" (i),
+              [t] "x" (t_hi),
+        );
+        return @select(f32, (i & splat(8, @as(u32, 8))) == splat(8, @as(u32, 0)), lo, hi);
+    } else {
+        var y: [n]f32 = undefined;
+        comptime var j = 0;
+        inline while (j < n) : (j += 1) {
+            y[j] = table[i[j] & 15];
+        }
+        return y;
+    }
+}
+
+/// exp2_32Reduced() on each lane of x, |x| <= 126, without the rounding
+/// to f32.
+inline fn exp2Core(comptime n: comptime_int, x: F64(n)) F64(n) {
+    // Rounds 16 * x to an integer as the f32 redux of exp2_32() does.
+    const redux = splat(n, @as(f64, 0x1.8p52 / 16.0));
+    const P1 = splat(n, @as(f64, 0x1.62e430p-1));
+    const P2 = splat(n, @as(f64, 0x1.ebfbe0p-3));
+    const P3 = splat(n, @as(f64, 0x1.c6b348p-5));
+    const P4 = splat(n, @as(f64, 0x1.3b2c9cp-7));
+
+    // x = k + (i - 8) / 16 + z, |z| <= 1/32, exactly
+    const uf = x + redux;
+    const m = (@bitCast(U64(n), uf) -% @bitCast(U64(n), redux)) +% splat(n, @as(u64, 8));
+    const k = @bitCast(I64(n), m) >> splat(n, @as(u6, 4));
+    const z = x - (uf - redux);
+
+    const r = lookup64(n, m);
+    const t = r * z;
+    const y = r + t * (P1 + z * P2) + t * (z * z) * (P3 + z * P4);
+    return y * @bitCast(F64(n), (@bitCast(U64(n), k + splat(n, @as(i64, 0x3FF)))) << splat(n, @as(u6, 52)));
+}
+
+/// Returns exp2() of each element of x, the same as math.exp2().
+pub fn exp2Vector(comptime n: comptime_int, x: F(n)) F(n) {
+    comptime checkLanes(n);
+    // |x| <= 126, so the result is normal
+    if (@reduce(.Or, absBits(n, x) > splat(n, @as(u32, 0x42FC0000)))) {
+        return scalarMap(n, exp2Scalar, x);
+    }
+    return narrow(n, exp2Core(n, widen(n, x)));
+}
+
+/// Returns exp() of each element of x, within 0.501 ulp.
+pub fn expVector(comptime n: comptime_int, x: F(n)) F(n) {
+    comptime checkLanes(n);
+    const log2e = splat(n, @as(f64, 0x1.71547652b82fep+0));
+    // |x| < 87.34, so the result is normal
+    if (@reduce(.Or, absBits(n, x) >= splat(n, @as(u32, 0x42AEAC50)))) {
+        return scalarMap(n, expScalar, x);
+    }
+    return narrow(n, exp2Core(n, widen(n, x) * log2e));
+}
+
+// 2^(i/16) rounded to f32.
+const exp2_f32_table = [16]f32{
+    0x1.000000p+0, 0x1.0b5586p+0, 0x1.172b84p+0, 0x1.2387a6p+0,
+    0x1.306fe0p+0, 0x1.3dea64p+0, 0x1.4bfdaep+0, 0x1.5ab07ep+0,
+    0x1.6a09e6p+0, 0x1.7a1148p+0, 0x1.8ace54p+0, 0x1.9c4918p+0,
+    0x1.ae89fap+0, 0x1.c199bep+0, 0x1.d5818ep+0, 0x1.ea4afap+0,
+};
+
+/// Returns 2^(i/16) * (1 + p) * 2^k for m = 16 * k + i, in f32.
+inline fn exp2Scale32(comptime n: comptime_int, m: U(n), p: F(n)) F(n) {
+    const t = lookup32(n, exp2_f32_table, m);
+    const y = muladd.mulAdd(muladd.enabled, t, p, t);
+    const k = @bitCast(I(n), m) >> splat(n, @as(u5, 4));
+    return y * @bitCast(F(n), @bitCast(U(n), k + splat(n, @as(i32, 0x7F))) << splat(n, @as(u5, 23)));
+}
+
+/// The kernels evaluated in f32 arithmetic, within about 1 ulp.
+pub const fast = struct {
+    /// Returns exp2() of each element of x, within 0.97 ulp.
+    pub fn exp2Vector(comptime n: comptime_int, x: F(n)) F(n) {
+        comptime checkLanes(n);
+        const shift = splat(n, @as(f32, 0x1.8p23 / 16.0));
+        const Q1 = splat(n, @as(f32, 0x1.62e430p-1));
+        const Q2 = splat(n, @as(f32, 0x1.ebfbe0p-3));
+        const Q3 = splat(n, @as(f32, 0x1.c6b348p-5));
+        const Q4 = splat(n, @as(f32, 0x1.3b2bfap-7));
+
+        // |x| <= 126, so the result is normal
+        if (@reduce(.Or, absBits(n, x) > splat(n, @as(u32, 0x42FC0000)))) {
+            return scalarMap(n, exp2Scalar, x);
+        }
+
+        // x = m / 16 + r, |r| <= 1/32, exactly
+        const u = x + shift;
+        const m = @bitCast(U(n), u) -% @bitCast(U(n), shift);
+        const r = x - (u - shift);
+
+        // 2^r - 1 = r * (Q1 + r * (Q2 + r * (Q3 + r * Q4)))
+        const q = muladd.mulAdd(muladd.enabled, r, muladd.mulAdd(muladd.enabled, r, muladd.mulAdd(muladd.enabled, r, Q4, Q3), Q2), Q1);
+        return exp2Scale32(n, m, r * q);
+    }
+
+    /// Returns exp() of each element of x, within 0.97 ulp.
+    pub fn expVector(comptime n: comptime_int, x: F(n)) F(n) {
+        comptime checkLanes(n);
+        const one = splat(n, @as(f32, 1));
+        const shift = splat(n, @as(f32, 0x1.8p23));
+        const inv_ln2_16 = splat(n, @as(f32, 0x1.715476p+4));
+        // ln2 / 16 = ln2_16_hi + ln2_16_lo, with m * ln2_16_hi exact
+        const ln2_16_hi = splat(n, @as(f32, 0x1.62e000p-5));
+        const ln2_16_lo = splat(n, @as(f32, 0x1.0bfbe8p-19));
+        const E2 = splat(n, @as(f32, 0x1.000000p-1));
+        const E3 = splat(n, @as(f32, 0x1.555762p-3));
+        const E4 = splat(n, @as(f32, 0x1.5556b4p-5));
+
+        // |x| < 87.34, so the result is normal
+        if (@reduce(.Or, absBits(n, x) >= splat(n, @as(u32, 0x42AEAC50)))) {
+            return scalarMap(n, expScalar, x);
+        }
+
+        // x = m * ln2 / 16 + r, |r| <= ln2 / 32
+        const u = x * inv_ln2_16 + shift;
+        const md = u - shift;
+        const m = @bitCast(U(n), u) -% @bitCast(U(n), shift);
+        const r = (x - md * ln2_16_hi) - md * ln2_16_lo;
+
+        // e^r - 1 = r * (1 + r * (E2 + r * (E3 + r * E4)))
+        const q = muladd.mulAdd(muladd.enabled, r, muladd.mulAdd(muladd.enabled, r, muladd.mulAdd(muladd.enabled, r, E4, E3), E2), one);
+        return exp2Scale32(n, m, r * q);
+    }
+
+    /// Writes exp2(x) for each x in xs to out, within 0.97 ulp. The output
+    /// may alias the input.
+    pub fn exp2(xs: []const f32, out: []f32) void {
+        map(exp2Vector, xs, out);
+    }
+
+    /// Writes exp(x) for each x in xs to out, within 0.97 ulp. The output may
+    /// alias the input.
+    pub fn exp(xs: []const f32, out: []f32) void {
+        map(expVector, xs, out);
+    }
+};
+
+/// Evaluates the vector kernel on each full vector of xs, and on the rest
+/// padded with zeros.
+fn map(comptime vector: anytype, xs: []const f32, out: []f32) void {
+    std.debug.assert(out.len == xs.len);
+    var i: usize = 0;
+    while (i + lanes <= xs.len) : (i += lanes) {
+        const x: F(lanes) = xs[i..][0..lanes].*;
+        out[i..][0..lanes].* = vector(lanes, x);
+    }
+    if (i < xs.len) {
+        var x = [_]f32{0} ** lanes;
+        std.mem.copy(f32, &x, xs[i..]);
+        const y: [lanes]f32 = vector(lanes, x);
+        std.mem.copy(f32, out[i..], y[0 .. xs.len - i]);
+    }
+}
+
+/// Writes exp2(x) for each x in xs to out, the same as math.exp2(). The
+/// output may alias the input.
+pub fn exp2(xs: []const f32, out: []f32) void {
+    map(exp2Vector, xs, out);
+}
+
+/// Writes exp(x) for each x in xs to out, within 0.501 ulp. The output may
+/// alias the input.
+pub fn exp(xs: []const f32, out: []f32) void {
+    map(expVector, xs, out);
+}
+
+fn testInputs(xs: []f32) void {
+    var prng = std.rand.DefaultPrng.init(0xDA942042E4DD58B5);
+    const random = prng.random();
+    for (xs) |*x, i| {
+        x.* = switch (i % 4) {
+            0 => random.float(f32) * 174 - 87,
+            1 => random.float(f32) * 2 - 1,
+            2 => random.float(f32) * 252 - 126,
+            else => @intToFloat(f32, @intCast(i32, i % 252) - 126),
+        };
+    }
+    // Out of range lanes, which send their vector to the scalar functions.
+    xs[3] = math.inf(f32);
+    xs[17] = math.nan(f32);
+    xs[40] = -0.0;
+    xs[41] = 0x1p-30;
+    xs[66] = -140.5;
+    xs[67] = 127.5;
+    xs[90] = -87.5;
+}
+
+/// Returns the error of y in ulps, relative to the more precise ref.
+fn ulpError(y: f32, ref: f64) f64 {
+    const fr = math.frexp(ref);
+    const ulp = math.scalbn(@as(f64, 1), fr.exponent - 24);
+    return math.fabs(@as(f64, y) - ref) / ulp;
+}
+
+test "math.simd32 exp2 matches scalar" {
+    // An odd length, so the tail is padded.
+    var xs: [4099]f32 = undefined;
+    var out: [4099]f32 = undefined;
+    testInputs(&xs);
+    exp2(&xs, &out);
+    for (xs) |x, i| {
+        try expect(@bitCast(u32, out[i]) == @bitCast(u32, math.exp2(x)));
+    }
+}
+
+test "math.simd32 max ulp" {
+    // In range of the vector kernels, where the bounds apply, and an odd
+    // length, so the tail is padded.
+    var prng = std.rand.DefaultPrng.init(0x1B873593CC9E2D51);
+    const random = prng.random();
+    var xs: [4099]f32 = undefined;
+    var ys: [4099]f32 = undefined;
+    var out: [4099]f32 = undefined;
+    var fast_out: [4099]f32 = undefined;
+    // the documented bounds of the fast kernels
+    const fast_bound: f64 = if (muladd.enabled) 0.97 else 0.99;
+    for (xs) |*x, i| {
+        x.* = if (i % 2 == 0)
+            random.float(f32) * 174 - 87
+        else
+            (random.float(f32) - 0.5) * math.scalbn(@as(f32, 1), -@intCast(i32, i % 24));
+        ys[i] = random.float(f32) * 252 - 126;
+    }
+
+    exp(&xs, &out);
+    fast.exp(&xs, &fast_out);
+    for (xs) |x, i| {
+        const ref = math.exp(@as(f64, x));
+        try expect(ulpError(out[i], ref) <= 0.501);
+        try expect(ulpError(fast_out[i], ref) <= fast_bound);
+    }
+    fast.exp2(&ys, &fast_out);
+    for (ys) |y, i| {
+        try expect(ulpError(fast_out[i], math.exp2(@as(f64, y))) <= fast_bound);
+    }
+}
+
+test "math.simd32 vectors" {
+    const k = @Vector(8, f32){ -126, -24, -1, 0, 1, 2, 23, 126 };
+    const p8 = exp2Vector(8, k);
+    const q8 = fast.exp2Vector(8, k);
+    comptime var j = 0;
+    inline while (j < 8) : (j += 1) {
+        const pow = math.scalbn(@as(f32, 1), @floatToInt(i32, k[j]));
+        try expect(p8[j] == pow and q8[j] == pow);
+    }
+    const x = @Vector(16, f32){ 0.2, 1.5, -1.5, 3.7, -0.0, 0.5, 10, -10, 80, -80, 0x1p-20, 1, -1, 2, 42, -42 };
+    const y: [16]f32 = exp2Vector(16, x);
+    const e: [16]f32 = expVector(16, x);
+    const f: [16]f32 = fast.expVector(16, x);
+    for (@as([16]f32, x)) |xj, i| {
+        try expect(y[i] == math.exp2(xj));
+        try expect(math.approxEqRel(f32, e[i], math.exp(xj), 0x1p-22));
+        try expect(math.approxEqRel(f32, f[i], math.exp(xj), 0x1p-22));
+    }
+    try expect(e[4] == 1 and f[4] == 1);
+}
+
+test "math.simd32 in place" {
+    var xs = [_]f32{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    exp2(&xs, &xs);
+    for (xs) |x, i| {
+        try expect(x == @intToFloat(f32, @as(u32, 1) << @intCast(u5, i)));
+    }
+}
@@ -0,0 +1,41 @@
+// Root of the objects with the AVX2 and AVX-512 kernels of simd.zig.
+//
+// build.zig compiles this file once for each flavour, with the target's CPU
+// features extended by those of the flavour, and links the objects into
+// programs that declare f128math_simd_objects. Each object exports the slice
+// kernels of its flavour under simd.symbolName(), with the C calling
+// convention, so the program itself can be compiled for the baseline CPU.
+
+const std = @import("std");
+const build_options = @import("build_options");
+const builtin = @import("builtin");
+const simd = @import("simd.zig");
+
+// The options of the program the object is linked into, which build.zig
+// passes on, with the branch counts going to the program's counters.
+pub const f128math_fp_exceptions = build_options.fp_exceptions;
+pub const f128math_branch_counters = build_options.branch_counters;
+pub const f128math_branch_counters_forward = true;
+
+/// The flavour this object is compiled for, from the target's features.
+const target_flavour: simd.Flavour = blk: {
+    const x86 = std.Target.x86;
+    const features = builtin.cpu.features;
+    if (builtin.cpu.arch != .x86_64) {
+        @compileError("simd_export.zig is only compiled for x86_64");
+    }
+    if (x86.featureSetHas(features, .avx512f)) {
+        break :blk .avx512;
+    }
+    if (x86.featureSetHas(features, .avx2)) {
+        break :blk .avx2;
+    }
+    @compileError("simd_export.zig needs at least the avx2 feature");
+};
+
+comptime {
+    const Kernels = simd.CSlices(target_flavour);
+    @export(Kernels.exp, .{ .name = simd.symbolName(target_flavour, "exp") });
+    @export(Kernels.exp2, .{ .name = simd.symbolName(target_flavour, "exp2") });
+    @export(Kernels.log2, .{ .name = simd.symbolName(target_flavour, "log2") });
+}
@@ -0,0 +1,114 @@
+// Applies exp, exp2 or log2 to every element of a binary file of floats.
+//
+//   transform <exp|exp2|log2> <f32|f64|f128> <input> [output]
+//
+// The file holds packed floats in native byte order. Without an output path
+// the input is transformed in place, otherwise the output file is created
+// (or resized) with the same size as the input. An output that is the input
+// file under another name (a relative path, a symlink or a hard link) is
+// also transformed in place, and its contents are never truncated first.
+//
+// Both files are memory mapped and the kernels read from the input mapping
+// and write to the output mapping directly, using the parallel slice
+// functions on the default thread pool, so nothing is copied through an
+// intermediate buffer and files larger than memory are paged through.
+
+const std = @import("std");
+const os = std.os;
+// const math = std.math;
+const math = @import("lib.zig");
+
+const Func = enum { exp, exp2, log2 };
+const FloatType = enum { f32, f64, f128 };
+
+fn transform(comptime T: type, func: Func, xs: []const T, out: []T) void {
+    switch (func) {
+        .exp => math.expParallel(T, null, xs, out),
+        .exp2 => math.exp2Parallel(T, null, xs, out),
+        .log2 => math.log2Parallel(T, null, xs, out),
+    }
+}
+
+fn mapFile(file: std.fs.File, len: usize, writable: bool) ![]align(std.mem.page_size) u8 {
+    const prot: u32 = if (writable) os.PROT.READ | os.PROT.WRITE else os.PROT.READ;
+    const bytes = try os.mmap(null, len, prot, os.MAP.SHARED, file.handle, 0);
+    // Each thread walks forward through its own part of the file.
+    os.madvise(bytes.ptr, bytes.len, os.MADV.SEQUENTIAL) catch {};
+    return bytes;
+}
+
+/// Whether a and b are the same file, by device and inode.
+fn sameFile(a: std.fs.File, b: std.fs.File) !bool {
+    const sa = try os.fstat(a.handle);
+    const sb = try os.fstat(b.handle);
+    return sa.dev == sb.dev and sa.ino == sb.ino;
+}
+
+fn run(comptime T: type, func: Func, input_path: []const u8, output_path: ?[]const u8) !void {
+    const cwd = std.fs.cwd();
+
+    const input = try cwd.openFile(input_path, .{ .read = true, .write = output_path == null });
+    defer input.close();
+    const len = try input.getEndPos();
+    if (len % @sizeOf(T) != 0) {
+        std.debug.print(
+            "Input size {d} is not a multiple of the {s} size ({d} bytes)\n",
+            .{ len, @typeName(T), @sizeOf(T) },
+        );
+        return error.InvalidArgs;
+    }
+
+    // Opened without truncating, and only resized once it is known not to be
+    // the input.
+    const output = if (output_path) |path|
+        try cwd.createFile(path, .{ .read = true, .truncate = false })
+    else
+        input;
+    defer if (output_path != null) output.close();
+    const in_place = output_path == null or try sameFile(input, output);
+    if (!in_place) {
+        try output.setEndPos(len);
+    }
+    // mmap() doesn't take an empty mapping.
+    if (len == 0) return;
+
+    if (in_place) {
+        // The output is opened for writing, the input only without an
+        // output path.
+        const bytes = try mapFile(output, @intCast(usize, len), true);
+        defer os.munmap(bytes);
+        const xs = std.mem.bytesAsSlice(T, bytes);
+        return transform(T, func, xs, xs);
+    }
+
+    const in_bytes = try mapFile(input, @intCast(usize, len), false);
+    defer os.munmap(in_bytes);
+    const out_bytes = try mapFile(output, @intCast(usize, len), true);
+    defer os.munmap(out_bytes);
+    transform(T, func, std.mem.bytesAsSlice(T, in_bytes), std.mem.bytesAsSlice(T, out_bytes));
+}
+
+fn usage() error{InvalidArgs} {
+    std.debug.print("Usage: transform <exp|exp2|log2> <f32|f64|f128> <input> [output]\n", .{});
+    return error.InvalidArgs;
+}
+
+pub fn main() !void {
+    const allocator = std.heap.page_allocator;
+    const args = try std.process.argsAlloc(allocator);
+    defer std.process.argsFree(allocator, args);
+
+    if (args.len != 4 and args.len != 5) {
+        return usage();
+    }
+    // Both are checked before any file is opened.
+    const func = std.meta.stringToEnum(Func, args[1]) orelse return usage();
+    const float_type = std.meta.stringToEnum(FloatType, args[2]) orelse return usage();
+    const output: ?[]const u8 = if (args.len == 5) args[4] else null;
+
+    switch (float_type) {
+        .f32 => try run(f32, func, args[3], output),
+        .f64 => try run(f64, func, args[3], output),
+        .f128 => try run(f128, func, args[3], output),
+    }
+}
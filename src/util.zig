@@ -1,4 +1,5 @@
 const std = @import("std");
+const parse = @import("parse.zig");
 
 pub fn singleInputFuncMain(comptime func: @TypeOf(std.math.exp)) !void {
     var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
@@ -19,13 +20,13 @@ pub fn singleInputFuncMain(comptime func: @TypeOf(std.math.exp)) !void {
         std.debug.print("Expected exactly one input argument\n", .{});
         return error.InvalidArgs;
     }
-    if (!std.mem.eql(u8, input_arg[0..2], "0x")) {
-        std.debug.print("Expected input to start with '0x'\n", .{});
-        return error.InvalidArgs;
-    }
+    // Anything other than a hex bit pattern is taken as an f128 value, in
+    // decimal or as a hex float.
+    const is_bit_pattern = std.mem.startsWith(u8, input_arg, "0x") and
+        std.mem.indexOfAny(u8, input_arg, ".pP") == null;
 
     const stdout = std.io.getStdOut().writer();
-    if (input_arg.len == 10) {
+    if (is_bit_pattern and input_arg.len == 10) {
         const input_bits = try std.fmt.parseUnsigned(u32, input_arg, 0);
         const input = @bitCast(f32, input_bits);
         std.debug.print(
@@ -39,7 +40,7 @@ pub fn singleInputFuncMain(comptime func: @TypeOf(std.math.exp)) !void {
             .{ result_bits, result },
         );
         try stdout.print("0x{X:0>8}", .{@bitCast(u32, result)});
-    } else if (input_arg.len == 18) {
+    } else if (is_bit_pattern and input_arg.len == 18) {
         const input_bits = try std.fmt.parseUnsigned(u64, input_arg, 0);
         const input = @bitCast(f64, input_bits);
         std.debug.print(
@@ -53,8 +54,14 @@ pub fn singleInputFuncMain(comptime func: @TypeOf(std.math.exp)) !void {
             .{ result_bits, result },
         );
         try stdout.print("0x{X:0>16}", .{@bitCast(u64, result)});
-    } else if (input_arg.len == 34) {
-        const input_bits = try std.fmt.parseUnsigned(u128, input_arg, 0);
+    } else if (!is_bit_pattern or input_arg.len == 34) {
+        const input_bits = if (is_bit_pattern)
+            try std.fmt.parseUnsigned(u128, input_arg, 0)
+        else
+            @bitCast(u128, parse.parseFloat(f128, input_arg) catch {
+                std.debug.print("Expected a hex int, or a decimal or hex float\n", .{});
+                return error.InvalidArgs;
+            });
         const input = @bitCast(f128, input_bits);
         std.debug.print(
             "IN:  0x{X:0>32}  {[1]x}  {[1]e}\n",
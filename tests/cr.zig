@@ -0,0 +1,129 @@
+/// Can be run with:
+///   zig0.9 test -mcpu=baseline \
+///     --pkg-begin f128math src/lib.zig --pkg-end \
+///     tests/cr.zig
+const std = @import("std");
+const testing = std.testing;
+
+const f128math = @import("f128math");
+const math = f128math;
+const inf_f64 = math.inf_f64;
+const nan_f64 = math.qnan_f64;
+
+const test_util = @import("util.zig");
+
+const TestcaseExp2_64 = test_util.Testcase(math.cr.exp2, "cr.exp2", f64);
+
+fn tc64(input: f64, exp_output: f64) TestcaseExp2_64 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
+const testcases64 = [_]TestcaseExp2_64{
+    // zig fmt: off
+
+    // Special cases
+    tc64( 0,                     1         ),
+    tc64(-0,                     1         ),
+    tc64( inf_f64,               inf_f64   ),
+    tc64(-inf_f64,               0         ),
+    tc64( nan_f64,               nan_f64   ),
+    tc64( 0x1p+10,               inf_f64   ),
+    tc64(-0x1.0ccp+10,           0         ), // 2^-1075 ties to even
+    tc64(-0x1.0c8p+10,           0x1p-1074 ),
+    tc64( 0x1.ffffffffffffp+9,   0x1.fffffffffd3a3p+1023 ),
+
+    // Correctly rounded results from misc/exact_vectors.py exp2 f64 --cr,
+    // which computes them with 120 digit decimal arithmetic. The last 24
+    // are within 2^-59 of a point half way between two f64, so they take
+    // the slow path.
+    tc64( 0x1.75cc268df37dep-2,   0x1.49b4c0387238ep+0   ),
+    tc64(-0x1.1052a0480ebd7p-2,   0x1.a9cee3f327a7fp-1   ),
+    tc64( 0x1.9f0152362fadbp-1,   0x1.c0fed4941b798p+0   ),
+    tc64( 0x1.a2522101708b4p-2,   0x1.53cb415583e41p+0   ),
+    tc64( 0x1.7245b56084deep-2,   0x1.48eb95d35ef8ap+0   ),
+    tc64(-0x1.8357fe50bb4dep-1,   0x1.2f0fe106911e1p-1   ),
+    tc64(-0x1.9272a2aece0cp-1,    0x1.28ed8eeefdd51p-1   ),
+    tc64( 0x1.95cdc91897c7fp-1,   0x1.bb6fe54f989cp+0    ),
+    tc64( 0x1.0c2582d009f82p-1,   0x1.700a8fc2d3345p+0   ),
+    tc64(-0x1.94c88b0dbc1fcp-1,   0x1.27fd96fc39a24p-1   ),
+    tc64(-0x1.88d068b42a864p-2,   0x1.88751c4645a1p-1    ),
+    tc64(-0x1.ee2f9ab8026b6p-1,   0x1.063fb9a719b17p-1   ),
+    tc64( 0x1.f4ddf23471c8p-2,    0x1.675213f9963dfp+0   ),
+    tc64(-0x1.49699995dc487p-1,   0x1.47c98d6d7127fp-1   ),
+    tc64(-0x1.056bb8caa9c54p-2,   0x1.acf649ee4ceddp-1   ),
+    tc64(-0x1.dc0b4bd5c390ap-1,   0x1.0cc506752198bp-1   ),
+    tc64( 0x1.07c7f395ca9f8p-2,   0x1.320b73199daf9p+0   ),
+    tc64( 0x1.b7118c958f6ddp-1,   0x1.cfdcfe6ecc54ep+0   ),
+    tc64(-0x1.019b2afd67265p-1,   0x1.694097f688924p-1   ),
+    tc64(-0x1.fe25a97ac5a58p-7,   0x1.fa812d1aa653bp-1   ),
+    tc64( 0x1.ec6a6cf897ae5p-1,   0x1.f29a84f268e9ap+0   ),
+    tc64( 0x1.5d2d156676383p-1,   0x1.9ab65dced03bp+0    ),
+    tc64( 0x1.d19e0df5ce423p-1,   0x1.e0d6b03f95538p+0   ),
+    tc64( 0x1.04dd30e0d4911p-1,   0x1.6c6e37d6f0a2bp+0   ),
+    tc64(-0x1.74c1313edf40ep-3,   0x1.c350a33eac28ap-1   ),
+    tc64( 0x1.3780e63b36e9fp-1,   0x1.864a6bb966822p+0   ),
+    tc64(-0x1.5fe9435b379f4p-2,   0x1.9379b0b249155p-1   ),
+    tc64(-0x1.e905a4c1da2efp-1,   0x1.0816b5b7d5168p-1   ),
+    tc64(-0x1.07a6283c2582cp-1,   0x1.664f1a37c0272p-1   ),
+    tc64( 0x1.ff0ff90a935dep-1,   0x1.ff59bb3be781dp+0   ),
+    tc64(-0x1.0abbf7ec98011p+9,   0x1.72078cd927fbfp-534 ),
+    tc64(-0x1.d82bb1a2911d8p+7,   0x1.e297916c62d5cp-237 ),
+    tc64( 0x1.2d578d4b0c392p+8,   0x1.447baf205d03cp+301 ),
+    tc64( 0x1.93d3d250132e8p+7,   0x1.e2468c0bbcfb4p+201 ),
+    tc64( 0x1.8ce22cb1d975dp+9,   0x1.b3a38ef821913p+793 ),
+    tc64( 0x1.bb04da5e6dd64p+9,   0x1.06d11e925dfe8p+886 ),
+    tc64( 0x1.9cdd0069d8e6bp+9,   0x1.a79ad4009f5d1p+825 ),
+    tc64( 0x1.39cc346a17e12p+6,   0x1.5d90bfd33fcbap+78  ),
+    tc64(-0x1.a1d165f123463p+9,   0x1.497c993dbeacdp-836 ),
+    tc64(-0x1.04884bc7d2915p+9,   0x1.e981f01ecc8f6p-522 ),
+    tc64( 0x1.c839646cecbf8p+8,   0x1.2b09eb5b0a08bp+456 ),
+    tc64(-0x1.1adbc6c7b267fp+9,   0x1.377ae8402c237p-566 ),
+    tc64(-0x1.9e2d7efa2ffc8p+9,   0x1.90322463bc84p-829  ),
+    tc64(-0x1.9378716ed0ee5p+9,   0x1.0ab1828ed47cbp-807 ),
+    tc64(-0x1.386a4da763aaap+9,   0x1.1fea8c8da7c7ap-625 ),
+    tc64(-0x1.1d551969de4dp+7,    0x1.42a45ab7ce24ep-143 ),
+    tc64( 0x1.8a1604fcbb18bp+8,   0x1.0fba164dac3bbp+394 ),
+    tc64(-0x1.b974d57b2181ep+9,   0x1.0ff501ff2b89ap-883 ),
+    tc64( 0x1.213e54c61ce8fp+9,   0x1.66c816eebbcaep+578 ),
+    tc64( 0x1.3a997f5cde7b3p+9,   0x1.25e7536fe958cp+629 ),
+    tc64(-0x1.05c403579b729p+10,  0x1.ea393b4p-1048      ),
+    tc64(-0x1.0bd4e1953958cp+10,  0x1.8p-1072            ),
+    tc64(-0x1.0469db61d022bp+10,  0x1.45617731p-1042     ),
+    tc64(-0x1.0a91695f18cf4p+10,  0x1.a8p-1067           ),
+    tc64(-0x1.056306191859fp+10,  0x1.5e5fccbp-1046      ),
+    tc64(-0x1.046eece9ea7e9p+10,  0x1.34002f77p-1042     ),
+    tc64(-0x1.0220de2e56fbdp+10,  0x1.66a6cd78d78p-1033  ),
+    tc64(-0x1.09f3ac7ceea48p+10,  0x1.248p-1064          ),
+    tc64(-0x1.00caa7a18bea3p+10,  0x1.c832dfd3525cp-1028 ),
+    tc64(-0x1.009a01ee03cf2p+10,  0x1.825086901feep-1027 ),
+    tc64( 0x1.a52dc4bcf89e5p+8,   0x1.21c6164665b9ap+421 ),
+    tc64(-0x1.16f9ce3c04607p+9,   0x1.08bb9fc41e87fp-558 ),
+    tc64(-0x1.60a28cec6d7c3p+5,   0x1.e497cc7a68af9p-45  ),
+    tc64(-0x1.e0f2d940f3bd4p+6,   0x1.b26388d477fcfp-121 ),
+    tc64( 0x1.98f7f35814701p+9,   0x1.ea296132de765p+817 ),
+    tc64( 0x1.e784445aa2931p+8,   0x1.6e3ee6027344fp+487 ),
+    tc64( 0x1.aaec54043d338p+8,   0x1.e571501306672p+426 ),
+    tc64(-0x1.f0022bcb324dbp+9,   0x1.fa040923ac385p-993 ),
+    tc64(-0x1.e1cd45aa44b3dp+9,   0x1.50ee7692e3abep-964 ),
+    tc64(-0x1.1614c396d9f6p+4,    0x1.896bcf9e6fbf4p-18  ),
+    tc64(-0x1.14d698c1dcb72p+9,   0x1.405736f673677p-554 ),
+    tc64(-0x1.833de1dccd882p+8,   0x1.b103c6b5e4d53p-388 ),
+    tc64( 0x1.9a8010bc01e13p+9,   0x1.001733f24d06dp+821 ),
+    tc64(-0x1.94365332a683bp+8,   0x1.b9f76858016c4p-405 ),
+    tc64( 0x1.d3bf7845db3dep+8,   0x1.adebde05e5466p+467 ),
+    tc64( 0x1.cd90faa1ff72ap+7,   0x1.b88cd135e156fp+230 ),
+    tc64(-0x1.23318f299b601p+8,   0x1.bfb4d94e7d48fp-292 ),
+    tc64(-0x1.75dc5dea203dep+8,   0x1.19ee04ecf00e1p-374 ),
+    tc64(-0x1.e921e5a119aabp+7,   0x1.59ccdaae99315p-245 ),
+    tc64(-0x1.3f8aac460ca3bp+8,   0x1.5fb9e556ec04fp-320 ),
+    tc64( 0x1.863d58af75fe7p+9,   0x1.64df9da609f46p+780 ),
+    tc64(-0x1.8c43a51a7316fp+9,   0x1.62f678be45581p-793 ),
+    tc64(-0x1.9075508f11518p+6,   0x1.d8ea0deb0aab4p-101 ),
+    tc64( 0x1.8f24092b14062p+8,   0x1.1a3cc03c51934p+399 ),
+
+    // zig fmt: on
+};
+
+test "cr.exp2_64()" {
+    try test_util.runTests(testcases64);
+}
@@ -0,0 +1,114 @@
+//! Checks the f32 functions of math.cr against the f128 kernels rounded to
+//! f32, for every one of the 2^32 arguments. This is what the exception
+//! tables of src/cr.zig rely on, and it includes the subnormal results.
+//! Arguments are split between one thread per CPU, and the f128 kernels
+//! dominate, so it takes long: it isn't part of 'zig build test'.
+//!
+//! Run with 'zig build exhaustive-cr'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+const max_threads = 64;
+
+/// The number of mismatches printed per function and thread.
+const max_printed = 8;
+
+const Func = enum {
+    exp,
+    exp2,
+    log2,
+};
+
+fn crFunc(comptime func: Func, x: f32) f32 {
+    return switch (func) {
+        .exp => math.cr.exp(x),
+        .exp2 => math.cr.exp2(x),
+        .log2 => math.cr.log2(x),
+    };
+}
+
+fn refFunc(comptime func: Func, x: f32) f32 {
+    const xq: f128 = x;
+    return @floatCast(f32, switch (func) {
+        .exp => math.exp(xq),
+        .exp2 => math.exp2(xq),
+        .log2 => math.log2(xq),
+    });
+}
+
+/// Returns whether the results agree, any nan matching any other.
+fn same(y: f32, ref: f32) bool {
+    if (math.isNan(ref)) {
+        return math.isNan(y);
+    }
+    return @bitCast(u32, y) == @bitCast(u32, ref);
+}
+
+const Worker = struct {
+    start: u64,
+    end: u64,
+    mismatches: [3]u64 = [_]u64{0} ** 3,
+
+    fn check(self: *Worker, comptime func: Func, x: f32) void {
+        const y = crFunc(func, x);
+        const ref = refFunc(func, x);
+        if (same(y, ref)) {
+            return;
+        }
+        const count = &self.mismatches[@enumToInt(func)];
+        if (count.* < max_printed) {
+            std.debug.print("cr.{s}({e}) [0x{X:0>8}] = 0x{X:0>8}, expected 0x{X:0>8}\n", .{
+                @tagName(func),
+                x,
+                @bitCast(u32, x),
+                @bitCast(u32, y),
+                @bitCast(u32, ref),
+            });
+        }
+        count.* += 1;
+    }
+
+    fn run(self: *Worker) void {
+        var ux = self.start;
+        while (ux < self.end) : (ux += 1) {
+            const x = @bitCast(f32, @intCast(u32, ux));
+            self.check(.exp, x);
+            self.check(.exp2, x);
+            self.check(.log2, x);
+        }
+    }
+};
+
+pub fn main() !void {
+    const n_threads = math.min(std.Thread.getCpuCount() catch 1, max_threads);
+    const n_args = @as(u64, 1) << 32;
+
+    var workers: [max_threads]Worker = undefined;
+    var threads: [max_threads]std.Thread = undefined;
+    var i: usize = 0;
+    while (i < n_threads) : (i += 1) {
+        workers[i] = .{
+            .start = n_args * i / n_threads,
+            .end = n_args * (i + 1) / n_threads,
+        };
+        threads[i] = try std.Thread.spawn(.{}, Worker.run, .{&workers[i]});
+    }
+
+    var mismatches = [_]u64{0} ** 3;
+    for (threads[0..n_threads]) |thread, j| {
+        thread.join();
+        for (workers[j].mismatches) |count, f| {
+            mismatches[f] += count;
+        }
+    }
+
+    var total: u64 = 0;
+    for (mismatches) |count, f| {
+        std.debug.print("cr.{s}: {d} mismatches\n", .{ @tagName(@intToEnum(Func, f)), count });
+        total += count;
+    }
+    if (total != 0) {
+        return error.Mismatch;
+    }
+}
@@ -0,0 +1,183 @@
+/// Can be run with:
+///   zig0.9 test -mcpu=baseline \
+///     --pkg-begin f128math src/lib.zig --pkg-end \
+///     tests/exp10.zig
+const std = @import("std");
+const testing = std.testing;
+
+const f128math = @import("f128math");
+const math = f128math;
+const inf_f32 = math.inf_f32;
+const nan_f32 = math.qnan_f32;
+const inf_f64 = math.inf_f64;
+const nan_f64 = math.qnan_f64;
+const inf_f128 = math.inf_f128;
+const nan_f128 = math.qnan_f128;
+
+const test_util = @import("util.zig");
+
+const TestcaseExp10_32 = test_util.Testcase(math.exp10, "exp10", f32);
+const TestcaseExp10_64 = test_util.Testcase(math.exp10, "exp10", f64);
+const TestcaseExp10_128 = test_util.Testcase(math.exp10, "exp10", f128);
+
+fn tc32(input: f32, exp_output: f32) TestcaseExp10_32 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
+fn tc64(input: f64, exp_output: f64) TestcaseExp10_64 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
+fn tc128(input: f128, exp_output: f128) TestcaseExp10_128 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
+const testcases32 = [_]TestcaseExp10_32{
+    // zig fmt: off
+
+    // Special cases
+    tc32( 0,        1       ),
+    tc32(-0,        1       ),
+    tc32( 1,        10      ),
+    tc32(-1,        0.1     ),
+    tc32( inf_f32,  inf_f32 ),
+    tc32(-inf_f32,  0       ),
+    tc32( nan_f32,  nan_f32 ),
+    tc32(-nan_f32,  nan_f32 ),
+    tc32( @bitCast(f32, @as(u32, 0x7ff01234)),  nan_f32 ),
+    tc32( @bitCast(f32, @as(u32, 0xfff01234)),  nan_f32 ),
+
+    // Exact powers of ten
+    tc32( 3,        1000           ),
+    tc32(-3,        0x1.0624dep-10 ),
+    tc32( 10,       1e10           ),
+    tc32(-10,       0x1.b7cdfep-34 ),
+
+    // Sanity cases
+    tc32(-0x1.ad2p-4,      0x1.9241acp-1   ),
+    tc32( 0x1.78cf14p+1,   0x1.b75422p+9   ),
+    tc32( 0x1.7b40ep-1,    0x1.604c1cp+2   ),
+    tc32(-0x1.24231cp+1,   0x1.561abp-8    ),
+    tc32(-0x1.f5872cp+1,   0x1.fa6002p-14  ),
+    tc32( 0x1.e593p-4,     0x1.5058fep+0   ),
+    tc32( 0x1.fbd9dcp+1,   0x1.220682p+13  ),
+    tc32(-0x1.df4d24p+1,   0x1.79a62p-13   ),
+    tc32( 0x1.a002fp-1,    0x1.9fa02ep+2   ),
+    tc32(-0x1.c753aep+1,   0x1.22a468p-12  ),
+    tc32( 0x1p-1,          0x1.94c584p+1   ),
+
+    // Boundary cases
+    tc32( 0x1.344134p+5,   0x1.ffff66p+127 ), // The last value before the exp gets infinite
+    tc32( 0x1.344136p+5,   inf_f32         ), // The first value that gives infinite exp
+    tc32(-0x1.693c6ap+5,   0x1p-149        ), // The last value before the exp flushes to zero
+    tc32(-0x1.693c6cp+5,   0               ), // The first value at which the exp flushes to zero
+    tc32(-0x1.2f703p+5,    0x1.00001p-126  ),
+    tc32(-0x1.2f7032p+5,   0x1.fffef8p-127 ),
+
+    // zig fmt: on
+};
+
+const testcases64 = [_]TestcaseExp10_64{
+    // zig fmt: off
+
+    // Special cases
+    tc64( 0,        1       ),
+    tc64(-0,        1       ),
+    tc64( 1,        10      ),
+    tc64(-1,        0.1     ),
+    tc64( inf_f64,  inf_f64 ),
+    tc64(-inf_f64,  0       ),
+    tc64( nan_f64,  nan_f64 ),
+    tc64(-nan_f64,  nan_f64 ),
+    tc64( @bitCast(f64, @as(u64, 0x7ff0123400000000)),  nan_f64 ),
+    tc64( @bitCast(f64, @as(u64, 0xfff0123400000000)),  nan_f64 ),
+
+    // Exact powers of ten
+    tc64( 3,        1000                    ),
+    tc64(-3,        0x1.0624dd2f1a9fcp-10   ),
+    tc64( 22,       1e22                    ),
+    tc64(-22,       0x1.e392010175ee6p-74   ),
+    tc64( 23,       0x1.52d02c7e14af6p+76   ),
+
+    // Sanity cases
+    tc64( 0x1.b6c339c36d86p-3,     0x1.a34197be64815p+0    ),
+    tc64(-0x1.a47b20b748f64p+1,    0x1.0ffef336925eep-11   ),
+    tc64( 0x1.0ec87f1e1d91p+1,     0x1.04ee06b92d145p+7    ),
+    tc64( 0x1.43104f368620ap+1,    0x1.4e252bb119d05p+8    ),
+    tc64( 0x1.8e4ecd4f1c9dap+1,    0x1.43628e86f92c5p+10   ),
+    tc64(-0x1.582af23eb055ep+1,    0x1.0c593ce3bcbf1p-9    ),
+    tc64(-0x1.2352d06e46a5ap+1,    0x1.5b25fc336cbdfp-8    ),
+    tc64( 0x1.26964c164d2cap+1,    0x1.9065d76f86659p+7    ),
+    tc64( 0x1.27a063964f40cp+1,    0x1.97f475ed7ffccp+7    ),
+    tc64(-0x1.bbc134ff77826p+1,    0x1.65e759ad9825ep-12   ),
+    tc64( 0x1p-1,                  0x1.94c583ada5b53p+1    ),
+
+    // Boundary cases
+    tc64( 0x1.34413509f79fep+8,    0x1.ffffffffffba1p+1023 ), // The last value before the exp gets infinite
+    tc64( 0x1.34413509f79ffp+8,    inf_f64                 ), // The first value that gives infinite exp
+    tc64(-0x1.439b746e36b52p+8,    0x1p-1074               ), // The last value before the exp flushes to zero
+    tc64(-0x1.439b746e36b53p+8,    0                       ), // The first value at which the exp flushes to zero
+    tc64(-0x1.33a7146f72a41p+8,    0x1.0000000000231p-1022 ), // The last value before the exp flushes to subnormal
+    // TODO: one digit off
+    // tc64(-0x1.33a7146f72a42p+8,    0x0.fffffffffffe3p-1022 ), // The first value for which exp flushes to subnormal
+
+    // zig fmt: on
+};
+
+const testcases128 = [_]TestcaseExp10_128{
+    // zig fmt: off
+
+    // Special cases
+    tc128( 0,         1        ),
+    tc128(-0,         1        ),
+    tc128( 1,         10       ),
+    tc128(-1,         0.1      ),
+    tc128( inf_f128,  inf_f128 ),
+    tc128(-inf_f128,  0        ),
+    tc128( nan_f128,  nan_f128 ),
+    tc128(-nan_f128,  nan_f128 ),
+    tc128( @bitCast(f128, @as(u128, 0x7fff1234000000000000000000000000)),  nan_f128 ),
+    tc128( @bitCast(f128, @as(u128, 0xffff1234000000000000000000000000)),  nan_f128 ),
+
+    // Exact powers of ten
+    tc128( 3,         1000                                    ),
+    tc128(-3,         0x1.0624dd2f1a9fbe76c8b439581062p-10    ),
+    tc128( 48,        0x1.5e531a0a1c872bad2ce16256fe82p+159   ),
+    tc128(-48,        0x1.7624f8a762fd82b2aac18030b01bp-160   ),
+    // TODO: one digit off
+    // tc128( 49,        0x1.b5e7e08ca3a8f6987819baecbe22p+162   ),
+
+    // Sanity cases
+    tc128(-0x1.144d10f2289a1439ff2e43c8a268p-1,  0x1.279006ff2882b63e213edd0a9e17p-2  ),
+    tc128(-0x1.45c5783a8b8aaf32b12de0ea2e2cp+0,  0x1.b55dd4f8bcbb4373314117332555p-5  ),
+    tc128(-0x1.ef973997df2e627574f6e65f7cbap+1,  0x1.19b9eeafe1821e48b55b2dc590e2p-13 ),
+    tc128(-0x1.17261fea2e4bde9f93287fa8b93p+0,   0x1.4c9bfec5b7eef97a9fbf724f6e6ap-4  ),
+    tc128(-0x1.db36f9f7b66def4d1b24e7ded9b8p+1,  0x1.96750141e6d8d9adbf2d964c1363p-13 ),
+    tc128(-0x1.4616d5968c2d89b71800565a30b6p+1,  0x1.737b7553f5628f6d60b3be5b5f04p-9  ),
+    tc128( 0x1.c2f42d9785e88cbaa214b65e17a2p+1,  0x1.a0db4d9a09eb5cd172da31aee05ep+11 ),
+    tc128( 0x1.e679d66bccf426853a0659af33dp+0,   0x1.3df2c78896864b333ae524ac7231p+6  ),
+    tc128(-0x1.b03405cb6067adb3e7f0172d81ap+0,   0x1.4fd5cbc1fc9165c45c1653fd41a2p-6  ),
+    tc128( 0x1.ee1fdd8fdc3ff41e23f9763f70fep+1,  0x1.c522863735746b5f9e0d822d5218p+12 ),
+    tc128( 0x1p-1,                               0x1.94c583ada5b529204a2bc830cd9cp+1  ),
+
+    // Boundary cases
+    tc128( 0x1.34413509f79fef311f12b35816f9p+12, 0x1.fffffffffffffffffffffffff5f2p+16383 ), // The last value before the exp gets infinite
+    tc128( 0x1.34413509f79fef311f12b35816fap+12, inf_f128                                ), // The first value that gives infinite exp
+    tc128(-0x1.3657d621f4e96893f84497c723cp+12,  0x1p-16494                              ), // The last value before the exp flushes to zero
+    tc128(-0x1.3657d621f4e96893f84497c723c1p+12, 0                                       ), // The first value at which the exp flushes to zero
+    tc128( 0x1p-16384,                           1                                       ), // Very close to zero
+
+    // zig fmt: on
+};
+
+test "exp10_32()" {
+    try test_util.runTests(testcases32);
+}
+
+test "exp10_64()" {
+    try test_util.runTests(testcases64);
+}
+
+test "exp10_128()" {
+    try test_util.runTests(testcases128);
+}
@@ -1,5 +1,5 @@
 /// Can be run with:
-///   zig0.9 test \
+///   zig0.9 test -mcpu=baseline \
 ///     --pkg-begin f128math src/lib.zig --pkg-end \
 ///     tests/exp2.zig
 const std = @import("std");
@@ -7,19 +7,29 @@ const testing = std.testing;
 
 const f128math = @import("f128math");
 const math = f128math;
+const inf_f16 = math.inf_f16;
+const nan_f16 = math.qnan_f16;
 const inf_f32 = math.inf_f32;
 const nan_f32 = math.qnan_f32;
 const inf_f64 = math.inf_f64;
 const nan_f64 = math.qnan_f64;
+const inf_f80 = math.inf_f80;
+const nan_f80 = math.qnan_f80;
 const inf_f128 = math.inf_f128;
 const nan_f128 = math.qnan_f128;
 
 const test_util = @import("util.zig");
 
+const TestcaseExp2_16 = test_util.Testcase(math.exp2, "exp2", f16);
 const TestcaseExp2_32 = test_util.Testcase(math.exp2, "exp2", f32);
 const TestcaseExp2_64 = test_util.Testcase(math.exp2, "exp2", f64);
+const TestcaseExp2_80 = test_util.Testcase(math.exp2, "exp2", f80);
 const TestcaseExp2_128 = test_util.Testcase(math.exp2, "exp2", f128);
 
+fn tc16(input: f16, exp_output: f16) TestcaseExp2_16 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
 fn tc32(input: f32, exp_output: f32) TestcaseExp2_32 {
     return .{ .input = input, .exp_output = exp_output };
 }
@@ -28,10 +38,48 @@ fn tc64(input: f64, exp_output: f64) TestcaseExp2_64 {
     return .{ .input = input, .exp_output = exp_output };
 }
 
+fn tc80(input: f80, exp_output: f80) TestcaseExp2_80 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
 fn tc128(input: f128, exp_output: f128) TestcaseExp2_128 {
     return .{ .input = input, .exp_output = exp_output };
 }
 
+const testcases16 = [_]TestcaseExp2_16{
+    // zig fmt: off
+
+    // Special cases
+    tc16( 0,                               1           ),
+    tc16(-0,                               1           ),
+    tc16( 1,                               2           ),
+    tc16(-1,                               0.5         ),
+    tc16( inf_f16,                         inf_f16     ),
+    tc16(-inf_f16,                         0           ),
+    tc16( nan_f16,                         nan_f16     ),
+    tc16(-nan_f16,                         nan_f16     ),
+    tc16( @bitCast(f16, @as(u16, 0x7c12)), nan_f16     ),
+    tc16( @bitCast(f16, @as(u16, 0xfc12)), nan_f16     ),
+
+    // Sanity cases
+    tc16( 0x1.998p-3,                      0x1.26p+0   ),
+    tc16( 0x1.c8cp-1,                      0x1.dbp+0   ),
+    tc16( 0x1.8p+0,                        0x1.6ap+1   ),
+    tc16(-0x1.8p+0,                        0x1.6ap-2   ),
+    tc16( 0x1.d98p+1,                      0x1.9fcp+3  ),
+    tc16(-0x1.dp+2,                        0x1.ae8p-8  ),
+
+    // Boundary cases
+    tc16( 0x1.ffcp+3,                      0x1.fd4p+15 ), // The last value before the exp gets infinite
+    tc16( 0x1p+4,                          inf_f16     ), // The first value that gives infinite exp
+    tc16(-0x1.8fcp+4,                      0x1p-24     ), // The last value before the exp flushes to zero
+    tc16(-0x1.9p+4,                        0           ), // The first value at which the exp flushes to zero
+    tc16(-0x1.8p+4,                        0x1p-24     ),
+    tc16( 0x1p-11,                         1           ),
+
+    // zig fmt: on
+};
+
 const testcases32 = [_]TestcaseExp2_32{
     // zig fmt: off
 
@@ -124,6 +172,92 @@ const testcases64 = [_]TestcaseExp2_64{
     // zig fmt: on
 };
 
+const testcases80 = [_]TestcaseExp2_80{
+    // zig fmt: off
+
+    // Special cases
+    tc80( 0,        1       ),
+    tc80(-0,        1       ),
+    tc80( inf_f80,  inf_f80 ),
+    tc80(-inf_f80,  0       ),
+    tc80( nan_f80,  nan_f80 ),
+    tc80(-nan_f80,  nan_f80 ),
+    tc80( @bitCast(f80, @as(u80, 0x7fffc000000000001234)),  nan_f80 ),
+    tc80( @bitCast(f80, @as(u80, 0xffffc000000000001234)),  nan_f80 ),
+
+    // Sanity cases, correctly rounded, from 'misc/exact_vectors.py exp2 f80'
+    tc80( 0x1.7ebae6135cdf37dep-1,   0x1.adcca5c899a2381cp+0     ),
+    tc80( 0x1.9ec5f5b5a177d6bp-1,    0x1.c0dac0d0299fceecp+0     ),
+    tc80( 0x1.5a25221202e1167cp-6,   0x1.03c6c7877642d324p+0     ),
+    tc80(-0x1.821769bcb546dd26p-1,   0x1.2f938532a9692b2p-1      ),
+    tc80( 0x1.106d8d5d5a263e8p-1,    0x1.722e41788d632d38p+0     ),
+    tc80( 0x1.0e013f041395cdcap-1,   0x1.70f7e5c9301defcp+0      ),
+    tc80(-0x1.4394c88b11b783f8p-1,   0x1.4a62a02d757eb89cp-1     ),
+    tc80(-0x1.ef004d6c12c46834p-1,   0x1.05f5abda03c4de6cp-1     ),
+    tc80(-0x1.720b220dd171c7p-2,     0x1.8e8daee2069f5356p-1     ),
+    tc80(-0x1.015538a78e92d334p-2,   0x1.ae2693a9f9b6486ap-1     ),
+    tc80(-0x1.47b816978570e426p-2,   0x1.9a230d6d0d2731ep-1      ),
+    tc80( 0x1.b6b1edba5283e3fap-1,   0x1.cfa0f61939feb64p+0      ),
+    tc80( 0x1.40fe64d504531b36p-1,   0x1.8b56641a0d7d3fp+0       ),
+    tc80( 0x1.ef12f5ca25f8076ap-1,   0x1.f466b7181ee49126p+0     ),
+    tc80( 0x1.76ba5a2ae19d8e0cp-2,   0x1.49e9edd92527e96cp+0     ),
+    tc80( 0x1.041a92223fd19e0ep-1,   0x1.6c0e3f93ca1b1c08p+0     ),
+    tc80( 0x1.65a2cfb3ae0905fap-1,   0x1.9f717c0c35b6c4bep+0     ),
+    tc80(-0x1.5b66f3e71190fe34p-2,   0x1.94b56dd8bf2f764cp-1     ),
+    tc80(-0x1.87e905a4d03b45dep-1,   0x1.2d31b8dc5f075cdap-1     ),
+    tc80( 0x1.fd526bbbfcf859d8p-1,   0x1.fe25a73415a5a74ep+0     ),
+    tc80( 0x1.a7a409427d7f5ecep-4,   0x1.1306d666dbe4d57ep+0     ),
+    tc80( 0x1.2f114b770b12aed2p-2,   0x1.3a4ae6a8b100c93cp+0     ),
+    tc80(-0x1.ab36e3cff97d2c64p-2,   0x1.7f6ca6f83320cf7p-1      ),
+    tc80( 0x1.b887dcbf638cc55ep-1,   0x1.d0c849a433815b9p+0      ),
+    tc80( 0x1.639cc43172c6ce8ap-1,   0x1.9e4e8525053879a6p+0     ),
+    tc80(-0x1.a2c81acc45d93cc8p-1,   0x1.226f219944683fd2p-1     ),
+    tc80(-0x1.f705499e3debcd1cp-1,   0x1.032188f4c9276b8ap-1     ),
+    tc80(-0x1.1a71e977dd1c2a58p-1,   0x1.5d4e76a6d7abdcaep-1     ),
+    tc80(-0x1.1cf8aa220b42cd2cp-4,   0x1.e7e51f5e4b7c5478p-1     ),
+    tc80(-0x1.39cae80d9f945d88p-1,   0x1.4ecae7b57419a4e4p-1     ),
+    tc80(-0x1.4c7a9c41309ee272p+12,  0x1.4353cf77b08e4582p-5320  ),
+    tc80(-0x1.bac7fa9aa9623ee2p+13,  0x1.0077cb0f185215b6p-14169 ),
+    tc80(-0x1.98d095ed9ce2fafep+13,  0x1.e6aae7061a42d9aep-13083 ),
+    tc80( 0x1.3e5be8a43307b2fep+9,   0x1.a51af395f3212f16p+636   ),
+    tc80(-0x1.b3bc89ecd6b807p+13,    0x1.5986db468de7caccp-13944 ),
+    tc80(-0x1.675cd159ad75626p+13,   0x1.5146324684a933acp-11500 ),
+    tc80( 0x1.c702846b65e7744cp+8,   0x1.01c03409145dd1e2p+455   ),
+    tc80( 0x1.3148504cf4f63e68p+13,  0x1.070d8c836605916p+9769   ),
+    tc80( 0x1.d99a083277750952p+12,  0x1.8b5aa082f89b5984p+7577  ),
+    tc80( 0x1.aa03393bee8c742ap+13,  0x1.527c0e0ea4cb6ca4p+13632 ),
+    tc80( 0x1.72e57a7abf3f07aap+10,  0x1.802b7c6cb7289a28p+1483  ),
+    tc80( 0x1.d5de96664b774752p+13,  0x1.c505a1b75e7ccac6p+15035 ),
+    tc80( 0x1.44ce76478a65383p+13,   0x1.c01fb364e0969a22p+10393 ),
+    tc80( 0x1.015d28b69da91736p+12,  0x1.c4b578dd013f1062p+4117  ),
+    tc80( 0x1.5e395e4d2eb64788p+13,  0x1.20394ad6df51bee2p+11207 ),
+    tc80( 0x1.978882c7e2da5d9ap+13,  0x1.0b95f7cd55eb92fap+13041 ),
+    tc80(-0x1.3edcdb7a3766db02p+11,  0x1.120891c3d8586afep-2551  ),
+    tc80(-0x1.30abac27e9dea586p+11,  0x1.8d9de60e809eb872p-2438  ),
+    tc80(-0x1.22b21829e53acacap+12,  0x1.d39712d3c3b7c60cp-4652  ),
+    tc80( 0x1.d4fe3098c13c68b6p+13,  0x1.b5adc90cad31f04ap+15007 ),
+    tc80(-0x1.00a2620668a90cecp+14,  0x1.52cbcp-16425            ),
+    tc80(-0x1.00571ded5842f7a6p+14,  0x1.2a54f55a3p-16406        ),
+    tc80(-0x1.00a10d23a3a90e78p+14,  0x1.aaba1p-16425            ),
+    tc80(-0x1.00227ccb3070e1e8p+14,  0x1.4cb6558ea172bp-16393    ),
+    tc80(-0x1.001b48332d284ebap+14,  0x1.21ea8de2d12bc8p-16391   ),
+    tc80(-0x1.00527b618b9f00aap+14,  0x1.4d07d1f931p-16405       ),
+    tc80(-0x1.003d35cabdc74ep+14,    0x1.9f24eb64f54p-16400      ),
+    tc80(-0x1.006c0b3d72dae862p+14,  0x1.fc1e89528p-16412        ),
+    tc80(-0x1.0048e770596a7b2cp+14,  0x1.b5c1b7c70c8p-16403      ),
+    tc80(-0x1.00a0a2c0a2833f0cp+14,  0x1.ca972p-16425            ),
+
+    // Boundary cases
+    tc80( 0x1.fffffffffffffffcp+13,  0x1.ffffffffffff4e8ep+16383 ), // The last value before the exp2 gets infinite
+    tc80( 0x1p+14,                   inf_f80                     ), // The first value that gives infinite exp2
+    tc80(-0x1.00f7fffffffffffep+14,  0x1p-16445                  ), // The last value before the exp2 flushes to zero
+    tc80(-0x1.00f8p+14,              0                           ), // The first value at which the exp2 flushes to zero (a tie)
+    tc80(-0x1.ffeffffffffffffep+13,  0x1.0000000000002c5cp-16382 ), // The last value before the exp2 flushes to subnormal
+    tc80(-0x1.fff0000000000002p+13,  0x1.ffffffffffffa748p-16383 ), // The first value for which exp2 flushes to subnormal
+
+    // zig fmt: on
+};
+
 const testcases128 = [_]TestcaseExp2_128{
     // zig fmt: off
 
@@ -170,6 +304,10 @@ const testcases128 = [_]TestcaseExp2_128{
     // zig fmt: on
 };
 
+test "exp2_16()" {
+    try test_util.runTests(testcases16);
+}
+
 test "exp2_32()" {
     try test_util.runTests(testcases32);
 }
@@ -178,6 +316,10 @@ test "exp2_64()" {
     try test_util.runTests(testcases64);
 }
 
+test "exp2_80()" {
+    try test_util.runTests(testcases80);
+}
+
 test "exp2_128()" {
     try test_util.runTests(testcases128);
 }
@@ -0,0 +1,55 @@
+/// Can be run with:
+///   zig0.9 test -mcpu=baseline \
+///     --pkg-begin f128math src/lib.zig --pkg-end \
+///     tests/expm1.zig
+const std = @import("std");
+const testing = std.testing;
+
+const f128math = @import("f128math");
+const math = f128math;
+const inf_f128 = math.inf_f128;
+const nan_f128 = math.qnan_f128;
+
+const test_util = @import("util.zig");
+
+const TestcaseExpm1_128 = test_util.Testcase(math.expm1, "expm1", f128);
+
+fn tc128(input: f128, exp_output: f128) TestcaseExpm1_128 {
+    return .{ .input = input, .exp_output = exp_output };
+}
+
+const testcases128 = [_]TestcaseExpm1_128{
+    // zig fmt: off
+
+    // Special cases
+    tc128( 0,         0        ),
+    tc128(-0.0,      -0.0     ),
+    tc128( inf_f128,  inf_f128 ),
+    tc128(-inf_f128, -1        ),
+    tc128( nan_f128,  nan_f128 ),
+    tc128(-nan_f128,  nan_f128 ),
+
+    // Sanity cases
+    tc128(-0x1.02239f3c6a8f13dep+3,  -0x1.ffd6df9b02b3db9a734601588225p-1 ),
+    tc128( 0x1.161868e18bc67782p+2,   0x1.30712ed238c064a14a59ddb90119p+6 ),
+    tc128(-0x1.0c34b3e01e6e682cp+3,  -0x1.ffe1f94e493e719467ad9890ed6bp-1 ),
+    tc128(-0x1.a206f0a19dcc3948p+2,  -0x1.ff4115c03f78cb881aac57da363cp-1 ),
+    tc128( 0x1.288bbb0d6a1e5bdap+3,   0x1.4ab477496e07b24ad548e9379bcap+13 ),
+    tc128( 0x1.52efd0cd80496a5ap-1,   0x1.e095382100a004ef70894a323948p-1 ),
+    tc128(-0x1.a05cc754481d0bd0p-2,  -0x1.561c3e0582be59d11cffaeda562ep-2 ),
+    tc128( 0x1.1f9ef934745cad60p-1,   0x1.81ec4cd4d4a8e7eda2dc0281b30dp-1 ),
+    tc128( 0x1.8c5db097f744257ep-1,   0x1.2b3363a944bf6f8b0f46173d4b2fp+0 ),
+    tc128(-0x1.5b86ea8118a0e2bcp-1,  -0x1.f8951aebffbaf1e5d2ac77bd195ap-2 ),
+
+    // Boundary cases
+    tc128( 0x1p-115,                                0x1p-115 ), // Tiny input values
+    tc128(-0x1p-115,                               -0x1p-115 ),
+    tc128(-0x1.4p+6,                               -1        ), // e^x below half an ulp of 1
+    tc128( 0x1.62e42fefa39ef35793c7673007e6p+13,    inf_f128 ), // The first value that gives infinite expm1
+
+    // zig fmt: on
+};
+
+test "expm1_128()" {
+    try test_util.runTests(testcases128);
+}
@@ -0,0 +1,120 @@
+//! Checks the AVX2 and AVX-512 kernels of src/simd.zig in the objects that
+//! build.zig links into this program against their error bounds. The objects
+//! are built with fused multiply-add, so unlike the kernels compiled for the
+//! program's own target they aren't bit identical to the scalar functions.
+//! This is a program rather than a test since f128math_simd_objects has to
+//! be declared in the root source file. Flavours the CPU can't run are
+//! skipped.
+//!
+//! Run with 'zig build test'.
+
+const std = @import("std");
+const math = @import("f128math");
+
+pub const f128math_simd_objects = true;
+
+const Flavour = math.simd.Flavour;
+
+const n_inputs = 4099;
+
+/// The maximum errors in ulps of each flavour's kernels.
+const Bounds = struct {
+    exp: f128,
+    exp2: f128,
+    log2: f128,
+};
+
+// The scalar kernels on four lanes, with the polynomials fused, as in the
+// table of src/muladd.zig.
+const avx2_bounds = Bounds{ .exp = 1, .exp2 = 0.51, .log2 = 0.7 };
+// The kernels of src/avx512.zig.
+const avx512_bounds = Bounds{ .exp = 0.55, .exp2 = 0.56, .log2 = 0.53 };
+
+/// Returns the error of y in ulps, relative to the more precise ref.
+fn ulpError(y: f64, ref: f128) f128 {
+    const fr = math.frexp(@floatCast(f64, ref));
+    const ulp = math.scalbn(@as(f128, 1), fr.exponent - 53);
+    return math.fabs(@as(f128, y) - ref) / ulp;
+}
+
+fn checkFunc(
+    flavour: Flavour,
+    name: []const u8,
+    kernel: math.simd.SliceFn,
+    comptime ref: fn (f128) f128,
+    bound: f128,
+    xs: []const f64,
+    out: []f64,
+) !void {
+    kernel(xs, out);
+    for (xs) |x, i| {
+        const err = ulpError(out[i], ref(x));
+        if (!(err <= bound)) {
+            std.debug.print("{s} {s}({e}) = {e}: {d} ulp, bound {d}\n", .{
+                @tagName(flavour),
+                name,
+                x,
+                out[i],
+                @floatCast(f64, err),
+                @floatCast(f64, bound),
+            });
+            return error.TestFailed;
+        }
+    }
+}
+
+fn exp128(x: f128) f128 {
+    return math.exp(x);
+}
+
+fn exp2_128(x: f128) f128 {
+    return math.exp2(x);
+}
+
+fn log2_128(x: f128) f128 {
+    return math.log2(x);
+}
+
+fn checkFlavour(flavour: Flavour, bounds: Bounds) !void {
+    var prng = std.rand.DefaultPrng.init(0x94D049BB133111EB);
+    const random = prng.random();
+    var exp_inputs: [n_inputs]f64 = undefined;
+    var exp2_inputs: [n_inputs]f64 = undefined;
+    var log2_inputs: [n_inputs]f64 = undefined;
+    var out: [n_inputs]f64 = undefined;
+    for (exp_inputs) |*x, i| {
+        x.* = random.float(f64) * 1400 - 700;
+        exp2_inputs[i] = random.float(f64) * 2040 - 1020;
+        log2_inputs[i] = math.scalbn(random.float(f64) + 0.5, random.intRangeAtMost(i32, -1000, 1000));
+    }
+    // near 0 and near 1, where the results of exp2 and log2 are small
+    exp2_inputs[0] = 0x1p-30;
+    log2_inputs[0] = 1 + 0x1p-20;
+
+    const kernels = math.simd.kernelsFor(flavour);
+    try checkFunc(flavour, "exp", kernels.exp, exp128, bounds.exp, &exp_inputs, &out);
+    try checkFunc(flavour, "exp2", kernels.exp2, exp2_128, bounds.exp2, &exp2_inputs, &out);
+    try checkFunc(flavour, "log2", kernels.log2, log2_128, bounds.log2, &log2_inputs, &out);
+
+    // Special lanes, which send their vector to the objects' scalar functions.
+    const specials = [_]f64{ 0, -0.0, math.inf(f64), -math.inf(f64), 1, 2, 1e300, -1e300 };
+    kernels.exp(&specials, out[0..specials.len]);
+    if (out[0] != 1 or out[2] != math.inf(f64) or out[3] != 0 or out[6] != math.inf(f64)) {
+        return error.TestFailed;
+    }
+    kernels.log2(&specials, out[0..specials.len]);
+    if (out[0] != -math.inf(f64) or out[4] != 0 or out[5] != 1 or !math.isNan(out[7])) {
+        return error.TestFailed;
+    }
+    std.debug.print("simd objects: {s} within bounds\n", .{@tagName(flavour)});
+}
+
+pub fn main() !void {
+    const widest = math.simd.detect();
+    if (@enumToInt(widest) >= @enumToInt(Flavour.avx2)) {
+        try checkFlavour(.avx2, avx2_bounds);
+    }
+    if (widest == .avx512) {
+        try checkFlavour(.avx512, avx512_bounds);
+    }
+}
@@ -18,6 +18,9 @@ pub fn Testcase(
 
         const bits = std.meta.bitCount(F);
         const U: type = std.meta.Int(.unsigned, bits);
+        // f80, with its explicit integer bit, is printed as f128 (which is
+        // exact) rather than relying on std.fmt to format it.
+        const P: type = if (F == f80) f128 else F;
 
         pub fn run(tc: @This()) !void {
             const hex_bits_fmt_size = comptime std.fmt.comptimePrint("{d}", .{bits / 4});
@@ -25,7 +28,7 @@ pub fn Testcase(
                 16 => "10",
                 32 => "16",
                 64 => "24",
-                128 => "40",
+                80, 128 => "40",
                 else => unreachable,
             };
             const input_bits = @bitCast(U, tc.input);
@@ -33,7 +36,7 @@ pub fn Testcase(
                 print(
                     " IN:  0x{X:0>" ++ hex_bits_fmt_size ++ "}  " ++
                         "{[1]x:<" ++ hex_float_fmt_size ++ "}  {[1]e}\n",
-                    .{ input_bits, tc.input },
+                    .{ input_bits, @as(P, tc.input) },
                 );
             }
             const output = func(tc.input);
@@ -42,7 +45,7 @@ pub fn Testcase(
                 print(
                     "OUT:  0x{X:0>" ++ hex_bits_fmt_size ++ "}  " ++
                         "{[1]x:<" ++ hex_float_fmt_size ++ "}  {[1]e}\n",
-                    .{ output_bits, output },
+                    .{ output_bits, @as(P, output) },
                 );
             }
             const exp_output_bits = @bitCast(U, tc.exp_output);
@@ -52,12 +55,12 @@ pub fn Testcase(
                     print(
                         "EXP:  0x{X:0>" ++ hex_bits_fmt_size ++ "}  " ++
                             "{[1]x:<" ++ hex_float_fmt_size ++ "}  {[1]e}\n",
-                        .{ exp_output_bits, tc.exp_output },
+                        .{ exp_output_bits, @as(P, tc.exp_output) },
                     );
                 }
                 print(
                     "FAILURE: expected {s}({x})->{x}, got {x} ({d}-bit)\n",
-                    .{ name, tc.input, tc.exp_output, output, bits },
+                    .{ name, @as(P, tc.input), @as(P, tc.exp_output), @as(P, output), bits },
                 );
                 return error.TestExpectedEqual;
             }